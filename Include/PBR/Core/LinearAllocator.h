@@ -0,0 +1,131 @@
+#pragma once
+
+#include <new>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+#include <assert.h>
+
+#include "BaseTypes.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// LinearAllocator /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Bump allocator working on a list of pages. Memory is never freed individually,
+	// Reset() rewinds all pages so they can be reused without touching the heap again.
+	class LinearAllocator
+	{
+
+	public:
+
+		static constexpr uint32 DefaultPageSize = 64 * 1024;
+
+	private:
+
+		struct Page
+		{
+
+			byte* Memory;
+			uint32 Size;
+
+		};
+
+	public:
+
+		LinearAllocator(const uint32 pageSize = DefaultPageSize)
+			: PageSize(pageSize)
+			, Pages()
+			, CurrentPage(0)
+			, CurrentOffset(0)
+			, AllocatedBytes(0)
+		{
+		}
+
+		~LinearAllocator()
+		{
+			for (Page& page : Pages)
+				std::free(page.Memory);
+		}
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		void* Allocate(const uint32 size, const uint32 alignment)
+		{
+			assert(alignment && !(alignment & (alignment - 1)));
+
+			while (CurrentPage < Pages.size())
+			{
+				const Page& page = Pages[CurrentPage];
+
+				const uintptr_t base = reinterpret_cast<uintptr_t>(page.Memory);
+				const uintptr_t aligned = (base + CurrentOffset + alignment - 1) & ~uintptr_t(alignment - 1);
+				const uintptr_t end = aligned - base + size;
+
+				if (end <= page.Size)
+				{
+					CurrentOffset = static_cast<uint32>(end);
+					AllocatedBytes += size;
+
+					return reinterpret_cast<void*>(aligned);
+				}
+
+				++CurrentPage;
+				CurrentOffset = 0;
+			}
+
+			Page page;
+			page.Size = std::max(PageSize, size + alignment);
+			page.Memory = static_cast<byte*>(std::malloc(page.Size));
+
+			Pages.push_back(page);
+			CurrentPage = static_cast<uint32>(Pages.size() - 1);
+			CurrentOffset = 0;
+
+			return Allocate(size, alignment);
+		}
+
+		template<typename T, typename... TArgs>
+		T* New(TArgs&&... args)
+		{
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+		}
+
+		void Reset()
+		{
+			CurrentPage = 0;
+			CurrentOffset = 0;
+			AllocatedBytes = 0;
+		}
+
+		inline uint64 GetAllocatedBytes() const { return AllocatedBytes; }
+
+		inline uint64 GetReservedBytes() const
+		{
+			uint64 result = 0;
+			for (const Page& page : Pages)
+				result += page.Size;
+
+			return result;
+		}
+
+	private:
+
+		uint32 PageSize;
+		std::vector<Page> Pages;
+
+		uint32 CurrentPage;
+		uint32 CurrentOffset;
+
+		uint64 AllocatedBytes;
+
+	};
+
+}
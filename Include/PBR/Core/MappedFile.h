@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+#include "BaseTypes.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// MappedFile //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Maps a whole file read-only into the address space. Pages are read from disk when first touched,
+	// nothing is copied into the process until then. The data stays valid until the file is closed.
+	class MappedFile
+	{
+
+	public:
+
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Returns false if the file cannot be opened or is empty.
+		bool Open(const std::string& file);
+		void Close();
+
+		inline bool IsOpen() const { return Data != nullptr; }
+
+		inline const byte* GetData() const { return Data; }
+		inline uint64 GetSize() const { return Size; }
+
+	private:
+
+		const byte* Data;
+		uint64 Size;
+
+		// Platform handles, unused ones stay null.
+		void* FileHandle;
+		void* MappingHandle;
+
+	};
+
+}
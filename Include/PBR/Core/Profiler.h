@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "BaseTypes.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ProfileEvent ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct ProfileEvent
+	{
+
+		const char* Name;
+
+		// Nanoseconds since the profiler was first used.
+		uint64 Begin;
+		uint64 End;
+
+		uint32 Depth;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Profiler ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Hierarchical CPU profiler. Every thread records into its own fixed size buffer, only the first
+	// event of a thread takes a lock to register the buffer. Events are published with a release store
+	// of the event count, so they can be exported while other threads keep recording.
+	//
+	// Event names are not copied, they have to be string literals or outlive the export.
+	class Profiler
+	{
+
+	public:
+
+		static constexpr uint32 MaxEventsPerThread = 1 << 16;
+		static constexpr uint32 MaxDepth = 64;
+
+	private:
+
+		struct ThreadBuffer;
+
+	public:
+
+		static void SetEnabled(const bool value);
+		static inline bool IsEnabled() { return bIsEnabled.load(std::memory_order_relaxed); }
+
+		// Shown as the thread name in the trace, copied.
+		static void SetThreadName(const char* name);
+
+		static void BeginEvent(const char* name);
+		static void EndEvent();
+
+		// Drops all recorded events. No thread may be inside a profiled scope.
+		static void Clear();
+
+		// Chrome trace event format, can be loaded in chrome://tracing or Perfetto.
+		static void WriteChromeTrace(std::ostream& stream);
+		static bool ExportChromeTrace(const std::string& path);
+
+		// Events that did not fit into the buffer of their thread.
+		static uint64 GetDroppedEventCount();
+
+	private:
+
+		static ThreadBuffer& GetThreadBuffer();
+		static uint64 GetTime();
+
+	private:
+
+		static std::atomic<bool> bIsEnabled;
+
+		static std::mutex Mutex;
+		static std::vector<ThreadBuffer*> Buffers;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ProfileScope ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A disabled profiler only costs a relaxed load. Scopes opened while enabled are always closed.
+	class ProfileScope
+	{
+
+	public:
+
+		ProfileScope(const char* name)
+			: bIsActive(Profiler::IsEnabled())
+		{
+			if (bIsActive)
+				Profiler::BeginEvent(name);
+		}
+
+		~ProfileScope()
+		{
+			if (bIsActive)
+				Profiler::EndEvent();
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+
+		const bool bIsActive;
+
+	};
+
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef PBR_PROFILER_DISABLED
+#define PROFILE_SCOPE(name) ::EngineCore::ProfileScope PROFILE_CONCAT(ProfileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
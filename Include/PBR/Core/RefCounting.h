@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <assert.h>
 #include "BaseTypes.h"
 
@@ -36,6 +37,17 @@ namespace EngineCore
 		{
 		}
 
+		// Copies start without references, the count belongs to the original object.
+		RefCountedObject(const RefCountedObject&)
+			: NumRefs(0)
+		{
+		}
+
+		RefCountedObject& operator=(const RefCountedObject&)
+		{
+			return *this;
+		}
+
 		virtual ~RefCountedObject()
 		{
 			assert(!NumRefs);
@@ -55,11 +67,12 @@ namespace EngineCore
 			return refs;
 		}
 
-		uint32 GetRefCount() const { return uint32(NumRefs); }
+		uint32 GetRefCount() const { return uint32(NumRefs.load()); }
 
 	private:
 
-		mutable int32 NumRefs;
+		// Refs are shared between the game and the render thread.
+		mutable std::atomic<int32> NumRefs;
 
 	};
 
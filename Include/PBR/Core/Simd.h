@@ -0,0 +1,11 @@
+#pragma once
+
+
+// SSE2 is part of every x64 target. CPU loops the compiler does not vectorize on its own, like
+// gathers and deinterleaving, have an SSE2 path and a scalar one for all other targets.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_SSE2 0
+#endif
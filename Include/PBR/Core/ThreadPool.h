@@ -0,0 +1,83 @@
+#pragma once
+
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "BaseTypes.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ThreadPriority //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	enum class ThreadPriority : uint8
+	{
+
+		Normal	= 0,
+
+		// Background work like texture decodes, the OS prefers the threads recording frames.
+		Low		= 1
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ThreadPool //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class ThreadPool
+	{
+
+	public:
+
+		using Task = std::function<void()>;
+
+		// Called with [begin, end) and the index of the chunk the range belongs to.
+		using RangeTask = std::function<void(const uint32 begin, const uint32 end, const uint32 chunk)>;
+
+	public:
+
+		// A thread count of 0 uses one worker per hardware thread except the calling one.
+		ThreadPool(const uint32 threadCount = 0, const ThreadPriority priority = ThreadPriority::Normal);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void Enqueue(Task task);
+
+		// Splits [0, count) into at most GetMaxChunkCount() contiguous chunks of at least minChunkSize
+		// elements and blocks until all of them are processed. The calling thread works on chunks too,
+		// it returns as soon as the last chunk is done, even if helpers queued behind other tasks have
+		// not started yet. Returns the number of chunks, chunk boundaries only depend on count and
+		// minChunkSize.
+		uint32 ParallelFor(const uint32 count, const uint32 minChunkSize, const RangeTask& task);
+
+		inline uint32 GetThreadCount() const { return static_cast<uint32>(Workers.size()); }
+		inline uint32 GetMaxChunkCount() const { return GetThreadCount() + 1; }
+
+	private:
+
+		void Run();
+
+	private:
+
+		std::vector<std::thread> Workers;
+		ThreadPriority Priority;
+
+		std::mutex Mutex;
+		std::condition_variable TaskAvailable;
+
+		std::queue<Task> Tasks;
+
+		bool bStopRequested;
+
+	};
+
+}
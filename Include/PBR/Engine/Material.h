@@ -74,19 +74,25 @@ namespace EngineCore
 		inline const Texture2DRef& GetNormalMap() const { return NormalMap; }
 		inline const Texture2DRef& GetDisplacementMap() const { return DisplacementMap; }
 
+		// Bumped by every setter, lets cached copies of the shader parameters detect changes.
+		inline uint32 GetRevision() const { return Revision; }
 
-		inline void SetAlbedo(const glm::vec3& albedo) { Albedo = albedo; UseAlbedoMap = false; }
-		inline void SetMetalness(const float metalness) { Metalness = metalness; UseMetalnessMap = false; }
-		inline void SetRoughness(const float roughness) { Roughness = roughness; UseRoughnessMap = false; }
-		inline void SetAmbientOcclusion(const float occlusion) { AmbientOcclusion = occlusion; UseAmbientOcclusionMap = false; }
-		inline void SetDisplacementHeightScale(const float scale) { DisplacementHeightScale = scale; }
+		// For changes not made through a setter, e.g. texture handles replaced by mip streaming.
+		inline void Invalidate() { ++Revision; }
 
-		inline void SetAlbedoMap(const Texture2DRef& texture) { AlbedoMap = texture; UseAlbedoMap = true; }
-		inline void SetMetalnessMap(const Texture2DRef& texture) { MetalnessMap = texture; UseMetalnessMap = true; }
-		inline void SetRoughnessMap(const Texture2DRef& texture) { RoughnessMap = texture; UseRoughnessMap = true; }
-		inline void SetAmbientOcclusionMap(const Texture2DRef& texture) { AmbientOcclusionMap = texture;  UseAmbientOcclusionMap = true; }
-		inline void SetNormalMap(const Texture2DRef& texture) { NormalMap = texture; UseNormalMap = true; }
-		inline void SetDisplacementMap(const Texture2DRef& texture) { DisplacementMap = texture; UseDisplacementMap = true; }
+
+		inline void SetAlbedo(const glm::vec3& albedo) { Albedo = albedo; UseAlbedoMap = false; ++Revision; }
+		inline void SetMetalness(const float metalness) { Metalness = metalness; UseMetalnessMap = false; ++Revision; }
+		inline void SetRoughness(const float roughness) { Roughness = roughness; UseRoughnessMap = false; ++Revision; }
+		inline void SetAmbientOcclusion(const float occlusion) { AmbientOcclusion = occlusion; UseAmbientOcclusionMap = false; ++Revision; }
+		inline void SetDisplacementHeightScale(const float scale) { DisplacementHeightScale = scale; ++Revision; }
+
+		inline void SetAlbedoMap(const Texture2DRef& texture) { AlbedoMap = texture; UseAlbedoMap = true; ++Revision; }
+		inline void SetMetalnessMap(const Texture2DRef& texture) { MetalnessMap = texture; UseMetalnessMap = true; ++Revision; }
+		inline void SetRoughnessMap(const Texture2DRef& texture) { RoughnessMap = texture; UseRoughnessMap = true; ++Revision; }
+		inline void SetAmbientOcclusionMap(const Texture2DRef& texture) { AmbientOcclusionMap = texture; UseAmbientOcclusionMap = true; ++Revision; }
+		inline void SetNormalMap(const Texture2DRef& texture) { NormalMap = texture; UseNormalMap = true; ++Revision; }
+		inline void SetDisplacementMap(const Texture2DRef& texture) { DisplacementMap = texture; UseDisplacementMap = true; ++Revision; }
 
 	private:
 
@@ -110,6 +116,8 @@ namespace EngineCore
 		Texture2DRef NormalMap;
 		Texture2DRef DisplacementMap;
 
+		uint32 Revision;
+
 	};
 
 	using MaterialRef = Ref<Material>;
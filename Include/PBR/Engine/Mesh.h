@@ -4,6 +4,7 @@
 
 #include "PBR/Core/RefCounting.h"
 #include "PBR/RHI/VertexArray.h"
+#include "PBR/RenderCore/GeometryPool.h"
 
 
 namespace EngineCore
@@ -25,6 +26,30 @@ namespace EngineCore
 
 	};
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PackedVertex ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// GPU format of mesh vertices, 24 instead of 56 bytes. The normal, tangent and binormal are
+	// stored as a quaternion that rotates the x, y and z axis onto them, a negative w marks a
+	// mirrored binormal. Decoded by the vertex shader, see CommonPass.glsl.
+	struct PackedVertex
+	{
+
+		glm::fvec3 Position;
+
+		// Half floats.
+		uint32 UvCoord;
+
+		// Normalized shorts, x y z w.
+		uint64 TangentFrame;
+
+	};
+
+	static_assert(sizeof(PackedVertex) == 24, "PackedVertex has to be tightly packed!");
+
+	PackedVertex PackVertex(const Vertex& vertex);
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// MeshData ////////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,13 +87,25 @@ namespace EngineCore
 
 		Mesh();
 		Mesh(const VertexArrayRef& vertexArray);
+		Mesh(const GeometryBufferRef& geometry, const GeometryHandle allocation);
 		~Mesh();
 
 
-		inline void SetVertexArray(const VertexArrayRef& vertexArray) { VertexArrayObject = vertexArray; IndexBufferObject = vertexArray->GetIndexBuffer(); }
+		void SetVertexArray(const VertexArrayRef& vertexArray);
+
+		// Suballocated meshes return the vertex array shared by all meshes of their geometry buffer.
+		inline const VertexArrayRef& GetVertexArray() const { return Geometry ? Geometry->GetVertexArray() : VertexArrayObject; }
+		inline const IndexBufferRef& GetIndexBuffer() const { return Geometry ? Geometry->GetVertexArray()->GetIndexBuffer() : IndexBufferObject; }
 
-		inline const VertexArrayRef& GetVertexArray() const { return VertexArrayObject; }
-		inline const IndexBufferRef& GetIndexBuffer() const { return IndexBufferObject; }
+		// Range of the index buffer to draw, see RHICommandList::DrawIndexedRange().
+		uint32 GetIndexCount() const;
+		uint32 GetFirstIndex() const;
+		int32 GetBaseVertex() const;
+
+		inline bool IsSuballocated() const { return Geometry.GetReference() != nullptr; }
+
+		// Of a sphere around the origin of the mesh containing all vertices, 0 if unknown.
+		inline float GetBoundingRadius() const { return BoundingRadius; }
 
 	private:
 
@@ -77,13 +114,28 @@ namespace EngineCore
 
 	public:
 
-		static Ref<Mesh> Create(const MeshData& data);
+		// Meshes that get edited after creation should use BufferUsage::Dynamic, so their vertex
+		// buffer can be updated in place through VertexBuffer::SetData. The buffer contains
+		// PackedVertex, see PackVertex(). Static meshes are suballocated from the geometry pool
+		// if a renderer exists, dynamic ones get their own buffers.
+		static Ref<Mesh> Create(const MeshData& data, const BufferUsage usage = BufferUsage::Static);
+
+		static const BufferLayout& GetVertexLayout();
+
+	private:
+
+		static Ref<Mesh> CreateMesh(const MeshData& data, const BufferUsage usage);
 
 	private:
 
 		VertexArrayRef VertexArrayObject;
 		IndexBufferRef IndexBufferObject;
 
+		GeometryBufferRef Geometry;
+		GeometryHandle Allocation;
+
+		float BoundingRadius;
+
 	private:
 
 		friend class Renderer;
@@ -31,7 +31,13 @@ namespace EngineCore
 		Float4 = 9,
 
 		Mat3 = 10,
-		Mat4 = 11
+		Mat4 = 11,
+
+		// 16 bit types, read as floats in the shader. Shorts are usually normalized.
+		Half2 = 12,
+		Half4 = 13,
+		Short2 = 14,
+		Short4 = 15
 
 	};
 
@@ -53,6 +59,11 @@ namespace EngineCore
 		case ShaderDataType::Mat4:		return 4 * 4 * 4;
 		case ShaderDataType::Bool:		return 1;
 
+		case ShaderDataType::Half2:		return 2 * 2;
+		case ShaderDataType::Half4:		return 2 * 4;
+		case ShaderDataType::Short2:	return 2 * 2;
+		case ShaderDataType::Short4:	return 2 * 4;
+
 		default: break;
 		}
 
@@ -134,6 +145,11 @@ namespace EngineCore
 
 			case ShaderDataType::Bool:		return 1;
 
+			case ShaderDataType::Half2:		return 2;
+			case ShaderDataType::Half4:		return 4;
+			case ShaderDataType::Short2:	return 2;
+			case ShaderDataType::Short4:	return 4;
+
 			default: break;
 			}
 
@@ -219,6 +235,23 @@ namespace EngineCore
 
 	};
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// IndexType ///////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	enum class IndexType : uint32
+	{
+
+		UInt16 = 0,
+		UInt32 = 1
+
+	};
+
+	static uint32 GetIndexTypeSize(const IndexType type)
+	{
+		return type == IndexType::UInt16 ? 2 : 4;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// VertexBuffer ////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -231,11 +264,18 @@ namespace EngineCore
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
+		// How the range is written depends on the usage the buffer was created with:
+		//  Static  - in place, the driver may have to wait until pending draws are done.
+		//  Dynamic - a write covering the whole buffer orphans it, smaller ranges are written in place.
+		//  Stream  - a write at offset 0 orphans the buffer, writes at higher offsets are mapped
+		//            unsynchronized. Stream data has to be appended behind what was already drawn.
 		virtual void SetData(const void* data, const uint32 offset, const uint32 size) = 0;
 
 		virtual void SetLayout(const BufferLayout& layout) = 0;
 		virtual const BufferLayout& GetLayout() const = 0;
 
+		virtual uint32 GetSize() const = 0;
+
 
 		static Ref<VertexBuffer> Create(const void* data, const uint32 size, const BufferUsage usage = BufferUsage::Static);
 		static Ref<VertexBuffer> CreateMapped(const uint32 size, const BufferUsage usage = BufferUsage::Dynamic);
@@ -258,9 +298,23 @@ namespace EngineCore
 
 		virtual uint32 GetCount() const = 0;
 
+		// All draws using the buffer read indices of this type.
+		virtual IndexType GetIndexType() const = 0;
+
+		// Offset and count are given in indices. Follows the update rules of VertexBuffer::SetData.
+		virtual void SetData(const void* data, const uint32 offset, const uint32 count) = 0;
 
+
+		static Ref<IndexBuffer> Create(const uint16* data, const uint32 count, const BufferUsage usage = BufferUsage::Static);
 		static Ref<IndexBuffer> Create(const uint32* data, const uint32 count, const BufferUsage usage = BufferUsage::Static);
 
+		// Picks 16 bit indices if every index fits, halving the memory read per vertex fetch.
+		static Ref<IndexBuffer> CreateCompact(const std::vector<uint32>& indices, const uint32 vertexCount, const BufferUsage usage = BufferUsage::Static);
+
+	private:
+
+		static Ref<IndexBuffer> Create(const void* data, const uint32 count, const IndexType type, const BufferUsage usage);
+
 	};
 
 	using IndexBufferRef = Ref<IndexBuffer>;
@@ -282,14 +336,112 @@ namespace EngineCore
 
 		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) = 0;
 
+		// Only buffers created with CreateMapped() are mapped, all others return nullptr. Writes through the
+		// pointer are visible to the GPU without further calls, the caller has to fence reused ranges.
+		virtual void* GetMappedMemory() const = 0;
+
 		virtual uint32 GetSize() const = 0;
 
 
 		static Ref<UniformBuffer> Create(const uint32 size, const BufferUsage usage = BufferUsage::Static);
 		static Ref<UniformBuffer> Create(const void* data, const uint32 size, const BufferUsage usage = BufferUsage::Static);
+		static Ref<UniformBuffer> CreateMapped(const uint32 size);
 
 	};
 
 	using UniformBufferRef = Ref<UniformBuffer>;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// StorageBuffer ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct StorageBuffer : public RefCountedObject
+	{
+
+		virtual ~StorageBuffer() { }
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		virtual void BindBlock(const uint32 blockIndex) const = 0;
+
+		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) = 0;
+
+		virtual uint32 GetSize() const = 0;
+
+
+		static Ref<StorageBuffer> Create(const uint32 size, const BufferUsage usage = BufferUsage::Dynamic);
+
+	};
+
+	using StorageBufferRef = Ref<StorageBuffer>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DrawIndexedIndirectCommand //////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Layout is fixed by the API, see glMultiDrawElementsIndirect / DrawIndexedInstancedIndirect.
+	struct DrawIndexedIndirectCommand
+	{
+
+		uint32 Count;
+		uint32 InstanceCount;
+		uint32 FirstIndex;
+		int32 BaseVertex;
+		uint32 BaseInstance;
+
+	};
+
+	static_assert(sizeof(DrawIndexedIndirectCommand) == 20, "Wrong indirect command size: DrawIndexedIndirectCommand!");
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// IndirectBuffer //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct IndirectBuffer : public RefCountedObject
+	{
+
+		virtual ~IndirectBuffer() { }
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		// Offset and count are given in commands, not bytes.
+		virtual void SetData(const DrawIndexedIndirectCommand* commands, const uint32 count, const uint32 offset = 0) = 0;
+
+		virtual uint32 GetCapacity() const = 0;
+
+
+		static Ref<IndirectBuffer> Create(const uint32 capacity, const BufferUsage usage = BufferUsage::Dynamic);
+
+	};
+
+	using IndirectBufferRef = Ref<IndirectBuffer>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PixelBuffer /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Staging memory for texture uploads, see Texture2D::SetMipData(). The buffer stays persistently
+	// mapped, writes through the pointer are visible to the GPU without further calls. The copy into
+	// the texture runs later on the GPU, the caller has to fence reused ranges.
+	struct PixelBuffer : public RefCountedObject
+	{
+
+		virtual ~PixelBuffer() { }
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		virtual void* GetMappedMemory() const = 0;
+
+		virtual uint32 GetSize() const = 0;
+
+
+		static Ref<PixelBuffer> CreateMapped(const uint32 size);
+
+	};
+
+	using PixelBufferRef = Ref<PixelBuffer>;
+
 }
\ No newline at end of file
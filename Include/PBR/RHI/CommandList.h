@@ -4,15 +4,122 @@
 
 #include "PBR/Core/BaseTypes.h"
 #include "PBR/Core/RefCounting.h"
+#include "PBR/Core/LinearAllocator.h"
 
 #include "Context.h"
+#include "Buffer.h"
+#include "Shader.h"
 #include "VertexArray.h"
+#include "PipelineState.h"
 
 
 
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RHICommandBase //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct RHICommandBase
+	{
+
+		RHICommandBase()
+			: Next(nullptr)
+		{
+		}
+
+		virtual ~RHICommandBase() { }
+
+		virtual void Execute(RHIContext& context) = 0;
+
+
+		RHICommandBase* Next;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RHICommandList //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Records commands into a linear arena without touching the RHIContext.
+	// The list is replayed (and reset) by RHICommandListExecutor::ExecuteList.
+	class RHICommandList
+	{
+
+	public:
+
+		RHICommandList();
+		~RHICommandList();
+
+		RHICommandList(const RHICommandList&) = delete;
+		RHICommandList& operator=(const RHICommandList&) = delete;
+
+		void Clear(const ClearFlags flags = ClearFlags::ColorBuffer | ClearFlags::DepthBuffer);
+		void SetClearColor(const glm::vec4& color);
+
+		void SetDepthFunc(const DepthFunc func);
+		void DepthMask(const bool value);
+		void SetCullMode(const CullMode mode);
+		void SetBlendFunc(const BlendFunc func);
+
+		void SetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height);
+
+		void SetShader(const ShaderRef& shader);
+		void SetPipelineState(const PipelineStateRef& pipelineState);
+
+		void SetUniformBufferData(const UniformBufferRef& uniformBuffer, const void* data, const uint32 size, const uint32 offset = 0);
+		void BindUniformBlock(const UniformBufferRef& uniformBuffer, const uint32 blockIndex);
+		void BindUniformBlockRange(const UniformBufferRef& uniformBuffer, const uint32 blockIndex, const uint32 offset, const uint32 size);
+
+		void BeginRenderPass(const char* name);
+		void EndRenderPass();
+
+		void Draw(const VertexArrayRef& vertexArray);
+		void DrawIndexed(const VertexArrayRef& vertexArray);
+		void DrawIndexedInstanced(const VertexArrayRef& vertexArray, const uint32 instanceCount);
+		void DrawIndexedRange(const VertexArrayRef& vertexArray, const uint32 indexCount, const uint32 firstIndex, const int32 baseVertex);
+
+		void DrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset);
+		void MultiDrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount);
+
+		// Runs the compute shader set last.
+		void Dispatch(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ = 1);
+
+		void Execute(RHIContext& context);
+		void Reset();
+
+		inline bool IsEmpty() const { return Head == nullptr; }
+		inline uint32 GetCommandCount() const { return CommandCount; }
+		inline uint64 GetRecordedBytes() const { return Allocator.GetAllocatedBytes(); }
+
+	private:
+
+		template<typename T, typename... TArgs>
+		void Record(TArgs&&... args)
+		{
+			T* command = Allocator.New<T>(std::forward<TArgs>(args)...);
+
+			if (Tail)
+				Tail->Next = command;
+			else
+				Head = command;
+
+			Tail = command;
+			++CommandCount;
+		}
+
+	private:
+
+		LinearAllocator Allocator;
+
+		RHICommandBase* Head;
+		RHICommandBase* Tail;
+
+		uint32 CommandCount;
+
+	};
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RHIImmediateCommandList /////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -32,12 +139,25 @@ namespace EngineCore
 		void DepthMask(const bool value);
 		void SetCullMode(const CullMode mode);
 
-		void BeginRenderPass();
+		void SetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height);
+
+		void SetShader(const ShaderRef& shader);
+		void SetPipelineState(const PipelineStateRef& pipelineState);
+
+		void BeginRenderPass(const char* name);
 		void EndRenderPass();
 
 		void Draw(const VertexArrayRef& vertexArray);
 		void DrawIndexed(const VertexArrayRef& vertexArray);
 		void DrawIndexedInstanced(const VertexArrayRef& vertexArray, const uint32 instanceCount);
+		void DrawIndexedRange(const VertexArrayRef& vertexArray, const uint32 indexCount, const uint32 firstIndex, const int32 baseVertex);
+
+		void DrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset);
+		void MultiDrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount);
+
+		void Dispatch(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ = 1);
+
+		void Submit(RHICommandList& commandList);
 
 	private:
 
@@ -56,6 +176,8 @@ namespace EngineCore
 
 		static RHICommandListImmediate& GetImmediateCommandList() { return CommandListImmediate; }
 
+		static void ExecuteList(RHICommandList& commandList);
+
 	private:
 
 		static RHICommandListImmediate CommandListImmediate;
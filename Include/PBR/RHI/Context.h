@@ -15,6 +15,12 @@
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Forward Declarations ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct PipelineState;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RenderApi ///////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,14 +97,25 @@ namespace EngineCore
 	// BlendFunc ///////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// Each value selects one blend equation, src is the shaded color and dst the target.
 	enum class BlendFunc : uint8
 	{
 
 		None = 0,
+
+		// src, the source replaces the destination.
 		Zero = 1,
+
+		// src + dst, additive.
 		One = 2,
+
+		// src * src.a + dst * (1 - src.a), alpha blending.
 		SourceAlpha = 3,
+
+		// src * dst.a + dst * (1 - dst.a), the alpha of the target decides.
 		DestinationAlpha = 4,
+
+		// src + dst * (1 - src.a), alpha blending of premultiplied colors.
 		OneMinusSourceAlpha = 5
 
 	};
@@ -131,18 +148,31 @@ namespace EngineCore
 		virtual void RHISetVertexArray(const VertexArrayRef& vertexArray) = 0;
 
 		virtual void RHISetShader(const ShaderRef& shader) = 0;
+		virtual void RHISetPipelineState(const Ref<PipelineState>& pipelineState) = 0;
 		virtual void RHISetFrameBuffer(const FrameBufferRef& frameBuffer) = 0;
 
 		virtual void RHISetShaderParameter() = 0;
 		virtual void RHISetShaderUniformParameter() = 0;
 
-		virtual void RHIBeginRenderPass() = 0;
+		// Named passes show up as debug groups in frame debuggers.
+		virtual void RHIBeginRenderPass(const char* name) = 0;
 		virtual void RHIEndRenderPass() = 0;
 
 		virtual void RHIDrawPrimitive() = 0;
 		virtual void RHIDrawIndexedPrimitive() = 0;
 		virtual void RHIDrawIndexedInstancedPrimitive(const uint32 instances) = 0;
 
+		// Draws a range of the index buffer, baseVertex is added to every index before the vertex is fetched.
+		virtual void RHIDrawIndexedRangePrimitive(const uint32 count, const uint32 firstIndex, const int32 baseVertex) = 0;
+
+		// Offsets are given in commands. The vertex array set last provides the index buffer.
+		virtual void RHIDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset) = 0;
+		virtual void RHIMultiDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount) = 0;
+
+		// Runs the compute shader set last. Its writes are visible to image loads and texture fetches
+		// of all later commands.
+		virtual void RHIDispatchCompute(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ) = 0;
+
 		virtual RenderApi GetApi() const = 0;
 
 	public:
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/RefCounting.h"
+
+#include "GpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DeferredReleaseQueue ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Keeps GPU objects alive until every frame that may still read them has retired, e.g. textures
+	// whose bindless handles are still in material buffers of frames in flight. An object queued
+	// during a frame is released once the fence signaled at the end of that frame has passed, which
+	// is checked again FrameCount frames later like the regions of UniformRingBuffer.
+	// BeginFrame/EndFrame have to bracket all GPU work of a frame, render thread only.
+	class DeferredReleaseQueue
+	{
+
+	public:
+
+		static constexpr uint32 FrameCount = 3;
+
+	public:
+
+		DeferredReleaseQueue();
+		~DeferredReleaseQueue();
+
+		DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+		DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+
+		// Waits until the GPU passed the frame queued FrameCount frames ago and releases its objects.
+		void BeginFrame();
+		void EndFrame();
+
+		void Release(const Ref<RefCountedObject>& object);
+
+		inline uint32 GetPendingCount() const { return PendingCount; }
+
+	public:
+
+		// nullptr while no renderer exists, objects are released right away then.
+		static DeferredReleaseQueue* GetInstance() { return Instance; }
+
+	private:
+
+		static DeferredReleaseQueue* Instance;
+
+		GpuFenceRef Fences[FrameCount];
+		std::vector<Ref<RefCountedObject>> Objects[FrameCount];
+
+		uint32 FrameIndex;
+		uint32 PendingCount;
+
+	};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/RefCounting.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuFence ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Marks a point in the GPU command stream. The CPU can test or wait until the GPU has passed it,
+	// which tells when memory written for earlier commands may be reused.
+	struct GpuFence : public RefCountedObject
+	{
+
+		virtual ~GpuFence() { }
+
+		// Inserts the fence after all commands issued so far, a previous signal is dropped.
+		virtual void Signal() = 0;
+
+		// Blocks until the GPU has passed the fence. Returns immediately if it was never signaled.
+		virtual void Wait() = 0;
+
+		virtual bool IsSignaled() = 0;
+
+
+		static Ref<GpuFence> Create();
+
+	};
+
+	using GpuFenceRef = Ref<GpuFence>;
+
+}
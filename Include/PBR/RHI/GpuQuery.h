@@ -0,0 +1,77 @@
+#pragma once
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/RefCounting.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineStatistics //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct PipelineStatistics
+	{
+
+		uint64 VerticesSubmitted = 0;
+		uint64 PrimitivesSubmitted = 0;
+		uint64 VertexShaderInvocations = 0;
+		uint64 ClippingInputPrimitives = 0;
+		uint64 ClippingOutputPrimitives = 0;
+		uint64 FragmentShaderInvocations = 0;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuTimestampQuery ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Records the GPU time at which all previously issued commands have completed. Timestamps
+	// can be freely nested, the elapsed time of a range is the difference of two of them.
+	struct GpuTimestampQuery : public RefCountedObject
+	{
+
+		virtual ~GpuTimestampQuery() { }
+
+		// Issues the query again, a result that was not read yet is dropped.
+		virtual void Issue() = 0;
+
+		virtual bool IsResultAvailable() = 0;
+
+		// Nanoseconds, only valid once IsResultAvailable() returned true.
+		virtual uint64 GetResult() = 0;
+
+
+		static Ref<GpuTimestampQuery> Create();
+
+	};
+
+	using GpuTimestampQueryRef = Ref<GpuTimestampQuery>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuStatisticsQuery //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Counts the work of all commands between Begin() and End(). Only one statistics query
+	// can be active at a time.
+	struct GpuStatisticsQuery : public RefCountedObject
+	{
+
+		virtual ~GpuStatisticsQuery() { }
+
+		virtual void Begin() = 0;
+		virtual void End() = 0;
+
+		virtual bool IsResultAvailable() = 0;
+		virtual void GetResult(PipelineStatistics& statistics) = 0;
+
+
+		// Returns nullptr if the device does not support pipeline statistics.
+		static Ref<GpuStatisticsQuery> Create();
+
+	};
+
+	using GpuStatisticsQueryRef = Ref<GpuStatisticsQuery>;
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/RefCounting.h"
+
+#include "Context.h"
+#include "Shader.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RasterizerStateDesc /////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct RasterizerStateDesc
+	{
+
+		PrimitiveType Primitive = PrimitiveType::Triangles;
+		CullMode CullingMode = CullMode::Back;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DepthStencilStateDesc ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct DepthStencilStateDesc
+	{
+
+		DepthFunc DepthTest = DepthFunc::Less;
+		bool bDepthWrite = true;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BlendStateDesc //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct BlendStateDesc
+	{
+
+		BlendFunc BlendingFunc = BlendFunc::None;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineStateDesc ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct PipelineStateDesc
+	{
+
+		ShaderRef Shader;
+
+		RasterizerStateDesc Rasterizer;
+		DepthStencilStateDesc DepthStencil;
+		BlendStateDesc Blend;
+
+
+		uint64 GetHash() const;
+
+		bool operator==(const PipelineStateDesc& other) const;
+		bool operator!=(const PipelineStateDesc& other) const { return !(*this == other); }
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineState ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Immutable bundle of all state a draw depends on. Pipeline states are only created
+	// through the cache, so two equal descriptions always share the same object and
+	// a pointer compare is enough to detect redundant binds.
+	struct PipelineState : public RefCountedObject
+	{
+
+	public:
+
+		~PipelineState();
+
+		inline const PipelineStateDesc& GetDesc() const { return Desc; }
+		inline const ShaderRef& GetShader() const { return Desc.Shader; }
+
+		inline const RasterizerStateDesc& GetRasterizerState() const { return Desc.Rasterizer; }
+		inline const DepthStencilStateDesc& GetDepthStencilState() const { return Desc.DepthStencil; }
+		inline const BlendStateDesc& GetBlendState() const { return Desc.Blend; }
+
+		inline uint64 GetHash() const { return Hash; }
+
+
+		static Ref<PipelineState> Create(const PipelineStateDesc& desc);
+
+	private:
+
+		PipelineState(const PipelineStateDesc& desc, const uint64 hash);
+
+	private:
+
+		const PipelineStateDesc Desc;
+		const uint64 Hash;
+
+		friend class PipelineStateCache;
+
+	};
+
+	using PipelineStateRef = Ref<PipelineState>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineStateCache //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class PipelineStateCache
+	{
+
+	public:
+
+		static PipelineStateRef GetOrCreate(const PipelineStateDesc& desc);
+
+		// Drops the cache references, states still referenced by passes stay alive.
+		static void Clear();
+
+		static uint32 GetCount();
+
+	private:
+
+		static std::mutex Mutex;
+		static std::unordered_map<uint64, std::vector<PipelineStateRef>> States;
+
+	};
+
+}
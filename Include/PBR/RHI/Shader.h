@@ -8,6 +8,12 @@
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Forward Declarations ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class ShaderCache;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// ShaderType //////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -19,7 +25,8 @@ namespace EngineCore
 		Vertex			= 1,
 		Tessellation	= 2,
 		Geometry		= 3,
-		Fragment		= 4
+		Fragment		= 4,
+		Compute			= 5
 
 	};
 
@@ -33,6 +40,9 @@ namespace EngineCore
 		std::string VertexSource;
 		std::string FragmentSource;
 
+		// Compute shaders are programs of their own, the other sources stay empty.
+		std::string ComputeSource;
+
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -64,7 +74,9 @@ namespace EngineCore
 
 		virtual const std::string& GetName() const = 0;
 
-		static Ref<Shader> Create(const std::string& name, const ShaderSource& source);
+		// Restores the program from the cache if it holds an entry for the sources, otherwise the
+		// program is compiled and stored. Backends without program binaries ignore the cache.
+		static Ref<Shader> Create(const std::string& name, const ShaderSource& source, ShaderCache* cache = nullptr);
 
 	};
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "Shader.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderCacheStats ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct ShaderCacheStats
+	{
+
+		// Entries read with a matching key, the driver can still reject them.
+		uint32 Hits = 0;
+		uint32 Misses = 0;
+		uint32 Writes = 0;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderCache /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Stores linked program binaries on disk so they do not have to be compiled on the next start.
+	// Every shader has one entry named after it, holding the key of the sources and driver it was
+	// built from. An entry with another key is a miss and is replaced once the program is compiled
+	// again, so the cache never grows past one entry per shader.
+	//
+	// Entries are written to a temporary file and renamed over the old one, a crash or a second
+	// process never leaves a partial entry behind. Damaged entries are detected by their checksum.
+	class ShaderCache
+	{
+
+	public:
+
+		// Creates the directory if it does not exist. The cache stays disabled with a warning if
+		// it cannot be created.
+		ShaderCache(const std::string& directory);
+		~ShaderCache();
+
+		ShaderCache(const ShaderCache&) = delete;
+		ShaderCache& operator=(const ShaderCache&) = delete;
+
+		// Returns false if there is no valid entry with the key.
+		bool Load(const std::string& name, const uint64 key, uint32& format, std::vector<byte>& binary);
+		void Store(const std::string& name, const uint64 key, const uint32 format, const void* binary, const uint32 size);
+
+		inline bool IsEnabled() const { return bIsEnabled; }
+		inline const std::string& GetDirectory() const { return Directory; }
+		inline const ShaderCacheStats& GetStats() const { return Stats; }
+
+	public:
+
+		// Hash of the stage sources after they were split by ShaderLibrary and of a string naming the
+		// driver, e.g. its vendor, renderer and version.
+		static uint64 ComputeKey(const ShaderSource& source, const std::string& driver);
+
+	private:
+
+		std::string GetEntryFile(const std::string& name) const;
+
+	private:
+
+		std::string Directory;
+		bool bIsEnabled;
+
+		ShaderCacheStats Stats;
+
+	};
+
+}
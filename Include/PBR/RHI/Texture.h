@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
 #include "PBR/Core/BaseTypes.h"
 #include "PBR/Core/RefCounting.h"
 
+#include "Buffer.h"
+
 
 namespace EngineCore
 {
@@ -30,8 +36,58 @@ namespace EngineCore
 		Depth16			= 13,
 		Depth32			= 14,
 
+		// Block compressed, 4x4 texels per block. Only valid as internal format, data passed to the
+		// texture is already compressed, see TextureEncoder.
+		Bc1				= 15,
+		Bc1Srgb			= 16,
+		Bc3				= 17,
+		Bc3Srgb			= 18,
+		Bc4				= 19,
+		Bc5				= 20,
+		Bc6h			= 21,
+		Bc7				= 22,
+		Bc7Srgb			= 23,
+
 	};
 
+	static bool IsCompressedTextureFormat(const TextureFormat format)
+	{
+		return format >= TextureFormat::Bc1 && format <= TextureFormat::Bc7Srgb;
+	}
+
+	// Formats whose color channels are stored in sRGB space, alpha is always linear.
+	static bool IsSrgbTextureFormat(const TextureFormat format)
+	{
+		return format == TextureFormat::Srgb || format == TextureFormat::Bc1Srgb || format == TextureFormat::Bc3Srgb || format == TextureFormat::Bc7Srgb;
+	}
+
+	// Internal formats that can be bound to image units of compute shaders.
+	static bool IsImageTextureFormat(const TextureFormat format)
+	{
+		return format == TextureFormat::Rg16f || format == TextureFormat::Rgba16f || format == TextureFormat::Rgba32f;
+	}
+
+	// Bytes per 4x4 block of a compressed format.
+	static uint32 GetTextureBlockSize(const TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::Bc1:
+		case TextureFormat::Bc1Srgb:
+		case TextureFormat::Bc4:			return 8;
+		case TextureFormat::Bc3:
+		case TextureFormat::Bc3Srgb:
+		case TextureFormat::Bc5:
+		case TextureFormat::Bc6h:
+		case TextureFormat::Bc7:
+		case TextureFormat::Bc7Srgb:		return 16;
+
+		default: break;
+		}
+
+		return 0;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// TextureFilter ///////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,8 +150,114 @@ namespace EngineCore
 
 		bool IsShadowTexture = false;
 
+		// Streamed textures are created with only the levels from this one to the end of the chain
+		// allocated and without data, see Texture2D::SetFirstResidentMip().
+		uint32 FirstResidentMip = 0;
+
 	};
 
+	// Bytes per texel of an uncompressed internal format. Three component formats are padded to four by
+	// most drivers.
+	static uint32 GetTextureFormatSize(const TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::Rg:				return 2;
+		case TextureFormat::Rg16f:			return 4;
+		case TextureFormat::Rgb:			return 4;
+		case TextureFormat::Rgb16f:			return 8;
+		case TextureFormat::Rgb32f:			return 16;
+		case TextureFormat::Rgba:			return 4;
+		case TextureFormat::Rgba16f:		return 8;
+		case TextureFormat::Rgba32f:		return 16;
+		case TextureFormat::Srgb:			return 4;
+		case TextureFormat::Luminance:		return 1;
+		case TextureFormat::LuminanceAlpha:	return 2;
+		case TextureFormat::Depth:			return 4;
+		case TextureFormat::Depth16:		return 2;
+		case TextureFormat::Depth32:		return 4;
+
+		default: break;
+		}
+
+		return 0;
+	}
+
+	// Bytes per texel of data passed to a texture, tightly packed in the format and data type of the create info.
+	static uint32 GetTextureDataSize(const TextureFormat format, const TextureDataType type)
+	{
+		uint32 components = 0;
+		switch (format)
+		{
+		case TextureFormat::Rg:
+		case TextureFormat::Rg16f:
+		case TextureFormat::LuminanceAlpha:	components = 2; break;
+		case TextureFormat::Rgb:
+		case TextureFormat::Rgb16f:
+		case TextureFormat::Rgb32f:
+		case TextureFormat::Srgb:			components = 3; break;
+		case TextureFormat::Rgba:
+		case TextureFormat::Rgba16f:
+		case TextureFormat::Rgba32f:		components = 4; break;
+		case TextureFormat::Luminance:
+		case TextureFormat::Depth:
+		case TextureFormat::Depth16:
+		case TextureFormat::Depth32:		components = 1; break;
+
+		default: break;
+		}
+
+		return components * (type == TextureDataType::UnsignedByte ? 1 : 4);
+	}
+
+	// Largest width or height every supported GPU can create, the minimum GL 4.6 requires.
+	static constexpr uint32 MaxTextureSize = 16384;
+
+	static uint32 GetMipLevelCount(const uint32 width, const uint32 height)
+	{
+		uint32 count = 1;
+		for (uint32 size = std::max(width, height); size > 1; size /= 2)
+			++count;
+
+		return count;
+	}
+
+	static uint32 GetMipLevelSize(const uint32 size, const uint32 level)
+	{
+		return std::max(size >> level, 1u);
+	}
+
+	// Bytes of one level of the given size, as stored by the GPU.
+	static uint64 GetTextureLevelSize(const uint32 width, const uint32 height, const TextureFormat format)
+	{
+		if (IsCompressedTextureFormat(format))
+			return uint64((width + 3) / 4) * ((height + 3) / 4) * GetTextureBlockSize(format);
+
+		return uint64(width) * height * GetTextureFormatSize(format);
+	}
+
+	// Bytes of the data of one level passed to Texture2D::SetMipData(), compressed formats take blocks.
+	static uint64 GetTextureLevelDataSize(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo)
+	{
+		if (IsCompressedTextureFormat(createInfo.InternalFormat))
+			return GetTextureLevelSize(width, height, createInfo.InternalFormat);
+
+		return uint64(width) * height * GetTextureDataSize(createInfo.Format, createInfo.DataType);
+	}
+
+	// Estimated GPU memory of a texture with the given number of faces and all levels from the first
+	// resident mip to the end of the chain.
+	static uint64 GetTextureMemorySize(const uint32 width, const uint32 height, const uint32 faces, const TextureCreateInfo& createInfo)
+	{
+		const uint32 levelCount = createInfo.UseMipMaps ? GetMipLevelCount(width, height) : 1;
+
+		uint64 size = 0;
+		for (uint32 level = createInfo.FirstResidentMip; level < levelCount; ++level)
+			size += GetTextureLevelSize(GetMipLevelSize(width, level), GetMipLevelSize(height, level), createInfo.InternalFormat);
+
+		return size * faces;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Texture /////////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -110,6 +272,14 @@ namespace EngineCore
 
 		virtual uint64 GetShaderHandle() const = 0;
 
+		// Shaders may only use the handle while the texture is resident. Textures are created
+		// non-resident, TextureResidency makes the ones the renderer draws with resident and keeps
+		// them within its budget. Render targets of the renderer are made resident by their owner.
+		virtual void SetResident(const bool resident) = 0;
+		virtual bool IsResident() const = 0;
+
+		virtual uint64 GetMemorySize() const = 0;
+
 	};
 
 	using TextureRef = Ref<Texture>;
@@ -128,6 +298,34 @@ namespace EngineCore
 		virtual uint32 GetWidth() const = 0;
 		virtual uint32 GetHeight() const = 0;
 
+		// Mip streaming, only the levels from the first resident mip to the end of the chain are
+		// allocated. Width and height stay the ones of level 0. Changing the range reallocates the
+		// texture, keeps the contents of the levels resident before and after and changes the shader
+		// handle, materials using the texture have to fetch it again.
+		virtual void SetFirstResidentMip(const uint32 mip) = 0;
+		virtual uint32 GetFirstResidentMip() const = 0;
+		virtual uint32 GetMipCount() const = 0;
+
+		// Level of the full chain, has to be resident. Rows are tightly packed, in the format and data
+		// type of the create info. Compressed textures take the blocks of the level, see
+		// GetTextureLevelDataSize().
+		virtual void SetMipData(const uint32 mip, const void* data) = 0;
+
+		// Same, read from a staging buffer at the given byte offset. The copy runs on the GPU after the
+		// call returns, the range must not be overwritten until a fence placed afterwards has passed.
+		virtual void SetMipData(const uint32 mip, const PixelBufferRef& buffer, const uint32 offset) = 0;
+
+		// Sets every texel of all resident levels, e.g. to a placeholder while the data is loaded.
+		// Compressed textures can only be filled if TextureEncoder supports their format.
+		virtual void Fill(const glm::vec4& color) = 0;
+
+		// Recomputes all levels from level 0, which has to be resident. Not available for compressed
+		// textures, their levels are encoded on the CPU.
+		virtual void GenerateMipMaps() = 0;
+
+		// Binds a resident level to an image unit for reads and writes of compute shaders. Only float
+		// internal formats with two or four components can be bound, see IsImageTextureFormat().
+		virtual void BindImage(const uint32 unit, const uint32 mip) const = 0;
 
 		static Ref<Texture2D> Create(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo = TextureCreateInfo());
 		static Ref<Texture2D> Create(const uint32 width, const uint32 height, const void* data, const TextureCreateInfo& createInfo = TextureCreateInfo());
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/MappedFile.h"
+
+#include "Texture.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureContainerLevel ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct TextureContainerLevel
+	{
+
+		// Points into the mapped file, tightly packed or blocks, see GetTextureLevelDataSize().
+		const byte* Data;
+		uint32 Size;
+
+		uint32 Width;
+		uint32 Height;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureContainer ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Reads cooked 2D textures from DDS and KTX2 files. The file is memory mapped and the levels point
+	// straight into the mapping, they can be passed to Texture2D::SetMipData() without copying them
+	// first. Levels stay valid until the container is closed or destroyed.
+	//
+	// Supported are the block compressed formats of TextureFormat and 8 bit RGBA, RGB and RG or 32
+	// bit float RGBA and RGB data. Cube maps, arrays, volumes, supercompressed KTX2 files and
+	// textures larger than MaxTextureSize are rejected. Rows are stored top to bottom by both formats
+	// and are not flipped like the images decoded by TextureLibrary::Load2D(), cooked textures have
+	// to be flipped vertically when they are written.
+	class TextureContainer
+	{
+
+	public:
+
+		TextureContainer();
+		~TextureContainer();
+
+		TextureContainer(const TextureContainer&) = delete;
+		TextureContainer& operator=(const TextureContainer&) = delete;
+
+		// Maps and parses the file. Returns false with a warning if it cannot be read or is not supported.
+		bool Open(const std::string& file);
+		void Close();
+
+		inline uint32 GetWidth() const { return Width; }
+		inline uint32 GetHeight() const { return Height; }
+
+		// Stored levels, 1 or more. Fewer than the full chain down to 1x1 is possible.
+		inline uint32 GetLevelCount() const { return static_cast<uint32>(Levels.size()); }
+		inline const TextureContainerLevel& GetLevel(const uint32 level) const { return Levels[level]; }
+
+		// Format, internal format and data type of the stored data.
+		inline TextureFormat GetFormat() const { return Format; }
+		inline TextureFormat GetInternalFormat() const { return InternalFormat; }
+		inline TextureDataType GetDataType() const { return DataType; }
+
+	public:
+
+		// Based on the extension, .dds or .ktx2.
+		static bool IsContainerFile(const std::string& file);
+
+	private:
+
+		bool ParseDds();
+		bool ParseKtx2();
+
+		// Sets the format members, returns false if the format is not supported.
+		bool SetDxgiFormat(const uint32 dxgiFormat);
+		bool SetVulkanFormat(const uint32 vkFormat);
+
+		void SetFormat(const TextureFormat format, const TextureFormat internalFormat, const TextureDataType dataType);
+
+		// False for empty textures or ones larger than MaxTextureSize, checked before any level.
+		bool IsSizeSupported() const;
+
+		// Appends the level if it lies within the file and has the expected size.
+		bool AddLevel(const uint64 offset, const uint64 size);
+
+	private:
+
+		MappedFile File;
+
+		uint32 Width;
+		uint32 Height;
+
+		TextureFormat Format;
+		TextureFormat InternalFormat;
+		TextureDataType DataType;
+
+		std::vector<TextureContainerLevel> Levels;
+
+	};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/ThreadPool.h"
+
+#include "Texture.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureEncoder //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Compresses 8 bit images, and float images into Bc6h, into block compressed formats on the CPU,
+	// so textures can be cooked when they are loaded. Blocks are encoded independently, rows of blocks
+	// are split over the thread pool. Partial blocks at the right and bottom edge repeat the last
+	// column and row.
+	//
+	// Bc1 and Bc3 fit the color endpoints along the principal axis of the block and refine them with
+	// a least squares fit, Bc4 and Bc5 use the range of each channel. Bc7 fits RGBA the same way and
+	// only uses mode 6, a single subset with 4 bit indices. Bc6h only uses mode 11, a single region
+	// with 10 bit endpoints, fit on the bit patterns of the half floats. Both trade the quality of
+	// blocks with several distinct colors for speed, offline encoders pick from all modes.
+	//
+	// Fetching and splitting 8 bit blocks into channels, the principal axis fit and the Bc1 index
+	// selection have SSE2 paths, see Simd.h.
+	class TextureEncoder
+	{
+
+	public:
+
+		static bool CanEncode(const TextureFormat format);
+
+		// Channels source images should be decoded with, Bc4 reads the first one and Bc5 the first two.
+		static uint32 GetSourceChannelCount(const TextureFormat format);
+
+		// Float for Bc6h, which is encoded from HDR images, 8 bit for all other formats.
+		static TextureDataType GetSourceDataType(const TextureFormat format);
+
+		// Output has to hold GetTextureLevelSize() bytes. Missing source channels read as 0, missing
+		// alpha as 255. The caller works on block rows too, so the pool may be the one running it.
+		static void Encode(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format, byte* output, ThreadPool* pool = nullptr);
+		static void Encode(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format, byte* output, ThreadPool* pool = nullptr);
+
+		// Levels [firstMip, endMip) of the chain filtered from level 0 by TextureMipFilter, in linear
+		// space for sRGB formats. Encoded if the format is compressed, tightly packed source texels
+		// otherwise.
+		static void EncodeMipChain(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+			const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool = nullptr);
+
+		// Same for float images, levels that are not compressed hold tightly packed floats.
+		static void EncodeMipChain(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+			const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool = nullptr);
+
+	private:
+
+		static void EncodeBlockRows(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+			const uint32 beginRow, const uint32 endRow, byte* output);
+		static void EncodeBlockRows(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+			const uint32 beginRow, const uint32 endRow, byte* output);
+
+	};
+
+}
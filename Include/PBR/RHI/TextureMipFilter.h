@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/ThreadPool.h"
+
+#include "Texture.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureMipFilter ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Computes the mip chain of 8 bit and float images on the CPU for cooking, sharper and without the
+	// aliasing of the 2x2 box filter used by glGenerateMipmap. Every level is filtered from the one
+	// above with a separable, Kaiser windowed sinc in float precision, levels of 8 bit images are only
+	// rounded when they are written out. Color channels of sRGB images are filtered in linear space,
+	// alpha always is.
+	//
+	// Rows are split over the thread pool, the inner loops run over whole rows of floats so the
+	// compiler vectorizes them. Halving a row is split into its even and odd texels first, every
+	// tap then reads one of them at a fixed offset. Only odd sizes look the source texel of each tap
+	// up, the phase of the kernel changes from texel to texel there.
+	class TextureMipFilter
+	{
+
+	public:
+
+		// Half width of the kernel in texels of the smaller level.
+		static constexpr float KernelRadius = 2.0f;
+		static constexpr float KaiserAlpha = 4.0f;
+
+	private:
+
+		// Source row or column and weight of each tap, TapCount taps per target texel. Indices are
+		// clamped to the edge.
+		struct FilterTaps
+		{
+
+			uint32 TapCount;
+
+			std::vector<uint32> Indices;
+			std::vector<float> Weights;
+
+			// Whether the source is twice the target size. Tap t of target texel x then reads source
+			// texel 2 * x + FirstTap + t, unclamped, with the weights of texel 0.
+			bool bIsHalving;
+			int32 FirstTap;
+
+		};
+
+	public:
+
+		// Levels [firstMip, endMip) of the chain, tightly packed with the channels of the image. Level
+		// 0 is copied. Rows are split over the pool if given, it may be the one running the caller.
+		static void GenerateMipChain(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const bool srgb,
+			const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool = nullptr);
+
+		// Same for float images, e.g. HDR ones. Negative values written to the levels are clamped to 0.
+		static void GenerateMipChain(const float* pixels, const uint32 width, const uint32 height, const uint32 channels,
+			const uint32 firstMip, const uint32 endMip, std::vector<std::vector<float>>& levels, ThreadPool* pool = nullptr);
+
+	private:
+
+		static void ComputeTaps(const uint32 sourceSize, const uint32 targetSize, FilterTaps& taps);
+
+		// Filters the rows into targetWidth texels, then the columns into targetHeight rows.
+		template<typename T>
+		static void Downsample(const T* source, const uint32 width, const uint32 height, const uint32 channels, const float* const* decode,
+			std::vector<float>& scratch, std::vector<float>& target, const uint32 targetWidth, const uint32 targetHeight, ThreadPool* pool);
+
+		// Channel count known at compile time, so the loop over them is unrolled.
+		template<uint32 Channels>
+		static void FilterRow(const float* input, const FilterTaps& taps, const uint32 targetWidth, float* output);
+
+		// Phases is scratch memory for the even and odd texels of the row.
+		template<uint32 Channels>
+		static void FilterRowHalving(const float* input, const uint32 width, const FilterTaps& taps, const uint32 targetWidth,
+			std::vector<float>& phases, float* output);
+
+		static void WriteLevel(const float* source, const uint32 texelCount, const uint32 channels, const bool srgb, std::vector<byte>& target);
+
+	};
+
+}
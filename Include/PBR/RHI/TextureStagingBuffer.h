@@ -0,0 +1,69 @@
+#pragma once
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "Buffer.h"
+#include "Texture.h"
+#include "GpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStagingBuffer ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Stages texture uploads in one persistently mapped pixel buffer, split into one region per frame
+	// in flight like UniformRingBuffer. Writing a level only copies into mapped memory, the transfer
+	// into the texture runs on the GPU instead of stalling the render thread in the driver. The region
+	// size also bounds the data uploaded per frame. BeginFrame/EndFrame have to bracket all GPU work
+	// of a frame, render thread only.
+	class TextureStagingBuffer
+	{
+
+	public:
+
+		static constexpr uint32 FrameCount = 3;
+
+		// Pixel buffer offsets have to be a multiple of the texel component size.
+		static constexpr uint32 Alignment = 16;
+
+		static constexpr uint32 DefaultFrameSize = 16 * 1024 * 1024;
+
+	public:
+
+		TextureStagingBuffer(const uint32 frameSize = DefaultFrameSize);
+		~TextureStagingBuffer();
+
+		TextureStagingBuffer(const TextureStagingBuffer&) = delete;
+		TextureStagingBuffer& operator=(const TextureStagingBuffer&) = delete;
+
+		// Waits until the GPU released the next region.
+		void BeginFrame();
+		void EndFrame();
+
+		// Size is the one of the tightly packed level, see Texture2D::SetMipData(). Levels that do
+		// not fit into the rest of the region are uploaded directly, the driver copies them before
+		// returning. Callers should defer uploads larger than GetFreeSize() to a later frame unless
+		// nothing was staged yet this frame.
+		void Upload(const Texture2DRef& texture, const uint32 mip, const void* data, const uint32 size);
+
+		inline uint32 GetFrameSize() const { return FrameSize; }
+		inline uint32 GetUsedSize() const { return FrameOffset; }
+		inline uint32 GetFreeSize() const { return FrameSize - FrameOffset; }
+
+	private:
+
+		PixelBufferRef Buffer;
+		byte* Memory;
+
+		GpuFenceRef Fences[FrameCount];
+
+		uint32 FrameSize;
+		uint32 FrameIndex;
+		uint32 FrameOffset;
+
+	};
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "Buffer.h"
+#include "GpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// UniformAllocation ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct UniformAllocation
+	{
+
+		void* Memory = nullptr;
+
+		// Absolute range inside the ring's uniform buffer, ready for BindBlockRange.
+		uint32 Offset = 0;
+		uint32 Size = 0;
+
+
+		inline bool IsValid() const { return Memory != nullptr; }
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// UniformRingBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Sub-allocates uniform blocks from one persistently mapped buffer. The buffer is split into one
+	// region per frame in flight, each region is guarded by a fence, so writing a block never has to
+	// wait on the driver like glBufferSubData does. BeginFrame/EndFrame have to bracket all GPU work
+	// of a frame, Allocate may be called from any thread in between.
+	class UniformRingBuffer
+	{
+
+	public:
+
+		static constexpr uint32 FrameCount = 3;
+
+		// Largest GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT of current drivers, all smaller ones divide it.
+		static constexpr uint32 Alignment = 256;
+
+		static constexpr uint32 DefaultFrameSize = 4 * 1024 * 1024;
+
+	public:
+
+		UniformRingBuffer(const uint32 frameSize = DefaultFrameSize);
+		~UniformRingBuffer();
+
+		UniformRingBuffer(const UniformRingBuffer&) = delete;
+		UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+
+		// Waits until the GPU released the next region. A region that overflowed in an earlier frame
+		// is grown here, allocations failing until then have to fall back to a regular upload.
+		void BeginFrame();
+		void EndFrame();
+
+		UniformAllocation Allocate(const uint32 size);
+		UniformAllocation Upload(const void* data, const uint32 size);
+
+		inline const UniformBufferRef& GetBuffer() const { return Buffer; }
+
+		inline uint32 GetFrameSize() const { return FrameSize; }
+		inline uint32 GetUsedSize() const { return FrameOffset.load(std::memory_order_relaxed); }
+
+	private:
+
+		void Resize(const uint32 frameSize);
+
+	private:
+
+		UniformBufferRef Buffer;
+		byte* Memory;
+
+		GpuFenceRef Fences[FrameCount];
+
+		uint32 FrameSize;
+		uint32 FrameIndex;
+
+		// Keeps counting past FrameSize on overflow, BeginFrame uses it as the size to grow to.
+		std::atomic<uint32> FrameOffset;
+
+	};
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/RHI/Buffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullVertexBuffer ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+
+	public:
+
+		NullVertexBuffer(const void* data, const uint32 size, const BufferUsage usage = BufferUsage::Static);
+		virtual ~NullVertexBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void SetData(const void* data, const uint32 offset, const uint32 size) final override;
+
+		virtual void SetLayout(const BufferLayout& layout) final override { Layout = layout; }
+		virtual const BufferLayout& GetLayout() const final override { return Layout; }
+
+		virtual uint32 GetSize() const final override { return Size; }
+
+	private:
+
+		BufferLayout Layout;
+
+		uint32 Size;
+		BufferUsage Usage;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullIndexBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+
+	public:
+
+		NullIndexBuffer(const void* data, const uint32 count, const IndexType type, const BufferUsage usage = BufferUsage::Static);
+		virtual ~NullIndexBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual uint32 GetCount() const final override { return Count; }
+		virtual IndexType GetIndexType() const final override { return Type; }
+
+		virtual void SetData(const void* data, const uint32 offset, const uint32 count) final override;
+
+	private:
+
+		uint32 Count;
+		IndexType Type;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullUniformBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Keeps a CPU copy of its contents so out of bounds writes are caught.
+	class NullUniformBuffer : public UniformBuffer
+	{
+
+	public:
+
+		NullUniformBuffer(const uint32 size, const BufferUsage usage = BufferUsage::Static, const bool mapped = false);
+		NullUniformBuffer(const void* data, const uint32 size, const BufferUsage usage = BufferUsage::Static);
+		virtual ~NullUniformBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void BindBlock(const uint32 blockIndex) const final override { }
+		virtual void BindBlockRange(const uint32 blockIndex, const uint32 offset, const uint32 size) const final override;
+
+		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) final override;
+
+		virtual void* GetMappedMemory() const final override { return bIsMapped ? const_cast<byte*>(Data.data()) : nullptr; }
+
+		virtual uint32 GetSize() const final override { return static_cast<uint32>(Data.size()); }
+
+		inline const byte* GetData() const { return Data.data(); }
+
+	private:
+
+		std::vector<byte> Data;
+		bool bIsMapped;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullStorageBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullStorageBuffer : public StorageBuffer
+	{
+
+	public:
+
+		NullStorageBuffer(const uint32 size, const BufferUsage usage = BufferUsage::Dynamic);
+		virtual ~NullStorageBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void BindBlock(const uint32 blockIndex) const final override { }
+
+		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) final override;
+
+		virtual uint32 GetSize() const final override { return static_cast<uint32>(Data.size()); }
+
+		inline const byte* GetData() const { return Data.data(); }
+
+	private:
+
+		std::vector<byte> Data;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullIndirectBuffer //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Keeps the commands on the CPU, the null context reads them back to validate and count draws.
+	class NullIndirectBuffer : public IndirectBuffer
+	{
+
+	public:
+
+		NullIndirectBuffer(const uint32 capacity, const BufferUsage usage = BufferUsage::Dynamic);
+		virtual ~NullIndirectBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void SetData(const DrawIndexedIndirectCommand* commands, const uint32 count, const uint32 offset = 0) final override;
+
+		virtual uint32 GetCapacity() const final override { return static_cast<uint32>(Commands.size()); }
+
+		inline const DrawIndexedIndirectCommand* GetCommands() const { return Commands.data(); }
+
+	private:
+
+		std::vector<DrawIndexedIndirectCommand> Commands;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullPixelBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullPixelBuffer : public PixelBuffer
+	{
+
+	public:
+
+		NullPixelBuffer(const uint32 size);
+		virtual ~NullPixelBuffer();
+
+		virtual void Bind() const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void* GetMappedMemory() const final override { return const_cast<byte*>(Data.data()); }
+
+		virtual uint32 GetSize() const final override { return static_cast<uint32>(Data.size()); }
+
+		inline const byte* GetData() const { return Data.data(); }
+
+	private:
+
+		std::vector<byte> Data;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "PBR/RHI/Context.h"
+#include "PBR/RHI/PipelineState.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullContextStats ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct NullContextStats
+	{
+
+		uint64 DrawCalls = 0;
+		uint64 IndexedDrawCalls = 0;
+		uint64 InstancedDrawCalls = 0;
+		uint64 IndirectDrawCalls = 0;
+		uint64 IndirectCommands = 0;
+
+		uint64 Indices = 0;
+		uint64 Instances = 0;
+
+		uint64 ComputeDispatches = 0;
+
+		uint64 StateChanges = 0;
+		uint64 PipelineStateChanges = 0;
+		uint64 ShaderBinds = 0;
+		uint64 FrameBufferBinds = 0;
+
+		uint64 UniformUploads = 0;
+		uint64 UniformBytes = 0;
+
+		uint64 FenceSignals = 0;
+		uint64 FenceWaits = 0;
+
+		uint64 ValidationErrors = 0;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullContext /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// RHI backend without a GPU. Resources are plain CPU objects, draw calls are only validated
+	// and counted. Used to measure the CPU cost of the renderer on machines without a GL context.
+	class NullContext : public RHIContext
+	{
+
+	public:
+
+		NullContext();
+		virtual ~NullContext();
+
+		virtual void RHIClear(const ClearFlags flags = ClearFlags::ColorBuffer | ClearFlags::DepthBuffer) final override;
+		virtual void RHISetClearColor(const glm::vec4& color) final override;
+
+		virtual void RHISetDepthFunc(const DepthFunc func) final override;
+		virtual void RHIDepthMask(const bool value) final override;
+		virtual void RHISetCullMode(const CullMode mode) final override;
+		virtual void RHISetBlendFunc(const BlendFunc func) final override;
+
+		virtual void RHISetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height) final override;
+
+
+		virtual void RHISetVertexBuffer(const VertexBufferRef& vertexBuffer) final override;
+		virtual void RHISetIndexBuffer(const IndexBufferRef& indexBuffer) final override;
+		virtual void RHISetVertexArray(const VertexArrayRef& vertexArray) final override;
+
+		virtual void RHISetShader(const ShaderRef& shader) final override;
+		virtual void RHISetPipelineState(const Ref<PipelineState>& pipelineState) final override;
+		virtual void RHISetFrameBuffer(const FrameBufferRef& frameBuffer) final override;
+
+		virtual void RHISetShaderParameter() final override;
+		virtual void RHISetShaderUniformParameter() final override;
+
+		virtual void RHIBeginRenderPass(const char* name) final override;
+		virtual void RHIEndRenderPass() final override;
+
+		virtual void RHIDrawPrimitive() final override;
+		virtual void RHIDrawIndexedPrimitive() final override;
+		virtual void RHIDrawIndexedInstancedPrimitive(const uint32 instances) final override;
+		virtual void RHIDrawIndexedRangePrimitive(const uint32 count, const uint32 firstIndex, const int32 baseVertex) final override;
+
+		virtual void RHIDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset) final override;
+		virtual void RHIMultiDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount) final override;
+
+		virtual void RHIDispatchCompute(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ) final override;
+
+		virtual RenderApi GetApi() const final override { return RenderApi::None; }
+
+	public:
+
+		// Called by the null resources, mirrors what the GL objects bind directly.
+		void OnBindShader(const Shader* shader);
+		void OnBindFrameBuffer(const FrameBuffer* frameBuffer);
+		void OnBindVertexArray(const VertexArray* vertexArray);
+		void OnUniformUpload(const uint32 size);
+		void OnFenceSignal();
+		void OnFenceWait();
+
+		void ReportError(const char* message);
+
+		inline const NullContextStats& GetStats() const { return Stats; }
+		inline void ResetStats() { Stats = NullContextStats(); }
+
+		static NullContext& Get() { return static_cast<NullContext&>(RHIContext::GetContext()); }
+
+	private:
+
+		bool ValidateDraw(const bool indexed);
+
+	private:
+
+		NullContextStats Stats;
+
+		const Shader* BoundShader;
+		const FrameBuffer* BoundFrameBuffer;
+		const VertexArray* BoundVertexArray;
+
+		VertexArrayRef PendingVertexArray;
+		PipelineStateRef PendingPipelineState;
+
+		int32 RenderPassDepth;
+
+	};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "PBR/RHI/FrameBuffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullFrameBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullFrameBuffer : public FrameBuffer
+	{
+
+	public:
+
+		NullFrameBuffer(const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo = FrameBufferCreateInfo());
+		virtual ~NullFrameBuffer();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void Attach(const Ref<Texture2D>& texture, const TextureAttachment attachment = TextureAttachment::Color) final override;
+		virtual void Attach(const Ref<TextureCube>& cubeMap, const CubeMapOrientation orientation, const TextureAttachment attachment = TextureAttachment::Color, const uint32 mipLevel = 0) final override;
+
+		virtual void Resize(const uint32 width, const uint32 height) final override;
+		virtual void Clear() final override { }
+
+		virtual uint32 GetWidth() const final override { return Width; }
+		virtual uint32 GetHeight() const final override { return Height; }
+
+	private:
+
+		uint32 Width;
+		uint32 Height;
+
+		FrameBufferCreateInfo CreateInfo;
+
+	};
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "PBR/RHI/GpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuFence ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// There is no GPU running behind the null context, so every fence is passed immediately.
+	class NullGpuFence : public GpuFence
+	{
+
+	public:
+
+		NullGpuFence();
+		virtual ~NullGpuFence();
+
+		virtual void Signal() final override;
+		virtual void Wait() final override;
+
+		virtual bool IsSignaled() final override { return true; }
+
+	};
+
+}
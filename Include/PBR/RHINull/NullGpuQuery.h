@@ -0,0 +1,60 @@
+#pragma once
+
+#include "PBR/RHI/GpuQuery.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuTimestampQuery ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Commands execute when they are issued, so the CPU clock stands in for the GPU clock.
+	class NullGpuTimestampQuery : public GpuTimestampQuery
+	{
+
+	public:
+
+		NullGpuTimestampQuery();
+		virtual ~NullGpuTimestampQuery();
+
+		virtual void Issue() final override;
+
+		virtual bool IsResultAvailable() final override { return true; }
+		virtual uint64 GetResult() final override { return Timestamp; }
+
+	private:
+
+		uint64 Timestamp;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuStatisticsQuery //////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Derived from the draw counters of the null context, shader invocations stay zero.
+	class NullGpuStatisticsQuery : public GpuStatisticsQuery
+	{
+
+	public:
+
+		NullGpuStatisticsQuery();
+		virtual ~NullGpuStatisticsQuery();
+
+		virtual void Begin() final override;
+		virtual void End() final override;
+
+		virtual bool IsResultAvailable() final override { return true; }
+		virtual void GetResult(PipelineStatistics& statistics) final override { statistics = Statistics; }
+
+	private:
+
+		uint64 BeginIndices;
+
+		PipelineStatistics Statistics;
+
+	};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#include "PBR/RHI/Shader.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullShader //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullShader : public Shader
+	{
+
+	public:
+
+		NullShader(const std::string& name, const ShaderSource& source);
+		virtual ~NullShader();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void BindBlock(const std::string& name, const uint32 blockBinding) final override { }
+
+		virtual void SetUniform1i(const std::string& name, const int32 value) final override { }
+		virtual void SetUniform2i(const std::string& name, const int32 i0, const int32 i1) final override { }
+		virtual void SetUniform3i(const std::string& name, const int32 i0, const int32 i1, const int32 i2) final override { }
+		virtual void SetUniform4i(const std::string& name, const int32 i0, const int32 i1, const int32 i2, const int32 i3) final override { }
+
+		virtual void SetUniform1f(const std::string& name, const float value) final override { }
+		virtual void SetUniform2f(const std::string& name, const float f0, const float f1) final override { }
+		virtual void SetUniform3f(const std::string& name, const float f0, const float f1, const float f2) final override { }
+		virtual void SetUniform4f(const std::string& name, const float f0, const float f1, const float f2, const float f3) final override { }
+
+		virtual void SetUniformMat3f(const std::string& name, const float* data) final override { }
+		virtual void SetUniformMat4f(const std::string& name, const float* data) final override { }
+
+		virtual const std::string& GetName() const final override { return Name; }
+
+		inline bool IsCompute() const { return bIsCompute; }
+
+	private:
+
+		std::string Name;
+		bool bIsCompute;
+
+	};
+
+}
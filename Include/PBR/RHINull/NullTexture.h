@@ -0,0 +1,100 @@
+#pragma once
+
+#include "PBR/RHI/Texture.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullTexture2D ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullTexture2D : public Texture2D
+	{
+
+	public:
+
+		NullTexture2D(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo = TextureCreateInfo());
+		virtual ~NullTexture2D();
+
+		virtual void Bind(uint32 slot = 0) const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void SetData(const byte* data) final override { }
+
+		virtual uint32 GetWidth() const final override { return Width; }
+		virtual uint32 GetHeight() const final override { return Height; }
+
+		virtual void SetFirstResidentMip(const uint32 mip) final override;
+		virtual uint32 GetFirstResidentMip() const final override { return CreateInfo.FirstResidentMip; }
+		virtual uint32 GetMipCount() const final override { return MipCount; }
+
+		virtual void SetMipData(const uint32 mip, const void* data) final override;
+		virtual void SetMipData(const uint32 mip, const PixelBufferRef& buffer, const uint32 offset) final override;
+
+		virtual void Fill(const glm::vec4& color) final override;
+		virtual void GenerateMipMaps() final override;
+		virtual void BindImage(const uint32 unit, const uint32 mip) const final override;
+
+		// Unique per texture so shader parameter code behaves like with real bindless handles, changes
+		// with the resident mips like the handle of a reallocated texture.
+		virtual uint64 GetShaderHandle() const final override { return (reinterpret_cast<uint64>(this) << 16) | (Generation & 0xFFFF); }
+
+		virtual void SetResident(const bool resident) final override { bIsResident = resident; }
+		virtual bool IsResident() const final override { return bIsResident; }
+
+		virtual uint64 GetMemorySize() const final override { return GetTextureMemorySize(Width, Height, 1, CreateInfo); }
+
+	private:
+
+		uint32 Width;
+		uint32 Height;
+		uint32 MipCount;
+
+		TextureCreateInfo CreateInfo;
+
+		bool bIsResident;
+		uint32 Generation;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullTextureCube /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullTextureCube : public TextureCube
+	{
+
+	public:
+
+		NullTextureCube(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo = TextureCreateInfo());
+		virtual ~NullTextureCube();
+
+		virtual void Bind(uint32 slot = 0) const final override { }
+		virtual void Unbind() const final override { }
+
+		virtual void SetData(const byte* data, const CubeMapOrientation orientation) final override { }
+
+		virtual uint32 GetWidth() const final override { return Width; }
+		virtual uint32 GetHeight() const final override { return Height; }
+
+		virtual uint64 GetShaderHandle() const final override { return reinterpret_cast<uint64>(this); }
+
+		virtual void SetResident(const bool resident) final override { bIsResident = resident; }
+		virtual bool IsResident() const final override { return bIsResident; }
+
+		virtual uint64 GetMemorySize() const final override { return GetTextureMemorySize(Width, Height, 6, CreateInfo); }
+
+	private:
+
+		uint32 Width;
+		uint32 Height;
+
+		TextureCreateInfo CreateInfo;
+
+		bool bIsResident;
+
+	};
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/RHI/VertexArray.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullVertexArray /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class NullVertexArray : public VertexArray
+	{
+
+	public:
+
+		NullVertexArray();
+		virtual ~NullVertexArray();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void AddVertexBuffer(const VertexBufferRef& buffer) final override;
+		virtual void SetIndexBuffer(const IndexBufferRef& buffer) final override;
+
+		virtual const std::vector<VertexBufferRef>& GetVertexBuffers() const final override { return VertexBuffers; }
+		virtual const IndexBufferRef& GetIndexBuffer() const final override { return IndexBuffer; }
+
+	private:
+
+		std::vector<VertexBufferRef> VertexBuffers;
+		IndexBufferRef IndexBuffer;
+
+	};
+
+}
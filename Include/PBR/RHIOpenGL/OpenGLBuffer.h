@@ -26,11 +26,16 @@ namespace EngineCore
 		virtual void SetLayout(const BufferLayout& layout) override { Layout = layout; }
 		virtual const BufferLayout& GetLayout() const override { return Layout; }
 
+		virtual uint32 GetSize() const override { return Size; }
+
 	private:
 
 		uint32 Handle;
 		BufferLayout Layout;
 
+		uint32 Size;
+		const BufferUsage Usage;
+
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,6 +58,8 @@ namespace EngineCore
 		virtual void SetLayout(const BufferLayout& layout) final override { Layout = layout; }
 		virtual const BufferLayout& GetLayout() const final override { return Layout; }
 
+		virtual uint32 GetSize() const final override { return Size; }
+
 	private:
 
 		uint32 Handle;
@@ -72,18 +79,23 @@ namespace EngineCore
 
 	public:
 
-		OpenGLIndexBuffer(const uint32* data, const uint32 count, const BufferUsage usage = BufferUsage::Static);
+		OpenGLIndexBuffer(const void* data, const uint32 count, const IndexType type, const BufferUsage usage = BufferUsage::Static);
 		virtual ~OpenGLIndexBuffer();
 
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
 		virtual uint32 GetCount() const override { return Count; }
+		virtual IndexType GetIndexType() const override { return Type; }
+
+		virtual void SetData(const void* data, const uint32 offset, const uint32 count) override;
 
 	private:
 
 		uint32 Handle;
 		uint32 Count;
+		IndexType Type;
+		BufferUsage Usage;
 
 	};
 
@@ -108,6 +120,8 @@ namespace EngineCore
 
 		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) override;
 
+		virtual void* GetMappedMemory() const override { return nullptr; }
+
 		virtual uint32 GetSize() const { return Size; }
 
 
@@ -120,4 +134,126 @@ namespace EngineCore
 
 	};
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLMappedUniformBuffer ///////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Immutable storage that stays persistently and coherently mapped for its whole lifetime.
+	class OpenGLMappedUniformBuffer : public UniformBuffer
+	{
+
+	public:
+
+		OpenGLMappedUniformBuffer(const uint32 size);
+		virtual ~OpenGLMappedUniformBuffer();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void BindBlock(const uint32 blockIndex) const final override;
+		virtual void BindBlockRange(const uint32 blockIndex, const uint32 offset, const uint32 size) const final override;
+
+		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) final override;
+
+		virtual void* GetMappedMemory() const final override { return MappedMemory; }
+
+		virtual uint32 GetSize() const final override { return Size; }
+
+	private:
+
+		uint32 Handle;
+		uint32 Size;
+
+		void* MappedMemory;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLStorageBuffer /////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class OpenGLStorageBuffer : public StorageBuffer
+	{
+
+	public:
+
+		OpenGLStorageBuffer(const uint32 size, const BufferUsage usage = BufferUsage::Dynamic);
+		virtual ~OpenGLStorageBuffer();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void BindBlock(const uint32 blockIndex) const final override;
+
+		virtual void SetData(const void* data, const uint32 size, const uint32 offset = 0) final override;
+
+		virtual uint32 GetSize() const final override { return Size; }
+
+	private:
+
+		uint32 Handle;
+		uint32 Size;
+
+		const BufferUsage Usage;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLIndirectBuffer ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class OpenGLIndirectBuffer : public IndirectBuffer
+	{
+
+	public:
+
+		OpenGLIndirectBuffer(const uint32 capacity, const BufferUsage usage = BufferUsage::Dynamic);
+		virtual ~OpenGLIndirectBuffer();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void SetData(const DrawIndexedIndirectCommand* commands, const uint32 count, const uint32 offset = 0) final override;
+
+		virtual uint32 GetCapacity() const final override { return Capacity; }
+
+	private:
+
+		uint32 Handle;
+		uint32 Capacity;
+
+		const BufferUsage Usage;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLPixelBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Immutable storage that stays persistently and coherently mapped for its whole lifetime. Bound
+	// to the unpack target only around texture uploads, client memory uploads would read from it.
+	class OpenGLPixelBuffer : public PixelBuffer
+	{
+
+	public:
+
+		OpenGLPixelBuffer(const uint32 size);
+		virtual ~OpenGLPixelBuffer();
+
+		virtual void Bind() const final override;
+		virtual void Unbind() const final override;
+
+		virtual void* GetMappedMemory() const final override { return MappedMemory; }
+
+		virtual uint32 GetSize() const final override { return Size; }
+
+	private:
+
+		uint32 Handle;
+		uint32 Size;
+
+		void* MappedMemory;
+
+	};
+
 }
\ No newline at end of file
@@ -1,30 +1,82 @@
 #pragma once
 
 #include "PBR/RHI/Context.h"
+#include "PBR/RHI/PipelineState.h"
 
 
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLStateStats ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct OpenGLStateCounter
+	{
+
+		uint64 Issued = 0;
+		uint64 Filtered = 0;
+
+	};
+
+	struct OpenGLStateStats
+	{
+
+		OpenGLStateCounter Cull;
+		OpenGLStateCounter Depth;
+		OpenGLStateCounter Blend;
+		OpenGLStateCounter ClearColor;
+		OpenGLStateCounter Viewport;
+
+		OpenGLStateCounter PipelineState;
+		OpenGLStateCounter Program;
+		OpenGLStateCounter VertexArray;
+		OpenGLStateCounter FrameBuffer;
+		OpenGLStateCounter Buffer;
+
+	};
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLContextState //////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// Shadow copy of the GL object bindings. InvalidHandle means the real state is unknown,
+	// the next bind is always issued.
 	class OpenGLContextState
 	{
 
+	public:
+
+		static constexpr uint32 InvalidHandle = 0xFFFFFFFF;
+		static constexpr uint32 MaxUniformBufferBindings = 16;
+
 	public:
 
 		OpenGLContextState();
 		~OpenGLContextState();
 
+		void Invalidate();
+
 	public:
 
+		uint32 BoundProgram;
 		uint32 BoundVertexArray;
+		uint32 BoundFrameBuffer;
+
 		uint32 BoundVertexBuffer;
 		uint32 BoundIndexBuffer;
+		uint32 BoundUniformBuffer;
+		uint32 BoundStorageBuffer;
+		uint32 BoundIndirectBuffer;
 
-	private:
+		uint32 UniformBufferBindings[MaxUniformBufferBindings];
+		uint32 UniformBufferOffsets[MaxUniformBufferBindings];
+		uint32 UniformBufferSizes[MaxUniformBufferBindings];
+
+		uint32 ViewportX;
+		uint32 ViewportY;
+		uint32 ViewportWidth;
+		uint32 ViewportHeight;
 
 	};
 
@@ -32,15 +84,23 @@ namespace EngineCore
 	// OpenGLRHIState //////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// Fixed function state as last set through the RHI.
 	class OpenGLRHIState
 	{
 
+	public:
+
+		static constexpr ::EngineCore::CullMode UnknownCullMode = static_cast<::EngineCore::CullMode>(0xFF);
+		static constexpr ::EngineCore::DepthFunc UnknownDepthFunc = static_cast<::EngineCore::DepthFunc>(0xFF);
+		static constexpr ::EngineCore::BlendFunc UnknownBlendFunc = static_cast<::EngineCore::BlendFunc>(0xFF);
+
 	public:
 
 		OpenGLRHIState();
 		~OpenGLRHIState();
 
 		void Reset();
+		void Invalidate();
 
 	public:
 
@@ -48,6 +108,15 @@ namespace EngineCore
 		DepthFunc DepthFunc;
 		BlendFunc BlendFunc;
 
+		bool bIsDepthMaskKnown;
+		bool bDepthMask;
+
+		bool bIsClearColorKnown;
+		glm::vec4 ClearColor;
+
+		PrimitiveType Primitive;
+		PipelineStateRef BoundPipelineState;
+
 		ShaderRef BoundShader;
 		FrameBufferRef BoundFrameBuffer;
 
@@ -88,23 +157,51 @@ namespace EngineCore
 		virtual void RHISetVertexArray(const VertexArrayRef& vertexArray) final override;
 
 		virtual void RHISetShader(const ShaderRef& shader) final override;
+		virtual void RHISetPipelineState(const Ref<PipelineState>& pipelineState) final override;
 		virtual void RHISetFrameBuffer(const FrameBufferRef& frameBuffer) final override;
 
 		virtual void RHISetShaderParameter() final override;
 		virtual void RHISetShaderUniformParameter() final override;
 
-		virtual void RHIBeginRenderPass() final override;
+		virtual void RHIBeginRenderPass(const char* name) final override;
 		virtual void RHIEndRenderPass() final override;
 
 		virtual void RHIDrawPrimitive() final override;
 		virtual void RHIDrawIndexedPrimitive() final override;
 		virtual void RHIDrawIndexedInstancedPrimitive(const uint32 instances) final override;
+		virtual void RHIDrawIndexedRangePrimitive(const uint32 count, const uint32 firstIndex, const int32 baseVertex) final override;
 
-	private:
+		virtual void RHIDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset) final override;
+		virtual void RHIMultiDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount) final override;
 
-		void CachedBindVertexArray(OpenGLContextState& context, const uint32 vertexArray);
-		void CachedBindVertexBuffer(OpenGLContextState& context, const uint32 vertexBuffer);
-		void CachedBindIndexBuffer(OpenGLContextState& context, const uint32 indexBuffer);
+		virtual void RHIDispatchCompute(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ) final override;
+
+	public:
+
+		// All GL objects bind through these, so redundant binds never reach the driver.
+		void CachedUseProgram(const uint32 program);
+		void CachedBindVertexArray(const uint32 vertexArray);
+		void CachedBindFrameBuffer(const uint32 frameBuffer);
+		void CachedBindBuffer(const uint32 target, const uint32 buffer);
+		void CachedBindBufferBase(const uint32 target, const uint32 index, const uint32 buffer);
+		void CachedBindBufferRange(const uint32 target, const uint32 index, const uint32 buffer, const uint32 offset, const uint32 size);
+		void CachedViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height);
+
+		// Deleted names can be reused by the driver, so they must not stay in the cache.
+		void OnDeleteProgram(const uint32 program);
+		void OnDeleteVertexArray(const uint32 vertexArray);
+		void OnDeleteFrameBuffer(const uint32 frameBuffer);
+		void OnDeleteBuffer(const uint32 buffer);
+
+		// Has to be called after GL state was changed outside of the RHI.
+		void InvalidateState();
+
+		inline const OpenGLStateStats& GetStateStats() const { return Stats; }
+		inline void ResetStateStats() { Stats = OpenGLStateStats(); }
+
+		static OpenGLContext& Get() { return static_cast<OpenGLContext&>(RHIContext::GetContext()); }
+
+	private:
 
 		virtual RenderApi GetApi() const final override { return RenderApi::OpenGL; }
 
@@ -113,6 +210,8 @@ namespace EngineCore
 		OpenGLRHIState PendingState;
 		OpenGLContextState ContextState;
 
+		OpenGLStateStats Stats;
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "PBR/RHI/GpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuFence //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class OpenGLGpuFence : public GpuFence
+	{
+
+	public:
+
+		OpenGLGpuFence();
+		virtual ~OpenGLGpuFence();
+
+		virtual void Signal() final override;
+		virtual void Wait() final override;
+
+		virtual bool IsSignaled() final override;
+
+	private:
+
+		void Release();
+
+	private:
+
+		// GLsync, kept opaque so the header does not pull in the GL loader.
+		void* Sync;
+
+	};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "PBR/RHI/GpuQuery.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuTimestampQuery /////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class OpenGLGpuTimestampQuery : public GpuTimestampQuery
+	{
+
+	public:
+
+		OpenGLGpuTimestampQuery();
+		virtual ~OpenGLGpuTimestampQuery();
+
+		virtual void Issue() final override;
+
+		virtual bool IsResultAvailable() final override;
+		virtual uint64 GetResult() final override;
+
+	private:
+
+		uint32 RendererId;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuStatisticsQuery ////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// One GL query per counter, GL_ARB_pipeline_statistics_query (core since 4.6).
+	class OpenGLGpuStatisticsQuery : public GpuStatisticsQuery
+	{
+
+	public:
+
+		static constexpr uint32 CounterCount = 6;
+
+	public:
+
+		OpenGLGpuStatisticsQuery();
+		virtual ~OpenGLGpuStatisticsQuery();
+
+		virtual void Begin() final override;
+		virtual void End() final override;
+
+		virtual bool IsResultAvailable() final override;
+		virtual void GetResult(PipelineStatistics& statistics) final override;
+
+		static bool IsSupported();
+
+	private:
+
+		uint32 RendererIds[CounterCount];
+
+	};
+
+}
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "PBR/RHI/Shader.h"
+#include "PBR/RHI/ShaderCache.h"
 #include "PBR/Core/BaseTypes.h"
 
 
@@ -19,7 +20,7 @@ namespace EngineCore
 
 	public:
 
-		OpenGLShader(const std::string& name, const ShaderSource& source);
+		OpenGLShader(const std::string& name, const ShaderSource& source, ShaderCache* cache);
 		virtual ~OpenGLShader();
 
 		virtual void Bind() const override;
@@ -45,7 +46,11 @@ namespace EngineCore
 	private:
 
 		uint32 CompileShader(const std::string& source, const uint32 type) const;
-		uint32 CreateShader(const ShaderSource& source) const;
+		uint32 CreateShader(const std::string& name, const ShaderSource& source, ShaderCache* cache) const;
+
+		// Returns 0 if there is no entry or the driver rejects it.
+		uint32 LoadProgram(const std::string& name, const uint64 key, ShaderCache& cache) const;
+		void StoreProgram(const std::string& name, const uint64 key, const uint32 program, ShaderCache& cache) const;
 
 		int32 GetUniformLocation(const std::string& name);
 		int32 GetUniformBlockIndex(const std::string& name);
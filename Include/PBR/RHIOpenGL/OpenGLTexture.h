@@ -47,13 +47,30 @@ namespace EngineCore
 		virtual uint32 GetWidth() const override { return Width; }
 		virtual uint32 GetHeight() const override { return Height; }
 
+		virtual void SetFirstResidentMip(const uint32 mip) override;
+		virtual uint32 GetFirstResidentMip() const override { return CreateInfo.FirstResidentMip; }
+		virtual uint32 GetMipCount() const override { return MipCount; }
+
+		virtual void SetMipData(const uint32 mip, const void* data) override;
+		virtual void SetMipData(const uint32 mip, const PixelBufferRef& buffer, const uint32 offset) override;
+
+		virtual void Fill(const glm::vec4& color) override;
+		virtual void GenerateMipMaps() override;
+		virtual void BindImage(const uint32 unit, const uint32 mip) const override;
+
 		virtual uint64 GetShaderHandle() const override { return ShaderHandle; }
 
+		virtual void SetResident(const bool resident) override;
+		virtual bool IsResident() const override { return bIsResident; }
+
+		virtual uint64 GetMemorySize() const override { return MemorySize; }
+
 		inline uint32 GetHandle() const { return Handle; }
 
 	private:
 
-		void Create(const uint32 width, const uint32 height, const void* data, const TextureCreateInfo& createInfo);
+		// Level 0 of the GL texture is the first resident mip.
+		void Create(const void* data);
 
 	private:
 
@@ -62,6 +79,10 @@ namespace EngineCore
 
 		uint32 Width;
 		uint32 Height;
+		uint32 MipCount;
+
+		uint64 MemorySize;
+		bool bIsResident;
 
 		TextureCreateInfo CreateInfo;
 
@@ -90,6 +111,11 @@ namespace EngineCore
 
 		virtual uint64 GetShaderHandle() const override { return ShaderHandle; }
 
+		virtual void SetResident(const bool resident) override;
+		virtual bool IsResident() const override { return bIsResident; }
+
+		virtual uint64 GetMemorySize() const override { return MemorySize; }
+
 		inline uint32 GetHandle() const { return Handle; }
 
 	private:
@@ -104,6 +130,9 @@ namespace EngineCore
 		uint32 Width;
 		uint32 Height;
 
+		uint64 MemorySize;
+		bool bIsResident;
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/RefCounting.h"
+
+#include "PBR/RHI/Buffer.h"
+#include "PBR/RHI/VertexArray.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RangeAllocator //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// First fit free list over [0, capacity). Offsets and sizes are given in elements, freed ranges
+	// are merged with their neighbours.
+	class RangeAllocator
+	{
+
+	public:
+
+		static constexpr uint32 InvalidOffset = ~0u;
+
+	private:
+
+		struct Range
+		{
+
+			uint32 Offset;
+			uint32 Size;
+
+		};
+
+	public:
+
+		RangeAllocator(const uint32 capacity);
+		~RangeAllocator();
+
+		// Returns InvalidOffset if no free range is large enough.
+		uint32 Allocate(const uint32 size);
+		void Free(const uint32 offset, const uint32 size);
+
+		// Appends the new space as free range, existing allocations keep their offsets.
+		void Grow(const uint32 capacity);
+
+		// Marks [0, usedSize) as allocated and everything behind it as free.
+		void Reset(const uint32 usedSize);
+
+		// 0 if all free space is one range, close to 1 if it is scattered across many small ones.
+		float GetFragmentation() const;
+
+		// True if all free space is one range at the end.
+		bool IsCompact() const;
+
+		// Size of the free range ending at the capacity, 0 if the last element is allocated.
+		uint32 GetTrailingFreeSize() const;
+
+		inline uint32 GetCapacity() const { return Capacity; }
+		inline uint32 GetFreeSize() const { return FreeSize; }
+		inline uint32 GetUsedSize() const { return Capacity - FreeSize; }
+
+	private:
+
+		// Sorted by offset.
+		std::vector<Range> FreeRanges;
+
+		uint32 Capacity;
+		uint32 FreeSize;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryAllocation //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Indices are relative to the first vertex, draws pass it as base vertex.
+	struct GeometryAllocation
+	{
+
+		uint32 FirstVertex;
+		uint32 VertexCount;
+
+		uint32 FirstIndex;
+		uint32 IndexCount;
+
+	};
+
+	using GeometryHandle = uint32;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryBuffer //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// One vertex and index buffer shared by all meshes of a vertex format, bound through a single
+	// vertex array. Meshes are suballocated ranges and drawn with base vertex and first index, so
+	// consecutive draws don't switch vertex arrays and indirect draws can batch across meshes.
+	//
+	// A CPU copy of the contents is kept, growing and defragmenting only re-upload it. Growing appends
+	// to the end and keeps all offsets, recorded draws still use the old buffers through their vertex
+	// array. Defragmenting replaces the offsets, so it must not run while recorded draws are pending.
+	// Allocate() and Defragment() issue GL work, Free() may be called from any thread.
+	class GeometryBuffer : public RefCountedObject
+	{
+
+	public:
+
+		static constexpr GeometryHandle InvalidHandle = ~0u;
+
+	public:
+
+		GeometryBuffer(const BufferLayout& layout, const IndexType indexType, const uint32 vertexCapacity, const uint32 indexCapacity);
+		virtual ~GeometryBuffer();
+
+		GeometryBuffer(const GeometryBuffer&) = delete;
+		GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+
+		// Vertices have to match the layout, indices the index type of the buffer.
+		GeometryHandle Allocate(const void* vertices, const uint32 vertexCount, const void* indices, const uint32 indexCount);
+		void Free(const GeometryHandle handle);
+
+		// Moves all allocations to the front of the buffers. Returns false if nothing was moved.
+		bool Defragment();
+
+		float GetFragmentation() const;
+
+		inline const GeometryAllocation& GetAllocation(const GeometryHandle handle) const { return Allocations[handle]; }
+		inline const VertexArrayRef& GetVertexArray() const { return VertexArray; }
+
+		inline const BufferLayout& GetLayout() const { return Layout; }
+		inline IndexType GetIndexType() const { return Type; }
+
+		inline uint32 GetVertexCapacity() const { return VertexRanges.GetCapacity(); }
+		inline uint32 GetIndexCapacity() const { return IndexRanges.GetCapacity(); }
+		inline uint32 GetAllocationCount() const { return static_cast<uint32>(Allocations.size() - FreeHandles.size()); }
+
+	private:
+
+		// Expect the lock to be held.
+		bool Compact();
+		bool Grow(const uint32 vertexCapacity, const uint32 indexCapacity);
+
+		void CreateBuffers();
+		void Upload();
+
+	private:
+
+		BufferLayout Layout;
+		IndexType Type;
+
+		uint32 VertexStride;
+		uint32 IndexStride;
+
+		RangeAllocator VertexRanges;
+		RangeAllocator IndexRanges;
+
+		std::vector<byte> VertexData;
+		std::vector<byte> IndexData;
+
+		// Freed entries have a vertex count of 0 and are reused by later allocations.
+		std::vector<GeometryAllocation> Allocations;
+		std::vector<GeometryHandle> FreeHandles;
+
+		VertexArrayRef VertexArray;
+
+		mutable std::mutex Mutex;
+
+	};
+
+	using GeometryBufferRef = Ref<GeometryBuffer>;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryPool ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Owns one geometry buffer per vertex layout and index type. Layouts are identified by address,
+	// they have to outlive the pool, see Mesh::GetVertexLayout(). Created by the renderer.
+	class GeometryPool
+	{
+
+	public:
+
+		static constexpr uint32 InitialVertexCapacity = 256 * 1024;
+		static constexpr uint32 InitialIndexCapacity = 1024 * 1024;
+
+		// Buffers whose free space is more fragmented than this are compacted by Defragment().
+		static constexpr float MaxFragmentation = 0.5f;
+
+	private:
+
+		struct Entry
+		{
+
+			const BufferLayout* Layout;
+			IndexType Type;
+
+			GeometryBufferRef Buffer;
+
+		};
+
+	public:
+
+		GeometryPool();
+		~GeometryPool();
+
+		GeometryPool(const GeometryPool&) = delete;
+		GeometryPool& operator=(const GeometryPool&) = delete;
+
+		const GeometryBufferRef& GetBuffer(const BufferLayout& layout, const IndexType indexType);
+
+		// Has to be called while no recorded draws are pending, the renderer does it at the start of a frame.
+		void Defragment();
+
+		inline uint32 GetBufferCount() const { return static_cast<uint32>(Buffers.size()); }
+
+	public:
+
+		static GeometryPool* GetInstance() { return Instance; }
+
+	private:
+
+		static GeometryPool* Instance;
+
+		std::vector<Entry> Buffers;
+
+	};
+
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/RHI/Texture.h"
+#include "PBR/RHI/FrameBuffer.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Forward Declarations ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class GpuProfiler;
+	class RenderGraph;
+
+	// Index of a resource in the graph it was declared in, only valid for the current frame.
+	using RenderGraphResource = uint32;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraphBuilder //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Passed to the setup function of a pass to declare the resources it accesses. Resources are
+	// looked up by name, creating a resource with the name of an existing one hides the old one
+	// for all passes added afterwards. Post processing effects read "SceneColor" and create a
+	// new "SceneColor", so they can be added or removed without knowing their neighbours.
+	// The returned handles are kept in the pass data to access the resources in execute.
+	class RenderGraphBuilder
+	{
+
+	public:
+
+		RenderGraphBuilder(RenderGraph& graph, const uint32 pass);
+
+		// Transient resources, taken from the render target pool right before the first pass
+		// using them and returned after the last one.
+		RenderGraphResource CreateTexture(const char* name, const RenderTargetDesc& desc);
+		RenderGraphResource CreateFrameBuffer(const char* name, const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo = FrameBufferCreateInfo());
+
+		RenderGraphResource Read(const char* name);
+
+		// Writing an existing resource keeps its contents, the pass depends on the previous writer.
+		RenderGraphResource Write(const char* name);
+
+		// Resources are optional inputs, e.g. the shadow map of a frame without shadows.
+		bool HasResource(const char* name) const;
+
+		// Passes with side effects, like drawing to the back buffer, are never culled.
+		void SetSideEffect();
+
+	private:
+
+		RenderGraph& Graph;
+		const uint32 Pass;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraphContext //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Passed to the execute function, resolves the resources declared during setup.
+	class RenderGraphContext
+	{
+
+	public:
+
+		RenderGraphContext(const RenderGraph& graph);
+
+		const Texture2DRef& GetTexture(const RenderGraphResource resource) const;
+		const FrameBufferRef& GetFrameBuffer(const RenderGraphResource resource) const;
+
+	private:
+
+		const RenderGraph& Graph;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraph /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Passes declare which named resources they read and write, the graph derives the execution
+	// order from these dependencies, culls passes whose outputs are never consumed by a pass with
+	// side effects and manages the lifetime of transient resources.
+	//
+	// The graph is built again every frame: Reset(), AddPass() for every enabled pass, Compile()
+	// and Execute(). Pass and resource names are not copied, they have to outlive the frame.
+	// Only used on the render thread.
+	class RenderGraph
+	{
+
+	public:
+
+		using ExecuteFunction = std::function<void(const RenderGraphContext& context)>;
+
+		static constexpr uint32 InvalidIndex = ~0u;
+
+	private:
+
+		enum class ResourceType
+		{
+			Texture,
+			FrameBuffer
+		};
+
+		struct Resource
+		{
+
+			const char* Name;
+			ResourceType Type;
+
+			bool bIsImported;
+
+			RenderTargetDesc Desc;
+			FrameBufferCreateInfo FrameBufferInfo;
+
+			Texture2DRef Texture;
+			FrameBufferRef FrameBuffer;
+
+			// Only used while passes are added.
+			uint32 LastWriter;
+			std::vector<uint32> Readers;
+
+			// Index into the compiled pass order, InvalidIndex if no executed pass uses it.
+			uint32 FirstUse;
+			uint32 LastUse;
+
+		};
+
+		struct ResourceAccess
+		{
+
+			uint32 Resource;
+			bool bIsWrite;
+
+		};
+
+		struct Pass
+		{
+
+			const char* Name;
+			ExecuteFunction Execute;
+
+			std::vector<ResourceAccess> Accesses;
+
+			// Passes this pass consumes the output of, and passes it only has to run after.
+			std::vector<uint32> Producers;
+			std::vector<uint32> Predecessors;
+
+			bool bHasSideEffect;
+			bool bIsCulled;
+
+		};
+
+	public:
+
+		RenderGraph(RenderTargetPool& pool);
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		// External resources, their lifetime is not managed by the graph.
+		void ImportTexture(const char* name, const Texture2DRef& texture);
+
+		// The pass data is filled by the setup function and handed to the execute function.
+		template<typename PassData>
+		void AddPass(const char* name, const std::function<void(RenderGraphBuilder&, PassData&)>& setup, const std::function<void(const RenderGraphContext&, const PassData&)>& execute)
+		{
+			const std::shared_ptr<PassData> data = std::make_shared<PassData>();
+
+			RenderGraphBuilder builder(*this, CreatePass(name, [execute, data](const RenderGraphContext& context) { execute(context, *data); }));
+			setup(builder, *data);
+		}
+
+		void Compile();
+
+		// Every pass is measured as a GPU scope if a profiler is given.
+		void Execute(GpuProfiler* profiler = nullptr);
+
+		// Returns all transient resources still held and removes all passes and resources.
+		void Reset();
+
+		inline uint32 GetPassCount() const { return static_cast<uint32>(Passes.size()); }
+		inline uint32 GetCulledPassCount() const { return static_cast<uint32>(Passes.size() - Order.size()); }
+
+		// Names of the executed passes in execution order, valid after Compile().
+		void GetExecutionOrder(std::vector<const char*>& names) const;
+
+	private:
+
+		uint32 CreatePass(const char* name, const ExecuteFunction& execute);
+
+		uint32 FindResource(const char* name) const;
+		uint32 AddResource(const char* name, const ResourceType type);
+
+		RenderGraphResource AddAccess(const uint32 pass, const uint32 resource, const bool write);
+
+		void SortPasses();
+		void CullPasses();
+		void ComputeLifetimes();
+
+		void AcquireResource(Resource& resource);
+		void ReleaseResource(Resource& resource);
+
+	private:
+
+		RenderTargetPool& Pool;
+
+		std::vector<Pass> Passes;
+		std::vector<Resource> Resources;
+
+		// Indices of the passes that are executed, in execution order.
+		std::vector<uint32> Order;
+
+		bool bIsCompiled;
+
+	private:
+
+		friend class RenderGraphBuilder;
+		friend class RenderGraphContext;
+
+	};
+
+}
@@ -4,6 +4,7 @@
 
 #include "PBR/RHI/FrameBuffer.h"
 #include "PBR/RHI/CommandList.h"
+#include "PBR/RHI/PipelineState.h"
 
 
 namespace EngineCore
@@ -28,7 +29,10 @@ namespace EngineCore
 			: RendererInstance(renderer)
 			, Primitive(PrimitiveType::Triangles)
 			, CullingMode(CullMode::Back)
-			, BlendingFunc(BlendFunc::OneMinusSourceAlpha)
+			, DepthTest(DepthFunc::Less)
+			, bDepthWrite(true)
+			, BlendingFunc(BlendFunc::None)
+			, PipelineState(nullptr)
 			, Shader(nullptr)
 			, FrameBuffer(nullptr)
 			, RenderTarget(nullptr)
@@ -43,11 +47,13 @@ namespace EngineCore
 
 		}
 
-		inline void SetPrimitiveType(const PrimitiveType primitive) { Primitive = primitive; }
-		inline void SetCullMode(const CullMode mode) { CullingMode = mode; }
-		inline void SetBlendFunc(const BlendFunc func) { BlendingFunc = func; }
+		inline void SetPrimitiveType(const PrimitiveType primitive) { Primitive = primitive; PipelineState = nullptr; }
+		inline void SetCullMode(const CullMode mode) { CullingMode = mode; PipelineState = nullptr; }
+		inline void SetDepthFunc(const DepthFunc func) { DepthTest = func; PipelineState = nullptr; }
+		inline void SetDepthWrite(const bool value) { bDepthWrite = value; PipelineState = nullptr; }
+		inline void SetBlendFunc(const BlendFunc func) { BlendingFunc = func; PipelineState = nullptr; }
 
-		inline void SetShader(const ShaderRef& shader) { Shader = shader; }
+		inline void SetShader(const ShaderRef& shader) { Shader = shader; PipelineState = nullptr; }
 		inline void SetFrameBuffer(const FrameBufferRef& frameBuffer) { FrameBuffer = frameBuffer; }
 
 		inline void SetRenderTarget(const Texture2DRef& target) { RenderTarget = target; }
@@ -55,6 +61,25 @@ namespace EngineCore
 		inline void SetStencilTarget(const Texture2DRef& target) { StencilTarget = target; }
 
 
+		// Built on first use and shared through the pipeline state cache.
+		const PipelineStateRef& GetPipelineState()
+		{
+			if (!PipelineState)
+			{
+				PipelineStateDesc desc;
+				desc.Shader = Shader;
+				desc.Rasterizer.Primitive = Primitive;
+				desc.Rasterizer.CullingMode = CullingMode;
+				desc.DepthStencil.DepthTest = DepthTest;
+				desc.DepthStencil.bDepthWrite = bDepthWrite;
+				desc.Blend.BlendingFunc = BlendingFunc;
+
+				PipelineState = PipelineState::Create(desc);
+			}
+
+			return PipelineState;
+		}
+
 		inline const ShaderRef& GetShader() const { return Shader; }
 		inline const FrameBufferRef& GetFrameBuffer() const { return FrameBuffer; }
 
@@ -62,14 +87,24 @@ namespace EngineCore
 		inline const Texture2DRef& GetDepthTarget() const { return DepthTarget; }
 		inline const Texture2DRef& GetStencilTarget() const { return StencilTarget; }
 
+	protected:
+
+		// Writes the block into the renderer's uniform ring and binds that range. Falls back to
+		// updating and binding the given buffer when the ring is full for this frame.
+		void SetUniformBlock(RHICommandList& commandList, const UniformBufferRef& uniformBuffer, const uint32 blockIndex, const void* data, const uint32 size) const;
+
 	protected:
 
 		Renderer* RendererInstance;
 
 		PrimitiveType Primitive;
 		CullMode CullingMode;
+		DepthFunc DepthTest;
+		bool bDepthWrite;
 		BlendFunc BlendingFunc;
 
+		PipelineStateRef PipelineState;
+
 		ShaderRef Shader;
 		FrameBufferRef FrameBuffer;
 
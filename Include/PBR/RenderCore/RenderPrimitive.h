@@ -8,6 +8,15 @@
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PrimitiveHandle /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Slot of a registered primitive in the GPU scene, see Renderer::RegisterPrimitive.
+	using PrimitiveHandle = uint32;
+
+	static constexpr PrimitiveHandle InvalidPrimitiveHandle = 0xFFFFFFFF;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RenderPrimitive /////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +39,9 @@ namespace EngineCore
 		inline const Transform& GetTransform() const { return Transformation; }
 		inline Transform& GetTransform() { return Transformation; }
 
+		inline PrimitiveHandle GetHandle() const { return Handle; }
+		inline bool IsRegistered() const { return Handle != InvalidPrimitiveHandle; }
+
 	private:
 
 		MeshRef Mesh;
@@ -37,6 +49,8 @@ namespace EngineCore
 		
 		Transform Transformation;
 
+		PrimitiveHandle Handle;
+
 	private:
 
 		friend class Renderer;
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "PBR/Core/BaseTypes.h"
+
 
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Forward Declarations ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class Renderer;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RenderStage /////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,12 +21,24 @@ namespace EngineCore
 
 	public:
 
+		RenderStage(Renderer* renderer)
+			: RendererInstance(renderer)
+		{
+		}
+
 		virtual ~RenderStage() { }
 
 
 		// virtual void Init() = 0;
-		// virtual void Resize(const uint32 width, const uint32 height) = 0;
+
+		// Resolution of the targets created from now on. Targets of other sizes that are still in
+		// the render target pool age out there.
+		virtual void Resize(const uint32 width, const uint32 height) { }
+
+	protected:
+
+		Renderer* RendererInstance;
 
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/RHI/Texture.h"
+#include "PBR/RHI/FrameBuffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderTargetDesc ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct RenderTargetDesc
+	{
+
+		uint32 Width = 0;
+		uint32 Height = 0;
+
+		TextureCreateInfo CreateInfo;
+
+
+		bool operator==(const RenderTargetDesc& other) const;
+		bool operator!=(const RenderTargetDesc& other) const { return !(*this == other); }
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderTargetPool ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Hands out transient render targets and frame buffers by description. A released target is
+	// handed to the next stage asking for the same description, so stages whose targets are not
+	// alive at the same time share memory. Released targets keep their contents until they are
+	// acquired again.
+	//
+	// Entries that were not acquired for MaxUnusedFrames frames are destroyed in EndFrame().
+	// Only used on the render thread.
+	class RenderTargetPool
+	{
+
+	public:
+
+		static constexpr uint32 MaxUnusedFrames = 3;
+
+	private:
+
+		struct TargetEntry
+		{
+
+			RenderTargetDesc Desc;
+			Texture2DRef Texture;
+
+			bool bIsInUse;
+			uint64 LastUsedFrame;
+
+		};
+
+		struct FrameBufferEntry
+		{
+
+			uint32 Width;
+			uint32 Height;
+			FrameBufferCreateInfo CreateInfo;
+
+			FrameBufferRef FrameBuffer;
+
+			bool bIsInUse;
+			uint64 LastUsedFrame;
+
+		};
+
+	public:
+
+		RenderTargetPool();
+		~RenderTargetPool();
+
+		RenderTargetPool(const RenderTargetPool&) = delete;
+		RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+		Texture2DRef AcquireTarget(const RenderTargetDesc& desc);
+		void ReleaseTarget(const Texture2DRef& texture);
+
+		// Frame buffers carry their own depth buffer, attachments are set by the pass using it.
+		FrameBufferRef AcquireFrameBuffer(const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo = FrameBufferCreateInfo());
+		void ReleaseFrameBuffer(const FrameBufferRef& frameBuffer);
+
+		void EndFrame();
+
+		inline uint32 GetTargetCount() const { return static_cast<uint32>(Targets.size()); }
+		inline uint32 GetFrameBufferCount() const { return static_cast<uint32>(FrameBuffers.size()); }
+
+	private:
+
+		std::vector<TargetEntry> Targets;
+		std::vector<FrameBufferEntry> FrameBuffers;
+
+		uint64 FrameNumber;
+
+	};
+
+}
@@ -5,6 +5,7 @@
 #include "PBR/RHI/FrameBuffer.h"
 
 #include "PBR/RenderCore/RenderStage.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
 #include "PBR/RenderCore/RenderPass.h"
 
 
@@ -178,15 +179,17 @@ namespace EngineCore
 		virtual ~BloomStage();
 
 		void Init();
-		void Execute(const Texture2DRef& sceneTexture);
+		void Execute(const Texture2DRef& sceneTexture, const Texture2DRef& target);
+
+		virtual void Resize(const uint32 width, const uint32 height) final override;
 
-		inline const Texture2DRef& GetTargetTexture() const { return TargetTexture; }
+		inline const RenderTargetDesc& GetTargetDesc() const { return TargetDesc; }
 
 	private:
 
 		void ExecuteBrightnessPass(const Texture2DRef& sceneTexture);
 		void ExecuteBlurPass(const Texture2DRef& sourceTexture);
-		void ExecuteBlendPass(const Texture2DRef& sceneTexture);
+		void ExecuteBlendPass(const Texture2DRef& sceneTexture, const Texture2DRef& target);
 
 	private:
 
@@ -198,12 +201,14 @@ namespace EngineCore
 		ShaderRef BlurPassShader;
 		ShaderRef BlendPassShader;
 
+		// Bright and blur passes share one half resolution frame buffer.
 		FrameBufferRef TargetFrameBuffer;
 		FrameBufferRef BloomFrameBuffer;
-		FrameBufferRef FrameBufferH;
-		FrameBufferRef FrameBufferV;
 
-		Texture2DRef TargetTexture;
+		RenderTargetDesc TargetDesc;
+		RenderTargetDesc BloomDesc;
+		RenderTargetDesc BlurDesc;
+
 		Texture2DRef BloomTexture;
 		Texture2DRef BlurTextureH;
 		Texture2DRef BlurTextureV;
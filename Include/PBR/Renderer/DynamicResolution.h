@@ -0,0 +1,86 @@
+#pragma once
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/Renderer/GpuProfiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DynamicResolution ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Picks the internal render resolution from measured GPU frame times. The scale applies to both
+	// axes, the frame time is assumed to grow with the pixel count. It is only lowered when the
+	// average frame time exceeds the target and only raised when there is enough headroom, so the
+	// resolution does not oscillate around the target.
+	//
+	// GPU reports arrive some frames late, after a change the controller waits until the reports
+	// show frames rendered at the new resolution. Scales are quantized to ScaleStep, so only a few
+	// target sizes ever end up in the render target pool.
+	class DynamicResolution
+	{
+
+	public:
+
+		static constexpr float ScaleStep = 0.05f;
+		static constexpr float MaxScaleChange = 0.15f;
+
+		// Frame times below Target * UpscaleThreshold allow a higher resolution.
+		static constexpr float UpscaleThreshold = 0.8f;
+
+		// Frames averaged at a scale before it is changed again.
+		static constexpr uint32 MinSampleCount = 4;
+
+	public:
+
+		DynamicResolution();
+
+		// Called with the latest report and the number of the frame about to be rendered, see
+		// GpuProfiler::GetFrameNumber(). Returns true if the render resolution changed.
+		bool Update(const GpuFrameReport& report, const uint64 frameNumber);
+
+		// Back to full resolution, e.g. after the output size changed.
+		void Reset();
+
+		void SetOutputSize(const uint32 width, const uint32 height);
+
+		inline void SetTargetFrameTime(const float milliseconds) { TargetMilliseconds = milliseconds; }
+		inline void SetScaleRange(const float minScale, const float maxScale) { MinScale = minScale; MaxScale = maxScale; }
+
+		inline float GetTargetFrameTime() const { return TargetMilliseconds; }
+		inline float GetScale() const { return Scale; }
+
+		inline uint32 GetRenderWidth() const { return RenderWidth; }
+		inline uint32 GetRenderHeight() const { return RenderHeight; }
+
+	private:
+
+		void ApplyScale(const float scale);
+
+	private:
+
+		float TargetMilliseconds;
+		float MinScale;
+		float MaxScale;
+
+		float Scale;
+		double AverageMilliseconds;
+		uint32 SampleCount;
+
+		// Reports of frames submitted before this one were rendered at the previous resolution.
+		uint64 FirstFrameAtScale;
+		uint64 LastReportFrame;
+		uint64 FrameNumber;
+
+		uint32 OutputWidth;
+		uint32 OutputHeight;
+
+		uint32 RenderWidth;
+		uint32 RenderHeight;
+
+	};
+
+}
@@ -91,7 +91,6 @@ namespace EngineCore
 		EnvPreFilterPass* PreFilterPass;
 
 		ShaderRef PreFilterShader;
-		FrameBufferRef PreFilterFrameBuffer;
 
 		TextureCubeRef PreFilterCube;
 
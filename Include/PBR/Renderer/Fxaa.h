@@ -5,6 +5,7 @@
 #include "PBR/RHI/FrameBuffer.h"
 
 #include "PBR/RenderCore/RenderStage.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
 #include "PBR/RenderCore/RenderPass.h"
 
 
@@ -60,18 +61,19 @@ namespace EngineCore
 		virtual ~FxaaStage();
 
 		void Init();
-		void Execute(const Texture2DRef& source);
+		void Execute(const Texture2DRef& source, const Texture2DRef& target);
+
+		virtual void Resize(const uint32 width, const uint32 height) final override;
 
-		inline const Texture2DRef& GetTargetTexture() const { return FxaaTarget; }
+		inline const RenderTargetDesc& GetTargetDesc() const { return TargetDesc; }
 
 	private:
 
 		FxaaPass* FxaaPass;
 
 		ShaderRef FxaaShader;
-		FrameBufferRef FxaaFrameBuffer;
 
-		Texture2DRef FxaaTarget;
+		RenderTargetDesc TargetDesc;
 
 	};
 
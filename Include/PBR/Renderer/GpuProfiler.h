@@ -0,0 +1,189 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <vector>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/RHI/GpuQuery.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuScopeTiming //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct GpuScopeTiming
+	{
+
+		const char* Name;
+		uint32 Depth;
+
+		double Milliseconds;
+
+		// Statistics are only collected for scopes that are not nested in another measured scope.
+		bool bHasStatistics;
+		PipelineStatistics Statistics;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuFrameReport //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct GpuFrameReport
+	{
+
+		uint64 FrameNumber = 0;
+		double Milliseconds = 0.0;
+
+		// In the order the scopes were opened.
+		std::vector<GpuScopeTiming> Scopes;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuProfiler /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Measures named scopes on the GPU with timestamp queries. Every frame uses its own set of
+	// queries, which are read back FrameLatency frames later when the GPU is done with them, so
+	// measuring never stalls the pipeline. A frame whose results are still not available when its
+	// queries are needed again is dropped.
+	//
+	// Scopes and frames are opened on the render thread, reports can be read from any thread.
+	class GpuProfiler
+	{
+
+	public:
+
+		static constexpr uint32 FrameLatency = 4;
+		static constexpr uint32 MaxReportCount = 16;
+
+	private:
+
+		static constexpr uint32 InvalidScope = 0xFFFFFFFF;
+
+		struct ScopeQueries
+		{
+
+			const char* Name;
+			uint32 Depth;
+
+			GpuTimestampQueryRef Begin;
+			GpuTimestampQueryRef End;
+
+			GpuStatisticsQueryRef Statistics;
+			bool bHasStatistics;
+
+		};
+
+		struct QueryFrame
+		{
+
+			uint64 FrameNumber = 0;
+			bool bIsPending = false;
+
+			GpuTimestampQueryRef Begin;
+			GpuTimestampQueryRef End;
+
+			// Entries past ScopeCount keep their queries for later frames.
+			std::vector<ScopeQueries> Scopes;
+			uint32 ScopeCount = 0;
+
+		};
+
+	public:
+
+		GpuProfiler();
+		~GpuProfiler();
+
+		GpuProfiler(const GpuProfiler&) = delete;
+		GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+		void BeginFrame();
+		void EndFrame();
+
+		// Scopes also open a render pass, so they are visible in frame debuggers even when the
+		// profiler is disabled. The name has to stay valid until the report was read.
+		void BeginScope(const char* name);
+		void EndScope();
+
+		// Returns false if no frame was resolved yet.
+		bool GetLastFrameReport(GpuFrameReport& report) const;
+
+		// Moves all reports resolved since the last call into reports, at most MaxReportCount.
+		void TakeFrameReports(std::vector<GpuFrameReport>& reports);
+
+		inline void SetEnabled(const bool value) { bIsEnabled = value; }
+		inline bool IsEnabled() const { return bIsEnabled; }
+
+		inline void SetPipelineStatisticsEnabled(const bool value) { bIsPipelineStatisticsEnabled = value; }
+		inline bool IsPipelineStatisticsEnabled() const { return bIsPipelineStatisticsEnabled; }
+
+		inline uint64 GetDroppedFrameCount() const { return DroppedFrames; }
+
+		// Frame opened by the next or current BeginFrame(), render thread only.
+		inline uint64 GetFrameNumber() const { return FrameNumber; }
+
+	private:
+
+		void ResolveFrames();
+		bool IsFrameAvailable(QueryFrame& frame) const;
+		void ResolveFrame(QueryFrame& frame);
+
+	private:
+
+		QueryFrame Frames[FrameLatency];
+		uint64 FrameNumber;
+		QueryFrame* ActiveFrame;
+
+		std::vector<uint32> ScopeStack;
+		bool bIsStatisticsActive;
+		bool bIsStatisticsSupported;
+
+		bool bIsEnabled;
+		bool bIsPipelineStatisticsEnabled;
+
+		uint64 DroppedFrames;
+
+		mutable std::mutex Mutex;
+		std::deque<GpuFrameReport> Reports;
+		GpuFrameReport LastReport;
+		bool bHasLastReport;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuProfileScope /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class GpuProfileScope
+	{
+
+	public:
+
+		GpuProfileScope(GpuProfiler& profiler, const char* name)
+			: Profiler(profiler)
+		{
+			Profiler.BeginScope(name);
+		}
+
+		~GpuProfileScope()
+		{
+			Profiler.EndScope();
+		}
+
+		GpuProfileScope(const GpuProfileScope&) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+	private:
+
+		GpuProfiler& Profiler;
+
+	};
+
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/RHI/Buffer.h"
+#include "PBR/Engine/Material.h"
+#include "PBR/RenderCore/RenderPrimitive.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuObjectStruct /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct GpuObjectStruct
+	{
+
+		alignas(16) glm::fmat4	ModelMatrix;
+
+		// Index into the material table, -1 marks a free slot.
+		alignas(16) int32		MaterialIndex;
+
+	};
+
+	static_assert(sizeof(GpuObjectStruct) == 80, "Wrong Storage Buffer size: GpuObjectStruct!");
+	static_assert(offsetof(GpuObjectStruct, ModelMatrix) == 0, "Wrong Storage Buffer offset: GpuObjectStruct.ModelMatrix!");
+	static_assert(offsetof(GpuObjectStruct, MaterialIndex) == 64, "Wrong Storage Buffer offset: GpuObjectStruct.MaterialIndex!");
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuMaterialStruct ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Same layout as the material uniform block, std430 only pads the array stride to the vec3 alignment.
+	struct alignas(16) GpuMaterialStruct
+	{
+
+		MaterialUniformStruct Material;
+
+	};
+
+	static_assert(sizeof(GpuMaterialStruct) == 112, "Wrong Storage Buffer size: GpuMaterialStruct!");
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuSceneUpdate //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Recorded on the game thread, applied on the render thread before the frame is drawn.
+	// An update without a material removes the object.
+	struct GpuSceneUpdate
+	{
+
+		PrimitiveHandle Handle;
+
+		glm::fmat4 ModelMatrix;
+		MaterialRef Material;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuScene ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// GPU resident object and material tables. Registered primitives own a persistent object slot,
+	// its entry is only uploaded again when the primitive or its material changed. Primitives that
+	// are not registered get a transient slot behind the persistent ones for the current frame.
+	//
+	// Handles are allocated on the game thread, everything else runs on the render thread.
+	class GpuScene
+	{
+
+	public:
+
+		static constexpr uint32 MinObjectCapacity = 1024;
+		static constexpr uint32 MinMaterialCapacity = 64;
+
+	private:
+
+		struct MaterialEntry
+		{
+
+			MaterialRef Material;
+			uint32 Revision;
+
+			// Persistent objects referencing the material.
+			uint32 ObjectCount;
+			uint64 LastUsedFrame;
+
+		};
+
+	public:
+
+		GpuScene();
+		~GpuScene();
+
+		GpuScene(const GpuScene&) = delete;
+		GpuScene& operator=(const GpuScene&) = delete;
+
+		PrimitiveHandle AllocateHandle();
+		void FreeHandle(const PrimitiveHandle handle);
+
+		// Drops the transient objects of the last frame and releases materials nobody uses anymore.
+		void BeginFrame();
+		void ApplyUpdates(const std::vector<GpuSceneUpdate>& updates);
+
+		// Returns the index of the first of count transient objects. Filling distinct objects through
+		// SetTransientObject is safe from several threads.
+		uint32 AllocateTransientObjects(const uint32 count);
+		void SetTransientObject(const uint32 objectIndex, const glm::fmat4& modelMatrix, const int32 materialIndex);
+
+		int32 UseMaterial(const MaterialRef& material);
+
+		// Uploads dirty entries and all transient objects, (re)creating the buffers if they are too small.
+		void Upload();
+
+		bool IsResident(const PrimitiveHandle handle) const;
+
+		inline const StorageBufferRef& GetObjectBuffer() const { return ObjectBuffer; }
+		inline const StorageBufferRef& GetMaterialBuffer() const { return MaterialBuffer; }
+
+		inline uint32 GetObjectCapacity() const { return static_cast<uint32>(Objects.size()); }
+		inline uint64 GetUploadedBytes() const { return UploadedBytes; }
+
+	private:
+
+		void SetObject(const PrimitiveHandle handle, const glm::fmat4& modelMatrix, const MaterialRef& material);
+		void RemoveObject(const PrimitiveHandle handle);
+
+		int32 AcquireMaterial(const MaterialRef& material);
+		void ReleaseMaterial(const int32 materialIndex);
+
+		void UploadDirtyRanges(const StorageBufferRef& buffer, const void* data, const uint32 stride, std::vector<uint32>& dirty, std::vector<bool>& dirtyFlags);
+
+	private:
+
+		// Game thread
+		std::vector<PrimitiveHandle> FreeHandles;
+		PrimitiveHandle NextHandle;
+
+		// Render thread
+		std::vector<GpuObjectStruct> Objects;
+		std::vector<uint32> DirtyObjects;
+		std::vector<bool> DirtyObjectFlags;
+
+		std::vector<GpuObjectStruct> TransientObjects;
+
+		std::vector<MaterialEntry> Materials;
+		std::vector<GpuMaterialStruct> MaterialData;
+		std::vector<uint32> DirtyMaterials;
+		std::vector<bool> DirtyMaterialFlags;
+		std::vector<int32> FreeMaterials;
+		std::unordered_map<const Material*, int32> MaterialIndices;
+
+		StorageBufferRef ObjectBuffer;
+		StorageBufferRef MaterialBuffer;
+
+		uint64 FrameNumber;
+		uint64 UploadedBytes;
+
+	};
+
+}
@@ -38,11 +38,16 @@ namespace EngineCore
 		void Init();
 		void Execute(const Texture2DRef& texture);
 
+		inline void SetOutputSize(const uint32 width, const uint32 height) { OutputWidth = width; OutputHeight = height; }
+
 	private:
 
 		UniformBufferRef UniformBuffer;
 		QuadPassUniformStruct Uniforms;
 
+		uint32 OutputWidth;
+		uint32 OutputHeight;
+
 	};
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -58,8 +63,14 @@ namespace EngineCore
 		virtual ~QuadStage();
 
 		void Init();
+
+		// Stretches the texture over the whole output, lower render resolutions are upscaled
+		// by the bilinear filter of the texture.
 		void Execute(const Texture2DRef& texture);
 
+		// Size of the back buffer, not of the render targets.
+		virtual void Resize(const uint32 width, const uint32 height) final override;
+
 	private:
 
 		QuadPass* QuadPass;
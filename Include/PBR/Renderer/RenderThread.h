@@ -0,0 +1,78 @@
+#pragma once
+
+#include <queue>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+#include "PBR/Core/BaseTypes.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderThread ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Executes render tasks in submission order on a dedicated thread. Every task gets a fence value
+	// which can be waited on. The queue is bounded, Enqueue() blocks while it is full.
+	class RenderThread
+	{
+
+	public:
+
+		using Task = std::function<void()>;
+
+	public:
+
+		RenderThread(const uint32 maxQueuedTasks = 2);
+		~RenderThread();
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		// onStart runs first on the new thread (e.g. to make the graphics context current),
+		// onStop runs last before the thread exits.
+		void Start(const Task& onStart = nullptr, const Task& onStop = nullptr);
+		void Stop();
+
+		uint64 Enqueue(Task task);
+
+		void Wait(const uint64 fence);
+		void Flush();
+
+		bool IsRenderThread() const;
+
+		inline bool IsRunning() const { return bIsRunning; }
+
+		uint64 GetCompletedFence() const;
+
+	private:
+
+		void Run(const Task onStart, const Task onStop);
+
+	private:
+
+		std::thread Thread;
+		std::atomic<std::thread::id> ThreadId;
+
+		mutable std::mutex Mutex;
+		std::condition_variable TaskAvailable;
+		std::condition_variable TaskCompleted;
+
+		std::queue<std::pair<uint64, Task>> Tasks;
+		uint32 MaxQueuedTasks;
+
+		uint64 SubmittedFence;
+		uint64 CompletedFence;
+
+		bool bIsRunning;
+		bool bStopRequested;
+
+	};
+
+}
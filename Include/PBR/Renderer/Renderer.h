@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 
 #include "glm/glm.hpp"
 
@@ -9,8 +10,25 @@
 #include "PBR/Engine/Light.h"
 #include "PBR/Engine/Sun.h"
 
+#include "PBR/Core/ThreadPool.h"
+#include "PBR/Core/Profiler.h"
+
 #include "PBR/RHI/CommandList.h"
+#include "PBR/RHI/UniformRingBuffer.h"
+#include "PBR/RHI/TextureStagingBuffer.h"
+#include "PBR/RHI/DeferredReleaseQueue.h"
 #include "PBR/RenderCore/RenderQueue.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
+#include "PBR/RenderCore/RenderGraph.h"
+#include "PBR/RenderCore/GeometryPool.h"
+
+#include "PBR/Renderer/RenderThread.h"
+#include "PBR/Renderer/GpuScene.h"
+#include "PBR/Renderer/GpuProfiler.h"
+#include "PBR/Renderer/DynamicResolution.h"
+#include "PBR/Renderer/TextureResidency.h"
+#include "PBR/Renderer/TextureStreaming.h"
+#include "PBR/Renderer/TextureLoader.h"
 
 #include "PBR/Renderer/ShadowPass.h"
 #include "PBR/Renderer/ScenePass.h"
@@ -30,13 +48,76 @@
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// FrameData ///////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Everything the render thread needs to draw one frame. The game thread fills one FrameData
+	// while the render thread consumes the other one.
+	struct FrameData
+	{
+
+		RenderQueue Queue;
+		std::vector<InstancedPrimitive> InstancedPrimitives;
+
+		std::vector<GpuSceneUpdate> SceneUpdates;
+
+		std::vector<LightRef> Lights;
+		CameraRef Camera;
+		SunRef Sun;
+		TextureCubeRef Skybox;
+
+		// Set with SetOutputSize() when the frame was submitted.
+		uint32 OutputWidth;
+		uint32 OutputHeight;
+
+		uint64 Fence;
+
+
+		FrameData()
+			: Queue()
+			, InstancedPrimitives()
+			, SceneUpdates()
+			, Lights()
+			, Camera()
+			, Sun()
+			, Skybox()
+			, OutputWidth(0)
+			, OutputHeight(0)
+			, Fence(0)
+		{
+		}
+
+		void Clear()
+		{
+			Queue.Clear();
+			InstancedPrimitives.clear();
+			SceneUpdates.clear();
+
+			Lights.clear();
+			Camera = nullptr;
+			Sun = nullptr;
+			Skybox = nullptr;
+		}
+
+	};
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Renderer ////////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	// In render thread mode all GL work happens on the render thread. GPU resources have to be
+	// created before StartRenderThread() or inside a task passed to EnqueueRenderCommand().
+
 	class Renderer
 	{
 
+	public:
+
+		// Adds passes to the render graph of every frame before the final quad pass. Post processing
+		// effects read "SceneColor" and create a new "SceneColor" texture.
+		using RenderGraphExtension = std::function<void(RenderGraph& graph, const RenderView& view)>;
+
 	public:
 
 		Renderer();
@@ -49,12 +130,23 @@ namespace EngineCore
 		void DrawMesh(const MeshRef& mesh);
 		void DrawInstancedMesh(const InstancedMeshRef& mesh);
 
+		void DrawMesh(RHICommandList& commandList, const MeshRef& mesh) const;
+		void DrawInstancedMesh(RHICommandList& commandList, const InstancedMeshRef& mesh) const;
+
 		void Submit(const RenderPrimitive& primitive);
 		void Submit(const InstancedPrimitive& primitive);
+
+		// Registered primitives keep their transform and material in the GPU scene, indirect draws
+		// only upload them again after UpdatePrimitive(). They still have to be submitted every frame.
+		void RegisterPrimitive(RenderPrimitive& primitive);
+		void UpdatePrimitive(const RenderPrimitive& primitive);
+		void UnregisterPrimitive(RenderPrimitive& primitive);
 		void AddLight(const LightRef& light);
 		void SetSun(const SunRef& sun);
 
 		void DrawScene();
+
+		// Tone maps the HDR texture and presents it on the default frame buffer like DrawScene().
 		void DrawTexture(const Texture2DRef& texture);
 
 		void PreComputeIndirectLighting(const TextureCubeRef& environmentMap);
@@ -62,6 +154,14 @@ namespace EngineCore
 
 		void Clear();
 
+		void StartRenderThread(const RenderThread::Task& onStart = nullptr, const RenderThread::Task& onStop = nullptr);
+		void StopRenderThread();
+
+		void EnqueueRenderCommand(const RenderThread::Task& task);
+		void FlushRenderThread();
+
+		inline bool IsRenderThreadEnabled() const { return RenderingThread != nullptr; }
+
 		inline void SetCamera(const CameraRef& camera) { Camera = camera; }
 		inline void SetSkybox(const TextureCubeRef& skybox) { Skybox = skybox; }
 
@@ -71,8 +171,53 @@ namespace EngineCore
 		inline void SetToneMappingEnabled(const bool value) { bIsToneMappingEnabled = value; }
 		inline void SetFxaaEnabled(const bool value) { bIsFxaaEnabled = value; }
 
+		// Has to be called before the render thread is started.
+		void AddRenderGraphExtension(const RenderGraphExtension& extension);
+
+		// Size of the back buffer. The scene and post processing are rendered at the render
+		// resolution and upscaled by the final quad pass. Game thread, applied from the next DrawScene().
+		inline void SetOutputSize(const uint32 width, const uint32 height) { OutputWidth = width; OutputHeight = height; }
+
+		// Adjusts the render resolution from the measured GPU frame times, see DynamicResolution.
+		// Needs an enabled GPU profiler.
+		inline void SetDynamicResolutionEnabled(const bool value) { bIsDynamicResolutionEnabled = value; }
+		inline bool IsDynamicResolutionEnabled() const { return bIsDynamicResolutionEnabled; }
+
+		inline uint32 GetRenderWidth() const { return RenderWidth; }
+		inline uint32 GetRenderHeight() const { return RenderHeight; }
+
+		// Scene primitives are submitted as one multi draw indirect per vertex array. Suballocated
+		// meshes of the same format share a vertex array.
+		inline void SetIndirectDrawingEnabled(const bool value) { bIsIndirectDrawingEnabled = value; }
+		inline bool IsIndirectDrawingEnabled() const { return bIsIndirectDrawingEnabled; }
+
 
 		inline RHICommandListImmediate& GetCommandList() { return CommandList; }
+		inline ThreadPool& GetThreadPool() { return *WorkerPool; }
+
+		// Decodes of the texture streaming and loader. Kept apart from the worker pool, so frames
+		// recorded with ParallelFor never wait behind them.
+		inline ThreadPool& GetDecodePool() { return *DecodePool; }
+
+		inline UniformRingBuffer& GetUniformRingBuffer() { return *UniformRing; }
+		inline GpuScene& GetGpuScene() { return *GpuScene; }
+		inline GeometryPool& GetGeometryPool() { return *Geometry; }
+		inline RenderTargetPool& GetRenderTargetPool() { return *RenderTargets; }
+		inline const RenderGraph& GetRenderGraph() const { return *Graph; }
+		inline DynamicResolution& GetDynamicResolution() { return Resolution; }
+
+		// Material textures unused for a while are made non-resident once the budget is exceeded.
+		inline TextureResidency& GetTextureResidency() { return Residency; }
+
+		// Streams the mips of textures loaded through TextureLibrary::Load2D() by their size on screen.
+		inline TextureStreaming& GetTextureStreaming() { return *Streaming; }
+
+		// Finishes the loads of TextureLibrary::Load2DAsync() and Load2DHdrAsync().
+		inline TextureLoader& GetTextureLoader() { return *Loader; }
+		inline TextureStagingBuffer& GetTextureStagingBuffer() { return *Staging; }
+
+		// Every stage of DrawScene() and the indirect lighting precomputation is measured as a named scope.
+		inline GpuProfiler& GetGpuProfiler() { return *GpuProfiler; }
 
 		inline ShadowStage* GetShadowStage() { return ShadowStage; }
 		inline SceneStage* GetSceneStage() { return SceneStage; }
@@ -86,7 +231,12 @@ namespace EngineCore
 
 	private:
 
-		RenderView CreateRenderView(const RenderQueue& queue);
+		void RenderFrame(FrameData& frame);
+		void BuildRenderGraph(const FrameData& frame, const RenderView& renderView);
+		void UpdateRenderResolution(const FrameData& frame);
+		void CaptureSceneState(FrameData& frame) const;
+
+		RenderView CreateRenderView(FrameData& frame);
 
 		MeshRef CreateQuadMesh() const;
 		MeshRef CreateCubeMesh() const;
@@ -96,16 +246,62 @@ namespace EngineCore
 
 		static RenderApi GetApi() { return RHIContext::GetContext().GetApi(); }
 
+		// Low priority threads of the decode pool, few enough to leave the workers their cores.
+		static constexpr uint32 DecodeThreadCount = 2;
+
 	private:
 
 		static Renderer* Instance;
 
 		RHICommandListImmediate CommandList;
+		ThreadPool* WorkerPool;
+		ThreadPool* DecodePool;
 
-		RenderQueue Queue;
-		std::vector<LightRef> Lights;
-		std::vector<InstancedPrimitive> InstancedPrimitives;
+		// Per draw uniform blocks, only valid between Init() and destruction.
+		UniformRingBuffer* UniformRing;
+
+		// Texture uploads of the streaming and the loader, same lifetime as the uniform ring.
+		TextureStagingBuffer* Staging;
+
+		// Textures replaced while frames in flight may still read them, same lifetime as the uniform ring.
+		DeferredReleaseQueue* ReleaseQueue;
+
+		GpuScene* GpuScene;
+		GpuProfiler* GpuProfiler;
+
+		// Shared vertex and index buffers of static meshes.
+		GeometryPool* Geometry;
+
+		// Transient targets of the post processing chain, render thread only.
+		RenderTargetPool* RenderTargets;
+
+		// Built from the enabled stages every frame.
+		RenderGraph* Graph;
+		std::vector<RenderGraphExtension> GraphExtensions;
 
+		// Render thread only.
+		DynamicResolution Resolution;
+		GpuFrameReport LastGpuReport;
+		TextureResidency Residency;
+		TextureStreaming* Streaming;
+		TextureLoader* Loader;
+
+		// Game thread, passed to the render thread with the frame data.
+		uint32 OutputWidth;
+		uint32 OutputHeight;
+
+		uint32 AppliedOutputWidth;
+		uint32 AppliedOutputHeight;
+
+		uint32 RenderWidth;
+		uint32 RenderHeight;
+
+		FrameData Frames[2];
+		uint32 GameFrame;
+
+		RenderThread* RenderingThread;
+
+		std::vector<LightRef> Lights;
 		SunRef Sun;
 
 		ShadowStage* ShadowStage;
@@ -133,6 +329,8 @@ namespace EngineCore
 		bool bIsBloomEnabled;
 		bool bIsToneMappingEnabled;
 		bool bIsFxaaEnabled;
+		bool bIsIndirectDrawingEnabled;
+		bool bIsDynamicResolutionEnabled;
 
 	};
 
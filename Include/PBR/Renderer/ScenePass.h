@@ -1,6 +1,11 @@
 #pragma once
 
+#include <vector>
+
+#include "PBR/RHI/CommandList.h"
+
 #include "PBR/RenderCore/RenderStage.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
 #include "PBR/RenderCore/RenderPass.h"
 #include "PBR/RenderCore/RenderView.h"
 
@@ -27,6 +32,7 @@ namespace EngineCore
 
 		alignas(16) glm::fmat4	ModelMatrix;
 		alignas(16) float		UseInstancing;
+		alignas(4)	float		UseIndirect;
 
 	};
 
@@ -36,6 +42,23 @@ namespace EngineCore
 	static_assert(offsetof(SceneUniformStruct, ProjectionMatrix) == 80, "Wrong Uniform Buffer offset: SceneUniformStruct.ProjectionMatrix!");
 	static_assert(offsetof(SceneUniformStruct, ModelMatrix) == 144, "Wrong Uniform Buffer offset: SceneUniformStruct.ModelMatrix!");
 	static_assert(offsetof(SceneUniformStruct, UseInstancing) == 208, "Wrong Uniform Buffer offset: SceneUniformStruct.UseInstancing!");
+	static_assert(offsetof(SceneUniformStruct, UseIndirect) == 212, "Wrong Uniform Buffer offset: SceneUniformStruct.UseIndirect!");
+
+	// Per draw data of the indirect path, the shader finds its entry through the draw's base instance.
+	struct DrawDataStruct
+	{
+
+		// Index into the object table of the GPU scene.
+		alignas(16) int32		ObjectIndex;
+
+		// Indices into the view light table, -1 marks an unused slot.
+		alignas(16) int32		LightIndices[4];
+
+	};
+
+	static_assert(sizeof(DrawDataStruct) == 32, "Wrong Storage Buffer size: DrawDataStruct!");
+	static_assert(offsetof(DrawDataStruct, ObjectIndex) == 0, "Wrong Storage Buffer offset: DrawDataStruct.ObjectIndex!");
+	static_assert(offsetof(DrawDataStruct, LightIndices) == 16, "Wrong Storage Buffer offset: DrawDataStruct.LightIndices!");
 
 	struct ImageUniformStruct
 	{
@@ -77,6 +100,16 @@ namespace EngineCore
 	class ScenePass : public RenderPass
 	{
 
+	public:
+
+		static constexpr uint32 MaxLightCount = 4;
+
+		// Primitives are only split across worker threads in chunks of at least this size.
+		static constexpr uint32 MinPrimitivesPerChunk = 128;
+
+		// Initial size of the indirect draw buffers, they grow in powers of two.
+		static constexpr uint32 MinIndirectDrawCapacity = 1024;
+
 	public:
 
 		ScenePass(Renderer* renderer);
@@ -87,20 +120,62 @@ namespace EngineCore
 
 	private:
 
-		void SetSceneUniforms(const RenderView& view, const Transform& model, const bool instanced);
-		void SetLightUniforms(const RenderView& view, const glm::vec3& point);
-		void SetMaterialUniforms(const MaterialRef& material);
+		// Materials come from the material table, so only the vertex array splits batches.
+		struct IndirectBatch
+		{
+
+			VertexArrayRef VertexArray;
+
+			uint32 FirstDraw;
+			uint32 DrawCount;
+
+		};
+
+	private:
+
+		void RecordPrimitives(RHICommandList& commandList, const RenderView& view, const uint32 begin, const uint32 end) const;
+		void RecordIndirectPrimitives(RHICommandList& commandList, const RenderView& view);
+		void RecordInstancedPrimitives(RHICommandList& commandList, const RenderView& view) const;
+
+		void BuildIndirectBatches(const RenderView& view);
+		void ReserveIndirectBuffers(const uint32 drawCount, const uint32 lightCount);
+
+		void SetViewLights(const RenderView& view);
+		uint32 GetLightIndices(const RenderView& view, const glm::vec3& point, int32 (&indices)[MaxLightCount]) const;
+
+		void SetCameraUniforms(const RenderView& view);
+		void SetSceneUniforms(RHICommandList& commandList, SceneUniformStruct& uniforms, const Transform& model, const bool instanced) const;
+		void SetLightUniforms(RHICommandList& commandList, const RenderView& view, const glm::vec3& point) const;
+		void SetMaterialUniforms(RHICommandList& commandList, const MaterialRef& material) const;
 		void SetImageUniforms(const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture);
 		void SetShadowUniforms(const Texture2DRef& shadowMap, const SunRef& sun);
 
 	private:
 
+		// One list per chunk, replayed in chunk order so the submission order never changes.
+		std::vector<RHICommandList*> CommandLists;
+
 		UniformBufferRef SceneBuffer;
 		UniformBufferRef LightBuffer;
 		UniformBufferRef MaterialBuffer;
 		UniformBufferRef ImageBuffer;
 		UniformBufferRef ShadowBuffer;
 
+		StorageBufferRef DrawDataBuffer;
+		StorageBufferRef ViewLightBuffer;
+		IndirectBufferRef DrawCommandBuffer;
+
+		// Sun first, then the view lights in order. Rebuilt every frame.
+		std::vector<LightUniformStruct> ViewLights;
+
+		std::vector<uint32> DrawOrder;
+		std::vector<DrawDataStruct> DrawData;
+
+		// Material table index of draws using a transient object, -1 for registered primitives.
+		std::vector<int32> DrawMaterials;
+		std::vector<DrawIndexedIndirectCommand> DrawCommands;
+		std::vector<IndirectBatch> IndirectBatches;
+
 		SceneUniformStruct SceneUniforms;
 		ImageUniformStruct ImageUniforms;
 		ShadowUniformStruct ShadowUniforms;
@@ -120,22 +195,21 @@ namespace EngineCore
 		virtual ~SceneStage();
 
 		void Init();
-		void Execute(const RenderView& view, const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture, const Texture2DRef& shadowMap);
 
-		inline const Texture2DRef& GetSceneTexture() const { return TargetTexture; }
+		// The frame buffer provides the scene depth, the skybox stage draws into it afterwards.
+		void Execute(const RenderView& view, const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture, const Texture2DRef& shadowMap, const FrameBufferRef& frameBuffer, const Texture2DRef& target);
+
+		virtual void Resize(const uint32 width, const uint32 height) final override;
+
+		inline const RenderTargetDesc& GetTargetDesc() const { return TargetDesc; }
 
 	private:
 
 		ScenePass* ScenePass;
 
 		ShaderRef CommonShader;
-		FrameBufferRef CommonFrameBuffer;
-
-		Texture2DRef TargetTexture;
-
-	private:
 
-		friend class SkyboxStage;
+		RenderTargetDesc TargetDesc;
 
 	};
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "PBR/RHI/Buffer.h"
+#include "PBR/RHI/CommandList.h"
 #include "PBR/RenderCore/RenderStage.h"
 #include "PBR/RenderCore/RenderPass.h"
 #include "PBR/RenderCore/RenderView.h"
@@ -42,6 +44,11 @@ namespace EngineCore
 	class ShadowPass : public RenderPass
 	{
 
+	public:
+
+		// Primitives are only split across worker threads in chunks of at least this size.
+		static constexpr uint32 MinPrimitivesPerChunk = 256;
+
 	public:
 
 		ShadowPass(Renderer* renderer);
@@ -52,6 +59,13 @@ namespace EngineCore
 
 	private:
 
+		void RecordPrimitives(RHICommandList& commandList, const RenderView& view, const uint32 begin, const uint32 end) const;
+		void RecordInstancedPrimitives(RHICommandList& commandList, const RenderView& view) const;
+
+	private:
+
+		std::vector<RHICommandList*> CommandLists;
+
 		UniformBufferRef UniformBuffer;
 		ShadowPassUniformStruct Uniforms;
 
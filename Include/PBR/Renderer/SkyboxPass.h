@@ -57,19 +57,16 @@ namespace EngineCore
 		SkyboxStage(Renderer* renderer);
 		virtual ~SkyboxStage();
 
-		void Init(const SceneStage* sceneStage);
-		void Execute(const CameraRef& camera, const TextureCubeRef& skybox);
+		void Init();
 
-		inline const Texture2DRef& GetTargetTexture() const { return TargetTexture; }
+		// Draws into the frame buffer and target of the scene stage, tested against the scene depth.
+		void Execute(const CameraRef& camera, const TextureCubeRef& skybox, const FrameBufferRef& frameBuffer, const Texture2DRef& target);
 
 	private:
 
 		SkyboxPass* SkyboxPass;
 
 		ShaderRef SkyboxShader;
-		FrameBufferRef SkyboxFrameBuffer;
-
-		Texture2DRef TargetTexture;
 
 	};
 
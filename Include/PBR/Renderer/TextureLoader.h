@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/ThreadPool.h"
+
+#include "PBR/RHI/Texture.h"
+#include "PBR/RHI/TextureStagingBuffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureLoader ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Loads 2D textures without blocking the caller on the decode. The texture is created right away
+	// and filled with a placeholder color, the file is decoded on the decode pool and level 0 is
+	// uploaded through the staging buffer by a later Update(), mip maps are generated on the GPU.
+	// The shader handle stays the same, materials can use the texture from the start.
+	//
+	// Load() creates GPU resources, it has the thread requirements of Texture2D::Create(). Update()
+	// runs on the render thread.
+	class TextureLoader
+	{
+
+	private:
+
+		struct PendingTexture
+		{
+
+			Texture2DRef Texture;
+
+			// Compressed textures get all levels from the CPU.
+			bool bGenerateMipMaps;
+
+		};
+
+		// Decoded on the thread pool, tightly packed RGB like TextureLibrary::Load2D() or encoded.
+		struct DecodeResult
+		{
+
+			uint32 Id;
+
+			uint32 Width;
+			uint32 Height;
+			TextureFormat InternalFormat;
+
+			// Starting at level 0.
+			uint32 LevelCount;
+			std::vector<std::vector<byte>> Levels;
+
+			bool bSucceeded;
+
+		};
+
+	public:
+
+		// Every load queues a decode, the pool should not be one that frames are recorded on, see
+		// Renderer::GetDecodePool().
+		TextureLoader(ThreadPool& pool);
+		~TextureLoader();
+
+		TextureLoader(const TextureLoader&) = delete;
+		TextureLoader& operator=(const TextureLoader&) = delete;
+
+		// Reads only the image header. Returns nullptr if it cannot be read. HDR files are decoded to
+		// 32 bit floats, the create info has to match the data type. Compressed internal formats are
+		// encoded with TextureEncoder while decoding, HDR files only to Bc6h.
+		Texture2DRef Load(const std::string& file, const TextureCreateInfo& createInfo, const glm::vec4& placeholder, const bool hdr);
+
+		void Update(TextureStagingBuffer& staging);
+
+		// Textures still showing their placeholder.
+		inline uint32 GetPendingCount() const { return static_cast<uint32>(Pending.size()); }
+
+		inline ThreadPool& GetThreadPool() const { return Pool; }
+
+	public:
+
+		static TextureLoader* GetInstance() { return Instance; }
+
+	private:
+
+		static void Decode(const std::string& file, const bool hdr, ThreadPool& pool, DecodeResult& result);
+
+	private:
+
+		static TextureLoader* Instance;
+
+		ThreadPool& Pool;
+
+		uint32 NextId;
+		std::unordered_map<uint32, PendingTexture> Pending;
+
+		// Decoded, waiting for space in the staging buffer.
+		std::vector<DecodeResult*> Deferred;
+
+		std::mutex ResultMutex;
+		std::vector<DecodeResult*> Results;
+		uint32 RunningDecodes;
+
+	};
+
+}
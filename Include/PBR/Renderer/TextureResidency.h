@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "PBR/Core/BaseTypes.h"
+
+#include "PBR/RHI/Texture.h"
+#include "PBR/Engine/Material.h"
+#include "PBR/RenderCore/RenderView.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureResidencyStats ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct TextureResidencyStats
+	{
+
+		uint32 TrackedTextures;
+		uint32 ResidentTextures;
+		uint64 ResidentBytes;
+
+		// Of the last frame.
+		uint32 UsedTextures;
+		uint32 Evictions;
+		uint32 Restores;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureResidency ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Keeps the bindless handles of material textures resident only while they are used. Every frame
+	// the textures of all materials in the render view are made resident and marked as used, then
+	// the least recently used ones are made non-resident until the resident textures fit into the
+	// budget. Textures used in the last MinIdleFrames frames are never evicted, the GPU may still
+	// be reading them, so the budget can be exceeded if a single frame needs more.
+	//
+	// Textures are created non-resident, a loaded texture costs no budget until it is first used.
+	// Textures the renderer samples outside of materials, like the skybox, are passed to MarkUsed().
+	// Handles keep their value while non-resident, material parameters stay valid. Textures only
+	// referenced by the residency manager are dropped. Render thread only.
+	class TextureResidency
+	{
+
+	public:
+
+		static constexpr uint64 DefaultBudget = 1024ull * 1024 * 1024;
+		static constexpr uint32 MinIdleFrames = 3;
+
+	private:
+
+		struct Entry
+		{
+
+			TextureRef Texture;
+			uint64 LastUsedFrame;
+			uint64 Size;
+
+		};
+
+	public:
+
+		TextureResidency();
+		~TextureResidency();
+
+		TextureResidency(const TextureResidency&) = delete;
+		TextureResidency& operator=(const TextureResidency&) = delete;
+
+		void Update(const RenderView& view);
+
+		// Textures outside of materials, made resident for the current frame.
+		void MarkUsed(Texture* texture);
+
+		inline void SetBudget(const uint64 bytes) { Budget = bytes; }
+		inline uint64 GetBudget() const { return Budget; }
+
+		inline bool IsTracked(const Texture* texture) const { return Entries.find(texture) != Entries.end(); }
+
+		inline const TextureResidencyStats& GetStats() const { return Stats; }
+
+	private:
+
+		void MarkMaterialUsed(const MaterialRef& material);
+
+		// Also picks up size changes of streamed textures.
+		void UpdateEntries();
+		void EvictUnused();
+
+	private:
+
+		uint64 Budget;
+		uint64 FrameNumber;
+
+		std::unordered_map<const Texture*, Entry> Entries;
+
+		// Materials already visited this frame, most primitives share a few of them.
+		std::unordered_set<const Material*> VisitedMaterials;
+		std::vector<Entry*> Candidates;
+
+		TextureResidencyStats Stats;
+
+	};
+
+}
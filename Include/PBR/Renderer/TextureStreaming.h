@@ -0,0 +1,203 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+#include "PBR/Core/BaseTypes.h"
+#include "PBR/Core/ThreadPool.h"
+
+#include "PBR/RHI/Texture.h"
+#include "PBR/RHI/TextureStagingBuffer.h"
+#include "PBR/Engine/Material.h"
+#include "PBR/RenderCore/RenderView.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Forward Declarations ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	class TextureResidency;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStreamingStats ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct TextureStreamingStats
+	{
+
+		uint32 StreamedTextures;
+		uint64 StreamedBytes;
+
+		uint32 PendingLoads;
+		uint32 MipBias;
+
+		// Of the last frame.
+		uint32 LoadedMips;
+		uint32 DroppedMips;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStreaming ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Streams the mip levels of 2D textures based on how large they appear on screen. Textures are
+	// loaded with only their mip tail, the levels up to MipTailSize, which always stays resident once
+	// loaded.
+	//
+	// Every frame the projected size of each material in the render view is estimated from the
+	// bounding sphere of its meshes, assuming the textures cover a mesh once. Textures whose
+	// resident mips are too coarse get the missing levels decoded on the decode pool and uploaded
+	// by a later Update(). Textures no longer visible, or showing more detail than needed, drop their
+	// finest levels once the streamed textures exceed the budget. If that is not enough a global
+	// mip bias lowers the demand of all textures until they fit.
+	//
+	// Changing the resident mips changes the shader handle of a texture, the materials using it are
+	// invalidated so the new handle is fetched before anything is drawn. The old handles stay valid
+	// until the frames in flight retired, see DeferredReleaseQueue. Load() and LoadAsync() may be
+	// called from the game thread before the render thread is started, everything else runs on the
+	// render thread.
+	class TextureStreaming
+	{
+
+	public:
+
+		static constexpr uint32 MipTailSize = 64;
+		static constexpr uint64 DefaultBudget = 512ull * 1024 * 1024;
+
+		// Decodes queued on the pool at the same time.
+		static constexpr uint32 MaxPendingLoads = 4;
+		static constexpr uint32 MaxMipBias = 4;
+
+	private:
+
+		struct StreamedTexture
+		{
+
+			std::string File;
+			Texture2DRef Texture;
+			TextureFormat InternalFormat;
+
+			uint32 TailMip;
+
+			// Finest level needed by the view of the current frame, TailMip if not visible.
+			uint32 WantedMip;
+			uint64 LastUsedFrame;
+
+			// Bumped whenever the shader handle changed.
+			uint32 Generation;
+
+			bool bIsLoading;
+
+		};
+
+		// Levels [FirstMip, EndMip) decoded on the thread pool, tightly packed or encoded.
+		struct LoadResult
+		{
+
+			uint32 Texture;
+
+			uint32 Width;
+			uint32 Height;
+			TextureFormat InternalFormat;
+
+			uint32 FirstMip;
+			uint32 EndMip;
+
+			std::vector<std::vector<byte>> Levels;
+			bool bSucceeded;
+
+		};
+
+		struct MaterialState
+		{
+
+			uint32 Generation;
+			uint64 LastSeenFrame;
+
+		};
+
+	public:
+
+		// The pool should not be one that frames are recorded on, see Renderer::GetDecodePool().
+		TextureStreaming(ThreadPool& pool, const TextureResidency& residency);
+		~TextureStreaming();
+
+		TextureStreaming(const TextureStreaming&) = delete;
+		TextureStreaming& operator=(const TextureStreaming&) = delete;
+
+		// Decodes the file on the caller and uploads only the mip tail. Returns nullptr if the file
+		// cannot be read. The create info has to use mip maps and 8 bit RGB data. Levels of compressed
+		// internal formats are encoded on the CPU.
+		Texture2DRef Load(const std::string& file, const TextureCreateInfo& createInfo);
+
+		// Same without decoding on the caller, only the image header is read. The texture starts with
+		// its last level filled with the placeholder color, the tail is streamed in like finer levels.
+		Texture2DRef LoadAsync(const std::string& file, const TextureCreateInfo& createInfo, const glm::vec4& placeholder);
+
+		// viewHeight is the height of the render target in pixels. Loaded levels are uploaded through
+		// the staging buffer, loads not fitting into it this frame are applied by a later Update().
+		void Update(const RenderView& view, const uint32 viewHeight, TextureStagingBuffer& staging);
+
+		inline void SetBudget(const uint64 bytes) { Budget = bytes; }
+		inline uint64 GetBudget() const { return Budget; }
+
+		inline const TextureStreamingStats& GetStats() const { return Stats; }
+
+	public:
+
+		static TextureStreaming* GetInstance() { return Instance; }
+
+	private:
+
+		void ComputeDemand(const RenderView& view, const uint32 viewHeight);
+		void SetWantedMip(const Texture2DRef& map, const float pixels);
+
+		void Register(const std::string& file, const Texture2DRef& texture, const TextureFormat internalFormat, const uint32 tailMip);
+
+		void ApplyLoads(TextureStagingBuffer& staging);
+		void RequestLoads();
+		void DropMips();
+		void InvalidateMaterials();
+
+		void ReleaseUnreferenced();
+
+		static void DecodeMips(const std::string& file, ThreadPool& pool, LoadResult& result);
+
+	private:
+
+		static TextureStreaming* Instance;
+
+		ThreadPool& Pool;
+		const TextureResidency& Residency;
+
+		uint64 Budget;
+		uint64 FrameNumber;
+		uint32 MipBias;
+
+		// Guards Textures, TextureIndices and FreeTextures against Load() and LoadAsync().
+		std::mutex Mutex;
+
+		// Freed entries have no texture and are reused by later loads.
+		std::vector<StreamedTexture> Textures;
+		std::vector<uint32> FreeTextures;
+		std::unordered_map<const Texture*, uint32> TextureIndices;
+
+		// Largest projected size in pixels of each material in the view.
+		std::unordered_map<Material*, float> MaterialDemand;
+		std::unordered_map<const Material*, MaterialState> Materials;
+
+		std::mutex ResultMutex;
+		std::vector<LoadResult*> Results;
+		uint32 PendingLoads;
+
+		TextureStreamingStats Stats;
+
+	};
+
+}
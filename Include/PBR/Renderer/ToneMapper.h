@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PBR/RenderCore/RenderStage.h"
+#include "PBR/RenderCore/RenderTargetPool.h"
 #include "PBR/RenderCore/RenderPass.h"
 
 
@@ -76,18 +77,19 @@ namespace EngineCore
 		virtual ~ToneMapperStage();
 
 		void Init();
-		void Execute(const Texture2DRef& sourceTexture);
+		void Execute(const Texture2DRef& sourceTexture, const Texture2DRef& target);
 
-		inline const Texture2DRef& GetToneMappedTexture() const { return Texture; }
+		virtual void Resize(const uint32 width, const uint32 height) final override;
+
+		inline const RenderTargetDesc& GetTargetDesc() const { return TargetDesc; }
 
 	private:
 
 		ToneMapperPass* ToneMapperPass;
 
 		ShaderRef ToneMapperShader;
-		FrameBufferRef ToneMapperFrameBuffer;
 
-		Texture2DRef Texture;
+		RenderTargetDesc TargetDesc;
 
 	};
 
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "RHI/Shader.h"
+#include "RHI/ShaderCache.h"
 
 
 namespace EngineCore
@@ -24,6 +25,11 @@ namespace EngineCore
 		void Load(const std::string& name, const ShaderSource& source);
 		void Load(const std::string& file);
 
+		// Programs loaded afterwards are restored from binaries in the directory when their sources
+		// and the driver did not change, see ShaderCache. An empty directory disables the cache.
+		void SetCacheDirectory(const std::string& directory);
+		inline ShaderCache* GetCache() const { return Cache; }
+
 	private:
 
 		std::string ReadFile(const std::string& file) const;
@@ -38,6 +44,7 @@ namespace EngineCore
 	private:
 
 		std::unordered_map<std::string, ShaderRef> ShaderMap;
+		ShaderCache* Cache;
 
 	private:
 
@@ -3,6 +3,9 @@
 #include <string>
 #include <unordered_map>
 
+#include <glm/glm.hpp>
+
+#include "PBR/Core/ThreadPool.h"
 #include "PBR/RHI/Texture.h"
 
 
@@ -25,14 +28,35 @@ namespace EngineCore
 
 		bool Exists(const std::string& name);
 
+		// Compressed internal formats are encoded on the CPU, HDR files only to Bc6h, see
+		// TextureEncoder. DDS and KTX2 files are uploaded with their stored levels and formats
+		// instead, the create info only provides filtering, wrapping and whether to use mip maps.
+		// Async loads of them complete right away, there is nothing to decode, and they are not
+		// streamed. See TextureContainer.
+		//
+		// Mip mapped 8 bit textures are streamed while a renderer exists and start gray like async
+		// loads, see TextureStreaming.
 		Texture2DRef Load2D(const std::string& file, const TextureCreateInfo createInfo = TextureCreateInfo());
 		Texture2DRef Load2DHdr(const std::string& file, const TextureCreateInfo createInfo = TextureCreateInfo());
+
+		// Return right away with the texture filled with the placeholder color, the file is decoded on
+		// the thread pool and uploaded by the render thread, see TextureLoader. Normal maps should use
+		// (0.5, 0.5, 1.0, 1.0) as placeholder. Return nullptr if the file cannot be read.
+		Texture2DRef Load2DAsync(const std::string& file, const TextureCreateInfo createInfo = TextureCreateInfo(), const glm::vec4& placeholder = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
+		Texture2DRef Load2DHdrAsync(const std::string& file, const TextureCreateInfo createInfo = TextureCreateInfo(), const glm::vec4& placeholder = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
 		
+		// Splits the encoding of compressed textures loaded by Load2D() over the pool. Defaults to the
+		// decode pool of the renderer, see TextureLoader::GetThreadPool().
+		inline void SetThreadPool(ThreadPool* pool) { Pool = pool; }
+
 		// TODO:
 		//void LoadCube();
 
 	private:
 
+		Texture2DRef Load2DCompressed(const std::string& file, const TextureCreateInfo& createInfo, const bool hdr);
+		Texture2DRef Load2DContainer(const std::string& file, const TextureCreateInfo& createInfo);
+
 		std::string GetFileName(const std::string& file) const;
 
 	private:
@@ -42,6 +66,7 @@ namespace EngineCore
 	private:
 
 		std::unordered_map<std::string, TextureRef> TextureMap;
+		ThreadPool* Pool;
 
 	private:
 		
@@ -2,6 +2,7 @@
 
 #version 450 core
 #extension GL_ARB_bindless_texture : require
+#extension GL_ARB_shader_draw_parameters : require
 
 /////////////////////////////////////////////////////////////
 // In variables /////////////////////////////////////////////
@@ -9,13 +10,20 @@
 
 layout(location = 0) in highp vec3 position;
 layout(location = 1) in highp vec2 uv_coord;
-layout(location = 2) in highp vec3 normal;
-layout(location = 3) in highp vec3 binormal;
-layout(location = 4) in highp vec3 tangent;
-layout(location = 5) in highp mat4 model;
+layout(location = 2) in highp vec4 tangent_frame;
+layout(location = 3) in highp mat4 model;
+//layout(location=4) in highp mat4 model; }
+//layout(location=5) in highp mat4 model; } reserved for model matrix, because maximum input size is vec4, so each column has its own location
 //layout(location=6) in highp mat4 model; }
-//layout(location=7) in highp mat4 model; } reserved for model matrix, because maximum input size is vec4, so each column has its own location
-//layout(location=8) in highp mat4 model; }
+
+/////////////////////////////////////////////////////////////
+// Vertex variables /////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// Decoded from the tangent frame at the start of main()
+highp vec3 normal;
+highp vec3 binormal;
+highp vec3 tangent;
 
 /////////////////////////////////////////////////////////////
 // Vertex shader out variables //////////////////////////////
@@ -37,6 +45,8 @@ out vertex_shader_out
 
 	highp vec4 frag_pos_light_space;
 
+	flat highp int draw_index;
+
 } vs_out;
 
 /////////////////////////////////////////////////////////////
@@ -62,8 +72,49 @@ layout(std140, binding = 0) uniform SceneData
 	// 208
 	highp float use_instancing;
 
+	// 212
+	highp float use_indirect;
+
 } u_scene;
 
+// 32
+struct DrawData
+{
+
+	// 0
+	highp int object_index;
+
+	// 16
+	highp ivec4 light_indices;
+
+};
+
+layout(std430, binding = 0) readonly buffer DrawDataBuffer
+{
+
+	DrawData s_draw_data[];
+
+};
+
+// 80
+struct ObjectData
+{
+
+	// 0
+	highp mat4 model_matrix;
+
+	// 64
+	highp int material_index;
+
+};
+
+layout(std430, binding = 2) readonly buffer ObjectBuffer
+{
+
+	ObjectData s_object[];
+
+};
+
 // 144
 layout(std140, binding = 4) uniform ShadowData
 {
@@ -89,6 +140,21 @@ layout(std140, binding = 4) uniform ShadowData
 // Functions ////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
+/**
+ * Decodes the tangent frame quaternion of the vertex into the normal, binormal and tangent.
+ * The quaternion rotates the x, y and z axis onto the tangent, binormal and normal, a negative
+ * w marks a mirrored binormal.
+ */
+void DecodeTangentFrame(vec4 q)
+{
+	q = normalize(q);
+
+	tangent = vec3(1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y + q.w * q.z), 2.0f * (q.x * q.z - q.w * q.y));
+	normal = vec3(2.0f * (q.x * q.z + q.w * q.y), 2.0f * (q.y * q.z - q.w * q.x), 1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+
+	binormal = cross(normal, tangent) * (q.w < 0.0f ? -1.0f : 1.0f);
+}
+
 /**
  * Calculates the normal matrix using the model matrix.
  *
@@ -141,12 +207,21 @@ mat3 ReOrthogonalizedTbnMatrix(mat3 normal_matrix)
  */
 void main()
 {
+	DecodeTangentFrame(tangent_frame);
 
 	// Determine model matrix
 	mat4 actual_model_matrix = u_scene.model_matrix;
 	if (u_scene.use_instancing > 0.5f)
 		actual_model_matrix = model;
 
+	// Indirect draws find their data through the base instance of the draw command
+	vs_out.draw_index = -1;
+	if (u_scene.use_indirect > 0.5f)
+	{
+		vs_out.draw_index = gl_BaseInstanceARB;
+		actual_model_matrix = s_object[s_draw_data[gl_BaseInstanceARB].object_index].model_matrix;
+	}
+
 	// Calculate vertex position
 	gl_Position = u_scene.projection_matrix * u_scene.view_matrix * actual_model_matrix * vec4(position, 1.0f);
 
@@ -213,6 +288,8 @@ in vertex_shader_out
 
 	highp vec4 frag_pos_light_space;
 
+	flat highp int draw_index;
+
 } vs_out;
 
 /////////////////////////////////////////////////////////////
@@ -248,8 +325,53 @@ layout(std140, binding = 1) uniform Lights
 
 };
 
+// 32
+struct DrawData
+{
+
+	// 0
+	highp int object_index;
+
+	// 16
+	highp ivec4 light_indices;
+
+};
+
+layout(std430, binding = 0) readonly buffer DrawDataBuffer
+{
+
+	DrawData s_draw_data[];
+
+};
+
+// 80
+struct ObjectData
+{
+
+	// 0
+	highp mat4 model_matrix;
+
+	// 64
+	highp int material_index;
+
+};
+
+layout(std430, binding = 2) readonly buffer ObjectBuffer
+{
+
+	ObjectData s_object[];
+
+};
+
+layout(std430, binding = 1) readonly buffer ViewLightBuffer
+{
+
+	Light s_view_light[];
+
+};
+
 // 112
-layout(std140, binding = 2) uniform Material
+struct MaterialData
 {
 
 	// 0
@@ -303,7 +425,24 @@ layout(std140, binding = 2) uniform Material
 	// 96
 	highp sampler2D displacement_map;
 
-} u_material;
+};
+
+layout(std140, binding = 2) uniform Material
+{
+
+	MaterialData u_material;
+
+};
+
+layout(std430, binding = 3) readonly buffer MaterialBuffer
+{
+
+	MaterialData s_material[];
+
+};
+
+// Material of the fragment, either the material block or an entry of the material table.
+MaterialData g_material;
 
 // 32
 layout(std140, binding = 3) uniform ImageData
@@ -358,9 +497,9 @@ layout(std140, binding = 4) uniform ShadowData
 vec3 GetNormal(vec2 uv_coord)
 {
 	vec3 normal = normalize(vs_out.normal);
-	if (u_material.use_normal_map > 0.5f)
+	if (g_material.use_normal_map > 0.5f)
 	{
-		normal = texture(u_material.normal_map, uv_coord).xyz;
+		normal = texture(g_material.normal_map, uv_coord).xyz;
 		normal = normalize(normal * 2.0f - 1.0f);
 		normal = normalize(vs_out.tbn * normal);
 	}
@@ -377,9 +516,9 @@ vec3 GetNormal(vec2 uv_coord)
  */
 vec3 GetMaterialAlbedo(vec2 uv_coord)
 {
-	vec3 albedo = u_material.albedo;
-	if (u_material.use_albedo_map > 0.5f)
-		albedo = texture(u_material.albedo_map, vs_out.uv_coord).rgb;
+	vec3 albedo = g_material.albedo;
+	if (g_material.use_albedo_map > 0.5f)
+		albedo = texture(g_material.albedo_map, vs_out.uv_coord).rgb;
 
 	return albedo;
 }
@@ -393,9 +532,9 @@ vec3 GetMaterialAlbedo(vec2 uv_coord)
  */
 float GetMaterialMetalness(vec2 uv_coord)
 {
-	float metalness = u_material.metalness;
-	if (u_material.use_metalness_map > 0.5f)
-		metalness = texture(u_material.metalness_map, uv_coord).r;
+	float metalness = g_material.metalness;
+	if (g_material.use_metalness_map > 0.5f)
+		metalness = texture(g_material.metalness_map, uv_coord).r;
 
 	return metalness;
 }
@@ -409,9 +548,9 @@ float GetMaterialMetalness(vec2 uv_coord)
  */
 float GetMaterialRoughness(vec2 uv_coord)
 {
-	float roughness = u_material.roughness;
-	if (u_material.use_roughness_map > 0.5f)
-		roughness = texture(u_material.roughness_map, uv_coord).r;
+	float roughness = g_material.roughness;
+	if (g_material.use_roughness_map > 0.5f)
+		roughness = texture(g_material.roughness_map, uv_coord).r;
 
 	return roughness;
 }
@@ -425,9 +564,9 @@ float GetMaterialRoughness(vec2 uv_coord)
  */
 float GetMaterialAO(vec2 uv_coord)
 {
-	float ao = u_material.ao;
-	if (u_material.use_ao_map > 0.5f)
-		ao = texture(u_material.ao_map, uv_coord).r;
+	float ao = g_material.ao;
+	if (g_material.use_ao_map > 0.5f)
+		ao = texture(g_material.ao_map, uv_coord).r;
 
 	return ao;
 }
@@ -529,7 +668,7 @@ float QuadraticAttenuation(vec3 light_position, vec3 world_position)
  */
 vec2 ParallaxOcclusionMapping(vec2 uv_coord, vec3 view_direction)
 {
-	if (u_material.use_displacement_map < 0.5f)
+	if (g_material.use_displacement_map < 0.5f)
 		return uv_coord;
 
 	const float min_layers = 8.0f;
@@ -538,17 +677,17 @@ vec2 ParallaxOcclusionMapping(vec2 uv_coord, vec3 view_direction)
 	float layer_count = mix(min_layers, max_layers, abs(dot(vec3(0.0f, 0.0f, 1.0f), view_direction)));
 	float layer_depth = 1.0f / layer_count;
 
-	vec2 p = view_direction.xy / view_direction.z * u_material.displacement_height_scale;
+	vec2 p = view_direction.xy / view_direction.z * g_material.displacement_height_scale;
 	vec2 delta_tex_coord = p / layer_count;
 
 	float current_layer_depth = 0.0f;
 	vec2 current_uv_coord = uv_coord;
-	float current_displacement_map_value = texture(u_material.displacement_map, current_uv_coord).r;
+	float current_displacement_map_value = texture(g_material.displacement_map, current_uv_coord).r;
 
 	while (current_layer_depth < current_displacement_map_value)
 	{
 		current_uv_coord -= delta_tex_coord;
-		current_displacement_map_value = texture(u_material.displacement_map, current_uv_coord).r;
+		current_displacement_map_value = texture(g_material.displacement_map, current_uv_coord).r;
 
 		current_layer_depth += layer_depth;
 	}
@@ -556,7 +695,7 @@ vec2 ParallaxOcclusionMapping(vec2 uv_coord, vec3 view_direction)
 	vec2 previous_uv_coord = current_uv_coord + delta_tex_coord;
 
 	float after_depth = current_displacement_map_value - current_layer_depth;
-	float before_depth = texture(u_material.displacement_map, previous_uv_coord).r - current_layer_depth + layer_depth;
+	float before_depth = texture(g_material.displacement_map, previous_uv_coord).r - current_layer_depth + layer_depth;
 
 	float weight = after_depth / (after_depth - before_depth);
 	vec2 final_uv_coord = previous_uv_coord * weight + current_uv_coord * (1.0f - weight);
@@ -707,6 +846,26 @@ vec3 AmbientLight(vec3 n, vec3 v, vec3 r, vec3 f0, vec3 albedo, float roughness,
 	return ambient;
 }
 
+/**
+ * Returns the light in the given slot. Indirect draws look it up in the view light table,
+ * all other draws use the light block.
+ *
+ * @param i The light slot.
+ *
+ * @return The light, its type is LIGHT_TYPE_NONE for unused slots.
+ */
+Light GetLight(int i)
+{
+	if (vs_out.draw_index < 0)
+		return u_light[i];
+
+	int light_index = s_draw_data[vs_out.draw_index].light_indices[i];
+	if (light_index < 0)
+		return Light(LIGHT_TYPE_NONE, vec3(0.0f), vec3(0.0f), vec3(0.0f));
+
+	return s_view_light[light_index];
+}
+
 /*
  * Calculates the total lighting.
  *
@@ -729,7 +888,7 @@ vec3 CalculateLighting(vec3 n, vec3 v, vec3 r, vec2 uv_coord)
 	vec3 lo = vec3(0.0f);
 	for (int i = 0; i < MAX_LIGHT_COUNT; ++i)
 	{
-		Light light = u_light[i];
+		Light light = GetLight(i);
 
 		switch (light.type)
 		{
@@ -755,6 +914,11 @@ vec3 CalculateLighting(vec3 n, vec3 v, vec3 r, vec2 uv_coord)
  */
 void main()
 {
+	// Indirect draws read their material from the material table
+	g_material = u_material;
+	if (vs_out.draw_index >= 0)
+		g_material = s_material[s_object[s_draw_data[vs_out.draw_index].object_index].material_index];
+
 	// Calculate view direction
 	vec3 v = normalize(vs_out.camera_pos - vs_out.frag_pos);
 
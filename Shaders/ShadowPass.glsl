@@ -7,10 +7,10 @@
 /////////////////////////////////////////////////////////////
 
 layout(location = 0) in highp vec3 position;
-layout(location = 5) in highp mat4 model;
+layout(location = 3) in highp mat4 model;
+//layout(location=4) in highp mat4 model; }
+//layout(location=5) in highp mat4 model; } Reserved for model matrix
 //layout(location=6) in highp mat4 model; }
-//layout(location=7) in highp mat4 model; } Reserved for model matrix
-//layout(location=8) in highp mat4 model; }
 
 /////////////////////////////////////////////////////////////
 // Uniform variables ////////////////////////////////////////
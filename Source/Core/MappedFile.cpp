@@ -0,0 +1,142 @@
+#include "pch.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "PBR/Core/MappedFile.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// MappedFile //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	MappedFile::MappedFile()
+		: Data(nullptr)
+		, Size(0)
+		, FileHandle(nullptr)
+		, MappingHandle(nullptr)
+	{
+
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+#ifdef _WIN32
+
+	bool MappedFile::Open(const std::string& file)
+	{
+		Close();
+
+		HANDLE fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mappingHandle)
+		{
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		Data = static_cast<const byte*>(data);
+		Size = static_cast<uint64>(size.QuadPart);
+		FileHandle = fileHandle;
+		MappingHandle = mappingHandle;
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (Data)
+			UnmapViewOfFile(Data);
+
+		if (MappingHandle)
+			CloseHandle(MappingHandle);
+
+		if (FileHandle)
+			CloseHandle(FileHandle);
+
+		Data = nullptr;
+		Size = 0;
+		FileHandle = nullptr;
+		MappingHandle = nullptr;
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& file)
+	{
+		Close();
+
+		const int descriptor = open(file.c_str(), O_RDONLY);
+		if (descriptor < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0 || status.st_size <= 0)
+		{
+			close(descriptor);
+			return false;
+		}
+
+		// The mapping keeps its own reference to the file.
+		void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+		close(descriptor);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+		Data = static_cast<const byte*>(data);
+		Size = static_cast<uint64>(status.st_size);
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (Data)
+			munmap(const_cast<byte*>(Data), static_cast<size_t>(Size));
+
+		Data = nullptr;
+		Size = 0;
+	}
+
+#endif
+
+}
@@ -0,0 +1,228 @@
+#include "pch.h"
+
+#include <chrono>
+#include <fstream>
+
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Profiler ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Only written by the owning thread. Buffers are never freed, so events of threads that
+	// already exited can still be exported.
+	struct Profiler::ThreadBuffer
+	{
+
+		struct OpenEvent
+		{
+
+			const char* Name;
+			uint64 Begin;
+
+		};
+
+
+		ThreadBuffer(const uint32 threadId)
+			: ThreadId(threadId)
+			, Name()
+			, Events()
+			, Count(0)
+			, Dropped(0)
+			, Stack()
+			, Depth(0)
+		{
+		}
+
+		const uint32 ThreadId;
+		std::string Name;
+
+		std::unique_ptr<ProfileEvent[]> Events;
+		std::atomic<uint32> Count;
+		std::atomic<uint64> Dropped;
+
+		OpenEvent Stack[MaxDepth];
+		uint32 Depth;
+
+	};
+
+	std::atomic<bool> Profiler::bIsEnabled(false);
+
+	std::mutex Profiler::Mutex;
+	std::vector<Profiler::ThreadBuffer*> Profiler::Buffers;
+
+	void Profiler::SetEnabled(const bool value)
+	{
+		bIsEnabled.store(value, std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(Mutex);
+		buffer.Name = name;
+	}
+
+	void Profiler::BeginEvent(const char* name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		// Scopes deeper than MaxDepth are only counted, so EndEvent stays balanced.
+		if (buffer.Depth < MaxDepth)
+			buffer.Stack[buffer.Depth] = { name, GetTime() };
+
+		++buffer.Depth;
+	}
+
+	void Profiler::EndEvent()
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		assert(buffer.Depth); // "Profiler::EndEvent without BeginEvent."
+		const uint32 depth = --buffer.Depth;
+
+		if (depth >= MaxDepth)
+			return;
+
+		const uint32 count = buffer.Count.load(std::memory_order_relaxed);
+		if (count == MaxEventsPerThread)
+		{
+			buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// Allocated on the first event, threads that only got a name stay cheap.
+		if (!buffer.Events)
+			buffer.Events.reset(new ProfileEvent[MaxEventsPerThread]);
+
+		const ThreadBuffer::OpenEvent& open = buffer.Stack[depth];
+		buffer.Events[count] = { open.Name, open.Begin, GetTime(), depth };
+
+		buffer.Count.store(count + 1, std::memory_order_release);
+	}
+
+	void Profiler::Clear()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		for (ThreadBuffer* buffer : Buffers)
+		{
+			buffer->Count.store(0, std::memory_order_relaxed);
+			buffer->Dropped.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	static void WriteJsonString(std::ostream& stream, const char* value)
+	{
+		stream << '"';
+
+		for (const char* c = value; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				stream << '\\';
+
+			stream << *c;
+		}
+
+		stream << '"';
+	}
+
+	void Profiler::WriteChromeTrace(std::ostream& stream)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool bIsFirst = true;
+		auto separate = [&stream, &bIsFirst]()
+		{
+			if (!bIsFirst)
+				stream << ",\n";
+
+			bIsFirst = false;
+		};
+
+		for (const ThreadBuffer* buffer : Buffers)
+		{
+			if (!buffer->Name.empty())
+			{
+				separate();
+				stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadId << ",\"args\":{\"name\":";
+				WriteJsonString(stream, buffer->Name.c_str());
+				stream << "}}";
+			}
+
+			const uint32 count = buffer->Count.load(std::memory_order_acquire);
+			for (uint32 i = 0; i < count; ++i)
+			{
+				const ProfileEvent& event = buffer->Events[i];
+
+				// Complete events, timestamps are given in microseconds.
+				separate();
+				stream << "{\"name\":";
+				WriteJsonString(stream, event.Name);
+				stream << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->ThreadId
+					<< ",\"ts\":" << static_cast<double>(event.Begin) / 1000.0
+					<< ",\"dur\":" << static_cast<double>(event.End - event.Begin) / 1000.0 << "}";
+			}
+		}
+
+		stream << "]}" << std::endl;
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& path)
+	{
+		std::ofstream file(path);
+		if (!file)
+		{
+			std::cout << "Warning: Could not open profiler trace file " << path << "." << std::endl;
+			return false;
+		}
+
+		file.precision(3);
+		file << std::fixed;
+
+		WriteChromeTrace(file);
+		return true;
+	}
+
+	uint64 Profiler::GetDroppedEventCount()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		uint64 dropped = 0;
+		for (const ThreadBuffer* buffer : Buffers)
+			dropped += buffer->Dropped.load(std::memory_order_relaxed);
+
+		return dropped;
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+	{
+		thread_local ThreadBuffer* buffer = nullptr;
+
+		if (!buffer)
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+
+			buffer = new ThreadBuffer(static_cast<uint32>(Buffers.size()));
+			Buffers.push_back(buffer);
+		}
+
+		return *buffer;
+	}
+
+	uint64 Profiler::GetTime()
+	{
+		static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+}
@@ -0,0 +1,183 @@
+#include "pch.h"
+
+#include <atomic>
+#include <memory>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#include "PBR/Core/ThreadPool.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ThreadPoolUtils /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static void SetCurrentThreadPriority(const ThreadPriority priority)
+	{
+		if (priority == ThreadPriority::Normal)
+			return;
+
+#ifdef _WIN32
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+		// Linux applies nice values per thread.
+		setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+	}
+
+	// Outlives the call if helpers are dequeued after the last chunk is done. They find no chunk
+	// left and never touch the task, which only lives as long as the call.
+	struct ParallelForState
+	{
+
+		std::atomic<uint32> NextChunk{ 0 };
+
+		std::mutex Mutex;
+		std::condition_variable Finished;
+		uint32 FinishedChunks = 0;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ThreadPool //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ThreadPool::ThreadPool(const uint32 threadCount, const ThreadPriority priority)
+		: Workers()
+		, Priority(priority)
+		, Mutex()
+		, TaskAvailable()
+		, Tasks()
+		, bStopRequested(false)
+	{
+		uint32 count = threadCount;
+		if (!count)
+		{
+			const uint32 hardwareThreads = std::thread::hardware_concurrency();
+			count = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		Workers.reserve(count);
+		for (uint32 i = 0; i < count; ++i)
+			Workers.emplace_back(&ThreadPool::Run, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			bStopRequested = true;
+		}
+
+		TaskAvailable.notify_all();
+
+		for (std::thread& worker : Workers)
+			worker.join();
+	}
+
+	void ThreadPool::Enqueue(Task task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			Tasks.push(std::move(task));
+		}
+
+		TaskAvailable.notify_one();
+	}
+
+	uint32 ThreadPool::ParallelFor(const uint32 count, const uint32 minChunkSize, const RangeTask& task)
+	{
+		if (!count)
+			return 0;
+
+		const uint32 minSize = minChunkSize ? minChunkSize : 1;
+		const uint32 chunkCount = std::min(GetMaxChunkCount(), (count + minSize - 1) / minSize);
+
+		if (chunkCount == 1)
+		{
+			task(0, count, 0);
+			return 1;
+		}
+
+		const uint32 chunkSize = count / chunkCount;
+		const uint32 remainder = count % chunkCount;
+
+		// The first 'remainder' chunks get one element more.
+		auto chunkBegin = [chunkSize, remainder](const uint32 chunk)
+		{
+			return chunk * chunkSize + std::min(chunk, remainder);
+		};
+
+		const std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+		const RangeTask* rangeTask = &task;
+
+		auto processChunks = [state, rangeTask, chunkCount, chunkBegin]()
+		{
+			uint32 processed = 0;
+			for (uint32 chunk = state->NextChunk++; chunk < chunkCount; chunk = state->NextChunk++, ++processed)
+				(*rangeTask)(chunkBegin(chunk), chunkBegin(chunk + 1), chunk);
+
+			if (!processed)
+				return;
+
+			std::lock_guard<std::mutex> lock(state->Mutex);
+			state->FinishedChunks += processed;
+
+			if (state->FinishedChunks == chunkCount)
+				state->Finished.notify_one();
+		};
+
+		// Helpers stuck behind long tasks of the queue cost nothing, the calling thread takes
+		// over their chunks.
+		for (uint32 i = 0; i < chunkCount - 1; ++i)
+			Enqueue(processChunks);
+
+		processChunks();
+
+		std::unique_lock<std::mutex> lock(state->Mutex);
+		state->Finished.wait(lock, [&state, chunkCount]() { return state->FinishedChunks == chunkCount; });
+
+		return chunkCount;
+	}
+
+	void ThreadPool::Run()
+	{
+		Profiler::SetThreadName(Priority == ThreadPriority::Low ? "Background Worker" : "Worker");
+		SetCurrentThreadPriority(Priority);
+
+		while (true)
+		{
+			Task task;
+
+			{
+				std::unique_lock<std::mutex> lock(Mutex);
+				TaskAvailable.wait(lock, [this]() { return bStopRequested || !Tasks.empty(); });
+
+				if (bStopRequested && Tasks.empty())
+					return;
+
+				task = std::move(Tasks.front());
+				Tasks.pop();
+			}
+
+			task();
+		}
+	}
+
+}
@@ -30,6 +30,8 @@ namespace EngineCore
 		, AmbientOcclusionMap(0)
 		, NormalMap(0)
 		, DisplacementMap(0)
+
+		, Revision(0)
 	{
 
 	}
@@ -1,11 +1,90 @@
 #include "pch.h"
 #include "PBR/Engine/Mesh.h"
 
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/quaternion.hpp>
+
 #include "PBR/RHI/VertexArray.h"
 
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PackedVertex ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static glm::quat EncodeTangentFrame(const glm::fvec3& normal, const glm::fvec3& tangent, const glm::fvec3& binormal)
+	{
+		const glm::fvec3 n = glm::normalize(normal);
+
+		// Gram-Schmidt, vertices without a usable tangent get an arbitrary one.
+		glm::fvec3 t = tangent - glm::dot(tangent, n) * n;
+		if (glm::dot(t, t) < 1e-12f)
+			t = std::abs(n.x) < 0.9f ? glm::fvec3(1.0f, 0.0f, 0.0f) - n.x * n : glm::fvec3(0.0f, 1.0f, 0.0f) - n.y * n;
+
+		t = glm::normalize(t);
+		const glm::fvec3 b = glm::cross(n, t);
+
+		glm::quat frame = glm::normalize(glm::quat_cast(glm::fmat3(t, b, n)));
+		if (frame.w < 0.0f)
+			frame = -frame;
+
+		// w must not be zero, otherwise its sign cannot carry the reflection.
+		const float bias = 1.0f / 32767.0f;
+		if (frame.w < bias)
+		{
+			const float scale = std::sqrt(1.0f - bias * bias);
+			frame = glm::quat(bias, frame.x * scale, frame.y * scale, frame.z * scale);
+		}
+
+		if (glm::dot(b, binormal) < 0.0f)
+			frame = -frame;
+
+		return frame;
+	}
+
+	PackedVertex PackVertex(const Vertex& vertex)
+	{
+		const glm::quat frame = EncodeTangentFrame(vertex.Normal, vertex.Tangent, vertex.Binormal);
+
+		PackedVertex packed;
+		packed.Position = vertex.Position;
+		packed.UvCoord = glm::packHalf2x16(vertex.UvCoord);
+		packed.TangentFrame = glm::packSnorm4x16(glm::fvec4(frame.x, frame.y, frame.z, frame.w));
+
+		return packed;
+	}
+
+	static std::vector<PackedVertex> PackVertices(const std::vector<Vertex>& vertices)
+	{
+		std::vector<PackedVertex> packed;
+		packed.reserve(vertices.size());
+
+		for (const Vertex& vertex : vertices)
+			packed.push_back(PackVertex(vertex));
+
+		return packed;
+	}
+
+	static float ComputeBoundingRadius(const std::vector<Vertex>& vertices)
+	{
+		float radius = 0.0f;
+		for (const Vertex& vertex : vertices)
+			radius = std::max(radius, glm::dot(vertex.Position, vertex.Position));
+
+		return std::sqrt(radius);
+	}
+
+	static VertexBufferRef CreatePackedVertexBuffer(const std::vector<Vertex>& vertices, const BufferUsage usage)
+	{
+		const std::vector<PackedVertex> packed = PackVertices(vertices);
+
+		VertexBufferRef vbo = VertexBuffer::Create(packed.data(), sizeof(PackedVertex) * static_cast<uint32>(packed.size()), usage);
+		vbo->SetLayout(Mesh::GetVertexLayout());
+
+		return vbo;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Mesh ////////////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +92,9 @@ namespace EngineCore
 	Mesh::Mesh()
 		: VertexArrayObject(nullptr)
 		, IndexBufferObject(nullptr)
+		, Geometry(nullptr)
+		, Allocation(GeometryBuffer::InvalidHandle)
+		, BoundingRadius(0.0f)
 	{
 		
 	}
@@ -20,43 +102,111 @@ namespace EngineCore
 	Mesh::Mesh(const VertexArrayRef& vertexArray)
 		: VertexArrayObject(vertexArray)
 		, IndexBufferObject(vertexArray->GetIndexBuffer())
+		, Geometry(nullptr)
+		, Allocation(GeometryBuffer::InvalidHandle)
+		, BoundingRadius(0.0f)
+	{
+	}
+
+	Mesh::Mesh(const GeometryBufferRef& geometry, const GeometryHandle allocation)
+		: VertexArrayObject(nullptr)
+		, IndexBufferObject(nullptr)
+		, Geometry(geometry)
+		, Allocation(allocation)
+		, BoundingRadius(0.0f)
 	{
 	}
 
 	Mesh::~Mesh()
 	{
+		if (Geometry)
+			Geometry->Free(Allocation);
+	}
+
+	void Mesh::SetVertexArray(const VertexArrayRef& vertexArray)
+	{
+		if (Geometry)
+		{
+			Geometry->Free(Allocation);
+
+			Geometry = nullptr;
+			Allocation = GeometryBuffer::InvalidHandle;
+		}
+
+		VertexArrayObject = vertexArray;
+		IndexBufferObject = vertexArray->GetIndexBuffer();
+	}
+
+	uint32 Mesh::GetIndexCount() const
+	{
+		return Geometry ? Geometry->GetAllocation(Allocation).IndexCount : IndexBufferObject->GetCount();
+	}
+
+	uint32 Mesh::GetFirstIndex() const
+	{
+		return Geometry ? Geometry->GetAllocation(Allocation).FirstIndex : 0;
+	}
+
+	int32 Mesh::GetBaseVertex() const
+	{
+		return Geometry ? static_cast<int32>(Geometry->GetAllocation(Allocation).FirstVertex) : 0;
 	}
 
 	void Mesh::Renderer_Bind() const
 	{
-		VertexArrayObject->Bind();
-		IndexBufferObject->Bind();
+		GetVertexArray()->Bind();
+		GetIndexBuffer()->Bind();
 	}
 
 	void Mesh::Renderer_Unbind() const
 	{
-		VertexArrayObject->Unbind();
-		IndexBufferObject->Unbind();
+		GetVertexArray()->Unbind();
+		GetIndexBuffer()->Unbind();
 	}
 
-	Ref<Mesh> Mesh::Create(const MeshData& data)
+	Ref<Mesh> Mesh::Create(const MeshData& data, const BufferUsage usage)
+	{
+		Ref<Mesh> mesh = CreateMesh(data, usage);
+		mesh->BoundingRadius = ComputeBoundingRadius(data.GetVertices());
+
+		return mesh;
+	}
+
+	Ref<Mesh> Mesh::CreateMesh(const MeshData& data, const BufferUsage usage)
 	{
 		const std::vector<Vertex>& vertices = data.GetVertices();
 		const std::vector<uint32>& indices = data.GetIndices();
 
-		VertexArrayRef vao = VertexArray::Create();
-		VertexBufferRef vbo = VertexBuffer::Create(vertices.data(), sizeof(Vertex) * static_cast<uint32>(vertices.size()));
-		const IndexBufferRef ibo = IndexBuffer::Create(indices.data(), static_cast<uint32>(indices.size()));
-
-		static const BufferLayout layout = {
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float2 },
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float3 }
-		};
+		GeometryPool* pool = GeometryPool::GetInstance();
+		if (pool && usage == BufferUsage::Static && !vertices.empty() && !indices.empty())
+		{
+			const std::vector<PackedVertex> packed = PackVertices(vertices);
+			const uint32 vertexCount = static_cast<uint32>(vertices.size());
+			const uint32 indexCount = static_cast<uint32>(indices.size());
+
+			// Meshes too large for 16 bit indices share a second buffer of the same format.
+			if (vertexCount > 0xFFFF + 1)
+			{
+				const GeometryBufferRef& geometry = pool->GetBuffer(GetVertexLayout(), IndexType::UInt32);
+				return new Mesh(geometry, geometry->Allocate(packed.data(), vertexCount, indices.data(), indexCount));
+			}
+
+			std::vector<uint16> compact;
+			compact.reserve(indices.size());
+
+			for (const uint32 index : indices)
+			{
+				assert(index < vertexCount); // "Index out of the vertex range."
+				compact.push_back(static_cast<uint16>(index));
+			}
+
+			const GeometryBufferRef& geometry = pool->GetBuffer(GetVertexLayout(), IndexType::UInt16);
+			return new Mesh(geometry, geometry->Allocate(packed.data(), vertexCount, compact.data(), indexCount));
+		}
 
-		vbo->SetLayout(layout);
+		VertexArrayRef vao = VertexArray::Create();
+		const VertexBufferRef vbo = CreatePackedVertexBuffer(vertices, usage);
+		const IndexBufferRef ibo = IndexBuffer::CreateCompact(indices, static_cast<uint32>(vertices.size()));
 
 		vao->AddVertexBuffer(vbo);
 		vao->SetIndexBuffer(ibo);
@@ -64,6 +214,17 @@ namespace EngineCore
 		return new Mesh(vao);
 	}
 
+	const BufferLayout& Mesh::GetVertexLayout()
+	{
+		static const BufferLayout layout = {
+			{ ShaderDataType::Float3 },
+			{ ShaderDataType::Half2 },
+			{ ShaderDataType::Short4, true }
+		};
+
+		return layout;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// InstanceBuffer //////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -136,18 +297,8 @@ namespace EngineCore
 		const std::vector<uint32>& indices = data.GetIndices();
 
 		VertexArrayRef vao = VertexArray::Create();
-		VertexBufferRef vbo = VertexBuffer::Create(vertices.data(), sizeof(Vertex) * static_cast<uint32>(vertices.size()));
-		const IndexBufferRef ibo = IndexBuffer::Create(indices.data(), static_cast<uint32>(indices.size()));
-
-		static const BufferLayout layout = {
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float2 },
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float3 },
-			{ ShaderDataType::Float3 }
-		};
-
-		vbo->SetLayout(layout);
+		const VertexBufferRef vbo = CreatePackedVertexBuffer(vertices, BufferUsage::Static);
+		const IndexBufferRef ibo = IndexBuffer::CreateCompact(indices, static_cast<uint32>(vertices.size()));
 
 		vao->AddVertexBuffer(vbo);
 		vao->SetIndexBuffer(ibo);
@@ -2,6 +2,7 @@
 
 #include "PBR/Renderer/Renderer.h"
 #include "PBR/RHIOpenGL/OpenGLBuffer.h"
+#include "PBR/RHINull/NullBuffer.h"
 
 namespace EngineCore
 {
@@ -14,6 +15,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullVertexBuffer(data, size, usage);
 		case RenderApi::OpenGL: return new OpenGLVertexBuffer(data, size, usage);
 
 		default:
@@ -27,6 +29,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullVertexBuffer(nullptr, size, usage);
 		case RenderApi::OpenGL: return new OpenGLMappedVertexBuffer(size, usage);
 
 		default:
@@ -40,11 +43,41 @@ namespace EngineCore
 	// IndexBuffer /////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	Ref<IndexBuffer> IndexBuffer::Create(const uint16* data, const uint32 count, const BufferUsage usage)
+	{
+		return Create(data, count, IndexType::UInt16, usage);
+	}
+
 	Ref<IndexBuffer> IndexBuffer::Create(const uint32* data, const uint32 count, const BufferUsage usage)
+	{
+		return Create(data, count, IndexType::UInt32, usage);
+	}
+
+	Ref<IndexBuffer> IndexBuffer::CreateCompact(const std::vector<uint32>& indices, const uint32 vertexCount, const BufferUsage usage)
+	{
+		const uint32 count = static_cast<uint32>(indices.size());
+
+		if (vertexCount > 0xFFFF + 1)
+			return Create(indices.data(), count, usage);
+
+		std::vector<uint16> compact;
+		compact.reserve(indices.size());
+
+		for (const uint32 index : indices)
+		{
+			assert(index < vertexCount); // "Index out of the vertex range."
+			compact.push_back(static_cast<uint16>(index));
+		}
+
+		return Create(compact.data(), count, usage);
+	}
+
+	Ref<IndexBuffer> IndexBuffer::Create(const void* data, const uint32 count, const IndexType type, const BufferUsage usage)
 	{
 		switch (Renderer::GetApi())
 		{
-		case RenderApi::OpenGL: return new OpenGLIndexBuffer(data, count, usage);
+		case RenderApi::None: return new NullIndexBuffer(data, count, type, usage);
+		case RenderApi::OpenGL: return new OpenGLIndexBuffer(data, count, type, usage);
 
 		default:
 			break;
@@ -61,6 +94,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullUniformBuffer(size, usage);
 		case RenderApi::OpenGL: return new OpenGLUniformBuffer(size, usage);
 
 		default:
@@ -74,6 +108,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullUniformBuffer(data, size, usage);
 		case RenderApi::OpenGL: return new OpenGLUniformBuffer(data, size, usage);
 
 		default:
@@ -83,4 +118,72 @@ namespace EngineCore
 		return nullptr;
 	}
 
+	Ref<UniformBuffer> UniformBuffer::CreateMapped(const uint32 size)
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullUniformBuffer(size, BufferUsage::Stream, true);
+		case RenderApi::OpenGL: return new OpenGLMappedUniformBuffer(size);
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// StorageBuffer ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<StorageBuffer> StorageBuffer::Create(const uint32 size, const BufferUsage usage)
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullStorageBuffer(size, usage);
+		case RenderApi::OpenGL: return new OpenGLStorageBuffer(size, usage);
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// IndirectBuffer //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<IndirectBuffer> IndirectBuffer::Create(const uint32 capacity, const BufferUsage usage)
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullIndirectBuffer(capacity, usage);
+		case RenderApi::OpenGL: return new OpenGLIndirectBuffer(capacity, usage);
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PixelBuffer /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<PixelBuffer> PixelBuffer::CreateMapped(const uint32 size)
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullPixelBuffer(size);
+		case RenderApi::OpenGL: return new OpenGLPixelBuffer(size);
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
 }
\ No newline at end of file
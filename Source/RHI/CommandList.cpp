@@ -6,6 +6,465 @@
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RHICommands /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct RHICommandClear final : public RHICommandBase
+	{
+
+		RHICommandClear(const ClearFlags flags) : Flags(flags) { }
+		virtual void Execute(RHIContext& context) final override { context.RHIClear(Flags); }
+
+		ClearFlags Flags;
+
+	};
+
+	struct RHICommandSetClearColor final : public RHICommandBase
+	{
+
+		RHICommandSetClearColor(const glm::vec4& color) : Color(color) { }
+		virtual void Execute(RHIContext& context) final override { context.RHISetClearColor(Color); }
+
+		glm::vec4 Color;
+
+	};
+
+	struct RHICommandSetDepthFunc final : public RHICommandBase
+	{
+
+		RHICommandSetDepthFunc(const DepthFunc func) : Func(func) { }
+		virtual void Execute(RHIContext& context) final override { context.RHISetDepthFunc(Func); }
+
+		DepthFunc Func;
+
+	};
+
+	struct RHICommandDepthMask final : public RHICommandBase
+	{
+
+		RHICommandDepthMask(const bool value) : Value(value) { }
+		virtual void Execute(RHIContext& context) final override { context.RHIDepthMask(Value); }
+
+		bool Value;
+
+	};
+
+	struct RHICommandSetCullMode final : public RHICommandBase
+	{
+
+		RHICommandSetCullMode(const CullMode mode) : Mode(mode) { }
+		virtual void Execute(RHIContext& context) final override { context.RHISetCullMode(Mode); }
+
+		CullMode Mode;
+
+	};
+
+	struct RHICommandSetBlendFunc final : public RHICommandBase
+	{
+
+		RHICommandSetBlendFunc(const BlendFunc func) : Func(func) { }
+		virtual void Execute(RHIContext& context) final override { context.RHISetBlendFunc(Func); }
+
+		BlendFunc Func;
+
+	};
+
+	struct RHICommandSetViewport final : public RHICommandBase
+	{
+
+		RHICommandSetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
+			: X(x)
+			, Y(y)
+			, Width(width)
+			, Height(height)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override { context.RHISetViewport(X, Y, Width, Height); }
+
+		uint32 X;
+		uint32 Y;
+		uint32 Width;
+		uint32 Height;
+
+	};
+
+	struct RHICommandSetShader final : public RHICommandBase
+	{
+
+		RHICommandSetShader(const ShaderRef& shader) : Shader(shader) { }
+
+		virtual void Execute(RHIContext& context) final override
+		{
+			context.RHISetShader(Shader);
+			Shader->Bind();
+		}
+
+		ShaderRef Shader;
+
+	};
+
+	struct RHICommandSetPipelineState final : public RHICommandBase
+	{
+
+		RHICommandSetPipelineState(const PipelineStateRef& pipelineState) : PipelineState(pipelineState) { }
+		virtual void Execute(RHIContext& context) final override { context.RHISetPipelineState(PipelineState); }
+
+		PipelineStateRef PipelineState;
+
+	};
+
+	struct RHICommandSetUniformBufferData final : public RHICommandBase
+	{
+
+		RHICommandSetUniformBufferData(const UniformBufferRef& uniformBuffer, const void* data, const uint32 size, const uint32 offset)
+			: UniformBuffer(uniformBuffer)
+			, Data(data)
+			, Size(size)
+			, Offset(offset)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override { UniformBuffer->SetData(Data, Size, Offset); }
+
+		UniformBufferRef UniformBuffer;
+
+		// Points into the owning list's arena.
+		const void* Data;
+		uint32 Size;
+		uint32 Offset;
+
+	};
+
+	struct RHICommandBindUniformBlock final : public RHICommandBase
+	{
+
+		RHICommandBindUniformBlock(const UniformBufferRef& uniformBuffer, const uint32 blockIndex)
+			: UniformBuffer(uniformBuffer)
+			, BlockIndex(blockIndex)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override { UniformBuffer->BindBlock(BlockIndex); }
+
+		UniformBufferRef UniformBuffer;
+		uint32 BlockIndex;
+
+	};
+
+	struct RHICommandBindUniformBlockRange final : public RHICommandBase
+	{
+
+		RHICommandBindUniformBlockRange(const UniformBufferRef& uniformBuffer, const uint32 blockIndex, const uint32 offset, const uint32 size)
+			: UniformBuffer(uniformBuffer)
+			, BlockIndex(blockIndex)
+			, Offset(offset)
+			, Size(size)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override { UniformBuffer->BindBlockRange(BlockIndex, Offset, Size); }
+
+		UniformBufferRef UniformBuffer;
+		uint32 BlockIndex;
+		uint32 Offset;
+		uint32 Size;
+
+	};
+
+	struct RHICommandBeginRenderPass final : public RHICommandBase
+	{
+
+		RHICommandBeginRenderPass(const char* name) : Name(name) { }
+
+		virtual void Execute(RHIContext& context) final override { context.RHIBeginRenderPass(Name); }
+
+		// Not copied, the name has to outlive the command list.
+		const char* Name;
+
+	};
+
+	struct RHICommandEndRenderPass final : public RHICommandBase
+	{
+
+		virtual void Execute(RHIContext& context) final override { context.RHIEndRenderPass(); }
+
+	};
+
+	struct RHICommandDraw final : public RHICommandBase
+	{
+
+		RHICommandDraw(const VertexArrayRef& vertexArray) : VertexArray(vertexArray) { }
+
+		virtual void Execute(RHIContext& context) final override
+		{
+			VertexArray->Bind();
+
+			context.RHISetVertexArray(VertexArray);
+			context.RHIDrawPrimitive();
+		}
+
+		VertexArrayRef VertexArray;
+
+	};
+
+	struct RHICommandDrawIndexed final : public RHICommandBase
+	{
+
+		RHICommandDrawIndexed(const VertexArrayRef& vertexArray, const uint32 instanceCount)
+			: VertexArray(vertexArray)
+			, InstanceCount(instanceCount)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override
+		{
+			VertexArray->Bind();
+			VertexArray->GetIndexBuffer()->Bind();
+
+			context.RHISetVertexArray(VertexArray);
+
+			if (InstanceCount)
+				context.RHIDrawIndexedInstancedPrimitive(InstanceCount);
+			else
+				context.RHIDrawIndexedPrimitive();
+		}
+
+		VertexArrayRef VertexArray;
+		uint32 InstanceCount;
+
+	};
+
+	struct RHICommandDrawIndexedRange final : public RHICommandBase
+	{
+
+		RHICommandDrawIndexedRange(const VertexArrayRef& vertexArray, const uint32 indexCount, const uint32 firstIndex, const int32 baseVertex)
+			: VertexArray(vertexArray)
+			, IndexCount(indexCount)
+			, FirstIndex(firstIndex)
+			, BaseVertex(baseVertex)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override
+		{
+			VertexArray->Bind();
+			VertexArray->GetIndexBuffer()->Bind();
+
+			context.RHISetVertexArray(VertexArray);
+			context.RHIDrawIndexedRangePrimitive(IndexCount, FirstIndex, BaseVertex);
+		}
+
+		VertexArrayRef VertexArray;
+
+		uint32 IndexCount;
+		uint32 FirstIndex;
+		int32 BaseVertex;
+
+	};
+
+	struct RHICommandDispatch final : public RHICommandBase
+	{
+
+		RHICommandDispatch(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ)
+			: GroupsX(groupsX)
+			, GroupsY(groupsY)
+			, GroupsZ(groupsZ)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override { context.RHIDispatchCompute(GroupsX, GroupsY, GroupsZ); }
+
+		uint32 GroupsX;
+		uint32 GroupsY;
+		uint32 GroupsZ;
+
+	};
+
+	struct RHICommandMultiDrawIndexedIndirect final : public RHICommandBase
+	{
+
+		RHICommandMultiDrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount)
+			: VertexArray(vertexArray)
+			, IndirectBuffer(indirectBuffer)
+			, Offset(offset)
+			, DrawCount(drawCount)
+		{
+		}
+
+		virtual void Execute(RHIContext& context) final override
+		{
+			VertexArray->Bind();
+			VertexArray->GetIndexBuffer()->Bind();
+
+			context.RHISetVertexArray(VertexArray);
+
+			if (DrawCount == 1)
+				context.RHIDrawIndexedIndirect(IndirectBuffer, Offset);
+			else
+				context.RHIMultiDrawIndexedIndirect(IndirectBuffer, Offset, DrawCount);
+		}
+
+		VertexArrayRef VertexArray;
+		IndirectBufferRef IndirectBuffer;
+
+		uint32 Offset;
+		uint32 DrawCount;
+
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RHICommandList //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RHICommandList::RHICommandList()
+		: Allocator()
+		, Head(nullptr)
+		, Tail(nullptr)
+		, CommandCount(0)
+	{
+
+	}
+
+	RHICommandList::~RHICommandList()
+	{
+		Reset();
+	}
+
+	void RHICommandList::Clear(const ClearFlags flags)
+	{
+		Record<RHICommandClear>(flags);
+	}
+
+	void RHICommandList::SetClearColor(const glm::vec4& color)
+	{
+		Record<RHICommandSetClearColor>(color);
+	}
+
+	void RHICommandList::SetDepthFunc(const DepthFunc func)
+	{
+		Record<RHICommandSetDepthFunc>(func);
+	}
+
+	void RHICommandList::DepthMask(const bool value)
+	{
+		Record<RHICommandDepthMask>(value);
+	}
+
+	void RHICommandList::SetCullMode(const CullMode mode)
+	{
+		Record<RHICommandSetCullMode>(mode);
+	}
+
+	void RHICommandList::SetBlendFunc(const BlendFunc func)
+	{
+		Record<RHICommandSetBlendFunc>(func);
+	}
+
+	void RHICommandList::SetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
+	{
+		Record<RHICommandSetViewport>(x, y, width, height);
+	}
+
+	void RHICommandList::SetShader(const ShaderRef& shader)
+	{
+		Record<RHICommandSetShader>(shader);
+	}
+
+	void RHICommandList::SetPipelineState(const PipelineStateRef& pipelineState)
+	{
+		Record<RHICommandSetPipelineState>(pipelineState);
+	}
+
+	void RHICommandList::SetUniformBufferData(const UniformBufferRef& uniformBuffer, const void* data, const uint32 size, const uint32 offset)
+	{
+		// The caller's data usually lives on the stack, so copy it next to the command.
+		void* copy = Allocator.Allocate(size, 16);
+		std::memcpy(copy, data, size);
+
+		Record<RHICommandSetUniformBufferData>(uniformBuffer, copy, size, offset);
+	}
+
+	void RHICommandList::BindUniformBlock(const UniformBufferRef& uniformBuffer, const uint32 blockIndex)
+	{
+		Record<RHICommandBindUniformBlock>(uniformBuffer, blockIndex);
+	}
+
+	void RHICommandList::BindUniformBlockRange(const UniformBufferRef& uniformBuffer, const uint32 blockIndex, const uint32 offset, const uint32 size)
+	{
+		Record<RHICommandBindUniformBlockRange>(uniformBuffer, blockIndex, offset, size);
+	}
+
+	void RHICommandList::BeginRenderPass(const char* name)
+	{
+		Record<RHICommandBeginRenderPass>(name);
+	}
+
+	void RHICommandList::EndRenderPass()
+	{
+		Record<RHICommandEndRenderPass>();
+	}
+
+	void RHICommandList::Draw(const VertexArrayRef& vertexArray)
+	{
+		Record<RHICommandDraw>(vertexArray);
+	}
+
+	void RHICommandList::DrawIndexed(const VertexArrayRef& vertexArray)
+	{
+		Record<RHICommandDrawIndexed>(vertexArray, 0);
+	}
+
+	void RHICommandList::DrawIndexedInstanced(const VertexArrayRef& vertexArray, const uint32 instanceCount)
+	{
+		Record<RHICommandDrawIndexed>(vertexArray, instanceCount);
+	}
+
+	void RHICommandList::DrawIndexedRange(const VertexArrayRef& vertexArray, const uint32 indexCount, const uint32 firstIndex, const int32 baseVertex)
+	{
+		Record<RHICommandDrawIndexedRange>(vertexArray, indexCount, firstIndex, baseVertex);
+	}
+
+	void RHICommandList::DrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset)
+	{
+		Record<RHICommandMultiDrawIndexedIndirect>(vertexArray, indirectBuffer, offset, 1);
+	}
+
+	void RHICommandList::MultiDrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount)
+	{
+		Record<RHICommandMultiDrawIndexedIndirect>(vertexArray, indirectBuffer, offset, drawCount);
+	}
+
+	void RHICommandList::Dispatch(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ)
+	{
+		Record<RHICommandDispatch>(groupsX, groupsY, groupsZ);
+	}
+
+	void RHICommandList::Execute(RHIContext& context)
+	{
+		for (RHICommandBase* command = Head; command; command = command->Next)
+			command->Execute(context);
+	}
+
+	void RHICommandList::Reset()
+	{
+		RHICommandBase* command = Head;
+		while (command)
+		{
+			RHICommandBase* next = command->Next;
+			command->~RHICommandBase();
+
+			command = next;
+		}
+
+		Head = nullptr;
+		Tail = nullptr;
+		CommandCount = 0;
+
+		Allocator.Reset();
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RHIImmediateCommandList /////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,9 +504,25 @@ namespace EngineCore
 		GetContext().RHISetCullMode(mode);
 	}
 
-	void RHICommandListImmediate::BeginRenderPass()
+	void RHICommandListImmediate::SetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
 	{
-		GetContext().RHIBeginRenderPass();
+		GetContext().RHISetViewport(x, y, width, height);
+	}
+
+	void RHICommandListImmediate::SetShader(const ShaderRef& shader)
+	{
+		GetContext().RHISetShader(shader);
+		shader->Bind();
+	}
+
+	void RHICommandListImmediate::SetPipelineState(const PipelineStateRef& pipelineState)
+	{
+		GetContext().RHISetPipelineState(pipelineState);
+	}
+
+	void RHICommandListImmediate::BeginRenderPass(const char* name)
+	{
+		GetContext().RHIBeginRenderPass(name);
 	}
 
 	void RHICommandListImmediate::EndRenderPass()
@@ -73,10 +548,44 @@ namespace EngineCore
 		GetContext().RHIDrawIndexedInstancedPrimitive(instanceCount);
 	}
 
+	void RHICommandListImmediate::DrawIndexedRange(const VertexArrayRef& vertexArray, const uint32 indexCount, const uint32 firstIndex, const int32 baseVertex)
+	{
+		GetContext().RHISetVertexArray(vertexArray);
+		GetContext().RHIDrawIndexedRangePrimitive(indexCount, firstIndex, baseVertex);
+	}
+
+	void RHICommandListImmediate::DrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset)
+	{
+		GetContext().RHISetVertexArray(vertexArray);
+		GetContext().RHIDrawIndexedIndirect(indirectBuffer, offset);
+	}
+
+	void RHICommandListImmediate::MultiDrawIndexedIndirect(const VertexArrayRef& vertexArray, const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount)
+	{
+		GetContext().RHISetVertexArray(vertexArray);
+		GetContext().RHIMultiDrawIndexedIndirect(indirectBuffer, offset, drawCount);
+	}
+
+	void RHICommandListImmediate::Dispatch(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ)
+	{
+		GetContext().RHIDispatchCompute(groupsX, groupsY, groupsZ);
+	}
+
+	void RHICommandListImmediate::Submit(RHICommandList& commandList)
+	{
+		RHICommandListExecutor::ExecuteList(commandList);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// RHICommandListExecutor //////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	RHICommandListImmediate RHICommandListExecutor::CommandListImmediate = RHICommandListImmediate();
 
+	void RHICommandListExecutor::ExecuteList(RHICommandList& commandList)
+	{
+		commandList.Execute(RHIContext::GetContext());
+		commandList.Reset();
+	}
+
 }
\ No newline at end of file
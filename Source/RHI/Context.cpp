@@ -2,6 +2,7 @@
 #include "PBR/RHI/Context.h"
 
 #include "PBR/RHIOpenGL/OpenGLContext.h"
+#include "PBR/RHINull/NullContext.h"
 
 
 namespace EngineCore
@@ -19,6 +20,7 @@ namespace EngineCore
 	{
 		switch (api)
 		{
+		case RenderApi::None: return new NullContext();
 		case RenderApi::OpenGL: return new OpenGLContext();
 
 		default:
@@ -0,0 +1,62 @@
+#include "pch.h"
+#include "PBR/RHI/DeferredReleaseQueue.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DeferredReleaseQueue ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	DeferredReleaseQueue* DeferredReleaseQueue::Instance = nullptr;
+
+	DeferredReleaseQueue::DeferredReleaseQueue()
+		: Fences()
+		, Objects()
+		, FrameIndex(FrameCount - 1)
+		, PendingCount(0)
+	{
+		assert(!Instance); // "DeferredReleaseQueue already exists!"
+		Instance = this;
+
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i] = GpuFence::Create();
+	}
+
+	DeferredReleaseQueue::~DeferredReleaseQueue()
+	{
+		Instance = nullptr;
+
+		// Objects queued after the last EndFrame() are covered by no fence.
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i]->Signal();
+
+		for (uint32 i = 0; i < FrameCount; ++i)
+		{
+			Fences[i]->Wait();
+			Objects[i].clear();
+		}
+	}
+
+	void DeferredReleaseQueue::BeginFrame()
+	{
+		FrameIndex = (FrameIndex + 1) % FrameCount;
+		Fences[FrameIndex]->Wait();
+
+		PendingCount -= static_cast<uint32>(Objects[FrameIndex].size());
+		Objects[FrameIndex].clear();
+	}
+
+	void DeferredReleaseQueue::EndFrame()
+	{
+		Fences[FrameIndex]->Signal();
+	}
+
+	void DeferredReleaseQueue::Release(const Ref<RefCountedObject>& object)
+	{
+		Objects[FrameIndex].push_back(object);
+		++PendingCount;
+	}
+
+}
@@ -2,6 +2,7 @@
 
 #include "PBR/Renderer/Renderer.h"
 #include "PBR/RHIOpenGL/OpenGLFrameBuffer.h"
+#include "PBR/RHINull/NullFrameBuffer.h"
 
 
 namespace EngineCore
@@ -11,6 +12,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullFrameBuffer(width, height, createInfo);
 		case RenderApi::OpenGL: return new OpenGLFrameBuffer(width, height, createInfo);
 
 		default:
@@ -0,0 +1,30 @@
+#include "pch.h"
+#include "PBR/RHI/GpuFence.h"
+
+#include "PBR/Renderer/Renderer.h"
+#include "PBR/RHIOpenGL/OpenGLGpuFence.h"
+#include "PBR/RHINull/NullGpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuFence ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<GpuFence> GpuFence::Create()
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullGpuFence();
+		case RenderApi::OpenGL: return new OpenGLGpuFence();
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+}
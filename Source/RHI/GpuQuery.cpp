@@ -0,0 +1,48 @@
+#include "pch.h"
+#include "PBR/RHI/GpuQuery.h"
+
+#include "PBR/Renderer/Renderer.h"
+#include "PBR/RHIOpenGL/OpenGLGpuQuery.h"
+#include "PBR/RHINull/NullGpuQuery.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuTimestampQuery ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<GpuTimestampQuery> GpuTimestampQuery::Create()
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullGpuTimestampQuery();
+		case RenderApi::OpenGL: return new OpenGLGpuTimestampQuery();
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuStatisticsQuery //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Ref<GpuStatisticsQuery> GpuStatisticsQuery::Create()
+	{
+		switch (Renderer::GetApi())
+		{
+		case RenderApi::None: return new NullGpuStatisticsQuery();
+		case RenderApi::OpenGL: return OpenGLGpuStatisticsQuery::IsSupported() ? new OpenGLGpuStatisticsQuery() : nullptr;
+
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+
+#include "PBR/RHI/PipelineState.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineStateDesc ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static void HashCombine(uint64& hash, const uint64 value)
+	{
+		// FNV-1a over the bytes of the value.
+		for (uint32 i = 0; i < sizeof(uint64); ++i)
+		{
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	}
+
+	uint64 PipelineStateDesc::GetHash() const
+	{
+		uint64 hash = 14695981039346656037ull;
+
+		HashCombine(hash, reinterpret_cast<uint64>(Shader.GetReference()));
+
+		HashCombine(hash, static_cast<uint64>(Rasterizer.Primitive));
+		HashCombine(hash, static_cast<uint64>(Rasterizer.CullingMode));
+
+		HashCombine(hash, static_cast<uint64>(DepthStencil.DepthTest));
+		HashCombine(hash, static_cast<uint64>(DepthStencil.bDepthWrite));
+
+		HashCombine(hash, static_cast<uint64>(Blend.BlendingFunc));
+
+		return hash;
+	}
+
+	bool PipelineStateDesc::operator==(const PipelineStateDesc& other) const
+	{
+		return Shader.GetReference() == other.Shader.GetReference()
+			&& Rasterizer.Primitive == other.Rasterizer.Primitive
+			&& Rasterizer.CullingMode == other.Rasterizer.CullingMode
+			&& DepthStencil.DepthTest == other.DepthStencil.DepthTest
+			&& DepthStencil.bDepthWrite == other.DepthStencil.bDepthWrite
+			&& Blend.BlendingFunc == other.Blend.BlendingFunc;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineState ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PipelineState::PipelineState(const PipelineStateDesc& desc, const uint64 hash)
+		: Desc(desc)
+		, Hash(hash)
+	{
+
+	}
+
+	PipelineState::~PipelineState()
+	{
+
+	}
+
+	Ref<PipelineState> PipelineState::Create(const PipelineStateDesc& desc)
+	{
+		return PipelineStateCache::GetOrCreate(desc);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// PipelineStateCache //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::mutex PipelineStateCache::Mutex;
+	std::unordered_map<uint64, std::vector<PipelineStateRef>> PipelineStateCache::States;
+
+	PipelineStateRef PipelineStateCache::GetOrCreate(const PipelineStateDesc& desc)
+	{
+		assert(desc.Shader); // "Pipeline state without a shader."
+
+		const uint64 hash = desc.GetHash();
+
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		std::vector<PipelineStateRef>& bucket = States[hash];
+		for (const PipelineStateRef& state : bucket)
+		{
+			if (state->GetDesc() == desc)
+				return state;
+		}
+
+		PipelineStateRef state = new PipelineState(desc, hash);
+		bucket.push_back(state);
+
+		return state;
+	}
+
+	void PipelineStateCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		States.clear();
+	}
+
+	uint32 PipelineStateCache::GetCount()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		uint32 count = 0;
+		for (const auto& bucket : States)
+			count += static_cast<uint32>(bucket.second.size());
+
+		return count;
+	}
+
+}
@@ -3,16 +3,18 @@
 
 #include "PBR/Renderer/Renderer.h"
 #include "PBR/RHIOpenGL/OpenGLShader.h"
+#include "PBR/RHINull/NullShader.h"
 
 
 namespace EngineCore
 {
 
-	Ref<Shader> Shader::Create(const std::string& name, const ShaderSource& source)
+	Ref<Shader> Shader::Create(const std::string& name, const ShaderSource& source, ShaderCache* cache)
 	{
 		switch (Renderer::GetApi())
 		{
-		case RenderApi::OpenGL: return new OpenGLShader(name, source);
+		case RenderApi::None: return new NullShader(name, source);
+		case RenderApi::OpenGL: return new OpenGLShader(name, source, cache);
 
 		default:
 			break;
@@ -0,0 +1,200 @@
+#include "pch.h"
+
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <functional>
+#include <filesystem>
+
+#include "PBR/RHI/ShaderCache.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderCacheUtils ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// "PBRS"
+	static constexpr uint32 ShaderCacheMagic = 0x53524250;
+	static constexpr uint32 ShaderCacheVersion = 1;
+
+	struct ShaderCacheHeader
+	{
+
+		uint32 Magic;
+		uint32 Version;
+
+		uint64 Key;
+		uint64 Checksum;
+
+		uint32 Format;
+		uint32 Size;
+
+	};
+
+	static_assert(sizeof(ShaderCacheHeader) == 32, "Unexpected padding in ShaderCacheHeader!");
+
+	// FNV-1a, like the pipeline state hashes.
+	static void HashBytes(uint64& hash, const void* data, const size_t size)
+	{
+		const byte* bytes = static_cast<const byte*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	}
+
+	// Length first, so moving text from one stage to the next changes the key.
+	static void HashString(uint64& hash, const std::string& value)
+	{
+		const uint64 length = value.size();
+		HashBytes(hash, &length, sizeof(length));
+		HashBytes(hash, value.data(), value.size());
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ShaderCache /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ShaderCache::ShaderCache(const std::string& directory)
+		: Directory(directory)
+		, bIsEnabled(true)
+		, Stats()
+	{
+		std::error_code error;
+		std::filesystem::create_directories(Directory, error);
+
+		if (error || !std::filesystem::is_directory(Directory, error))
+		{
+			std::cout << "Warning: Shader cache directory " << Directory << " cannot be created, shaders are always compiled." << std::endl;
+			bIsEnabled = false;
+		}
+	}
+
+	ShaderCache::~ShaderCache()
+	{
+
+	}
+
+	bool ShaderCache::Load(const std::string& name, const uint64 key, uint32& format, std::vector<byte>& binary)
+	{
+		if (!bIsEnabled)
+			return false;
+
+		std::ifstream in(GetEntryFile(name), std::ios::in | std::ios::binary);
+
+		ShaderCacheHeader header;
+		if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(ShaderCacheHeader)))
+		{
+			++Stats.Misses;
+			return false;
+		}
+
+		if (header.Magic != ShaderCacheMagic || header.Version != ShaderCacheVersion || header.Key != key || header.Size == 0)
+		{
+			++Stats.Misses;
+			return false;
+		}
+
+		binary.resize(header.Size);
+		if (!in.read(reinterpret_cast<char*>(binary.data()), header.Size))
+		{
+			std::cout << "Warning: Shader cache entry of " << name << " is truncated." << std::endl;
+
+			++Stats.Misses;
+			return false;
+		}
+
+		uint64 checksum = 14695981039346656037ull;
+		HashBytes(checksum, binary.data(), binary.size());
+
+		if (checksum != header.Checksum)
+		{
+			std::cout << "Warning: Shader cache entry of " << name << " is damaged." << std::endl;
+
+			++Stats.Misses;
+			return false;
+		}
+
+		format = header.Format;
+
+		++Stats.Hits;
+		return true;
+	}
+
+	void ShaderCache::Store(const std::string& name, const uint64 key, const uint32 format, const void* binary, const uint32 size)
+	{
+		if (!bIsEnabled || size == 0)
+			return;
+
+		ShaderCacheHeader header;
+		header.Magic = ShaderCacheMagic;
+		header.Version = ShaderCacheVersion;
+		header.Key = key;
+		header.Checksum = 14695981039346656037ull;
+		header.Format = format;
+		header.Size = size;
+
+		HashBytes(header.Checksum, binary, size);
+
+		const std::string file = GetEntryFile(name);
+
+		// Unique per thread and call, processes sharing the directory never write the same file.
+		const uint64 suffix = std::hash<std::thread::id>()(std::this_thread::get_id()) ^ static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+		const std::string temporaryFile = file + "." + std::to_string(suffix) + ".tmp";
+
+		{
+			std::ofstream out(temporaryFile, std::ios::out | std::ios::binary | std::ios::trunc);
+
+			out.write(reinterpret_cast<const char*>(&header), sizeof(ShaderCacheHeader));
+			out.write(static_cast<const char*>(binary), size);
+			out.close();
+
+			if (!out)
+			{
+				std::cout << "Warning: Shader cache entry of " << name << " cannot be written." << std::endl;
+
+				std::error_code error;
+				std::filesystem::remove(temporaryFile, error);
+				return;
+			}
+		}
+
+		// Replaces an existing entry in one step, readers see either the old or the new one.
+		std::error_code error;
+		std::filesystem::rename(temporaryFile, file, error);
+
+		if (error)
+		{
+			std::cout << "Warning: Shader cache entry of " << name << " cannot be replaced." << std::endl;
+
+			std::filesystem::remove(temporaryFile, error);
+			return;
+		}
+
+		++Stats.Writes;
+	}
+
+	uint64 ShaderCache::ComputeKey(const ShaderSource& source, const std::string& driver)
+	{
+		uint64 hash = 14695981039346656037ull;
+
+		HashBytes(hash, &ShaderCacheVersion, sizeof(ShaderCacheVersion));
+		HashString(hash, driver);
+
+		HashString(hash, source.VertexSource);
+		HashString(hash, source.FragmentSource);
+		HashString(hash, source.ComputeSource);
+
+		return hash;
+	}
+
+	std::string ShaderCache::GetEntryFile(const std::string& name) const
+	{
+		return (std::filesystem::path(Directory) / (name + ".bin")).string();
+	}
+
+}
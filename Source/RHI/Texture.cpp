@@ -3,6 +3,7 @@
 
 #include "PBR/Renderer/Renderer.h"
 #include "PBR/RHIOpenGL/OpenGLTexture.h"
+#include "PBR/RHINull/NullTexture.h"
 
 
 namespace EngineCore
@@ -16,6 +17,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullTexture2D(width, height, createInfo);
 		case RenderApi::OpenGL: return new OpenGLTexture2D(width, height, createInfo);
 
 		default:
@@ -29,6 +31,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullTexture2D(width, height, createInfo);
 		case RenderApi::OpenGL: return new OpenGLTexture2D(width, height, data, createInfo);
 
 		default:
@@ -46,6 +49,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullTextureCube(width, height, createInfo);
 		case RenderApi::OpenGL: return new OpenGLTextureCube(width, height, createInfo);
 
 		default:
@@ -59,6 +63,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullTextureCube(width, height, createInfo);
 		case RenderApi::OpenGL: return new OpenGLTextureCube(width, height, data, createInfo);
 
 		default:
@@ -0,0 +1,373 @@
+#include "pch.h"
+
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+#include "PBR/RHI/TextureContainer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureContainerUtils ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr uint32 MakeFourCC(const char a, const char b, const char c, const char d)
+	{
+		return uint32(byte(a)) | (uint32(byte(b)) << 8) | (uint32(byte(c)) << 16) | (uint32(byte(d)) << 24);
+	}
+
+	// Both formats are little endian, the mapping has no alignment guarantees past the header.
+	static uint32 ReadUint32(const byte* data, const uint64 offset)
+	{
+		uint32 value;
+		std::memcpy(&value, data + offset, sizeof(value));
+		return value;
+	}
+
+	static uint64 ReadUint64(const byte* data, const uint64 offset)
+	{
+		uint64 value;
+		std::memcpy(&value, data + offset, sizeof(value));
+		return value;
+	}
+
+	// DDS_HEADER, following the magic number.
+	static constexpr uint32 DdsMagic = MakeFourCC('D', 'D', 'S', ' ');
+	static constexpr uint64 DdsHeaderOffset = 4;
+	static constexpr uint64 DdsHeaderSize = 124;
+	static constexpr uint64 DdsHeader10Size = 20;
+
+	static constexpr uint32 DdsFlagMipMapCount = 0x20000;
+	static constexpr uint32 DdsPixelFlagFourCC = 0x4;
+	static constexpr uint32 DdsPixelFlagRgb = 0x40;
+	static constexpr uint32 DdsCaps2CubeMap = 0x200;
+	static constexpr uint32 DdsCaps2Volume = 0x200000;
+
+	static constexpr uint32 DdsDimensionTexture2D = 3;
+	static constexpr uint32 DdsMiscTextureCube = 0x4;
+
+	// KTX2 header and index, the level index follows with 24 bytes per level.
+	static constexpr byte Ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+	static constexpr uint64 Ktx2LevelIndexOffset = 80;
+	static constexpr uint64 Ktx2LevelIndexEntrySize = 24;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureContainer ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	TextureContainer::TextureContainer()
+		: File()
+		, Width(0)
+		, Height(0)
+		, Format(TextureFormat::None)
+		, InternalFormat(TextureFormat::None)
+		, DataType(TextureDataType::None)
+		, Levels()
+	{
+
+	}
+
+	TextureContainer::~TextureContainer()
+	{
+		Close();
+	}
+
+	bool TextureContainer::Open(const std::string& file)
+	{
+		Close();
+
+		if (!File.Open(file))
+		{
+			std::cout << "Warning: Failed to open texture " << file << "." << std::endl;
+			return false;
+		}
+
+		const byte* data = File.GetData();
+		const uint64 size = File.GetSize();
+
+		bool parsed = false;
+		if (size >= sizeof(Ktx2Identifier) && std::memcmp(data, Ktx2Identifier, sizeof(Ktx2Identifier)) == 0)
+			parsed = ParseKtx2();
+		else if (size >= DdsHeaderOffset && ReadUint32(data, 0) == DdsMagic)
+			parsed = ParseDds();
+
+		if (!parsed || Levels.empty())
+		{
+			std::cout << "Warning: Texture " << file << " is not a supported DDS or KTX2 file." << std::endl;
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void TextureContainer::Close()
+	{
+		File.Close();
+
+		Width = 0;
+		Height = 0;
+		Format = TextureFormat::None;
+		InternalFormat = TextureFormat::None;
+		DataType = TextureDataType::None;
+		Levels.clear();
+	}
+
+	bool TextureContainer::IsContainerFile(const std::string& file)
+	{
+		const auto lastDot = file.rfind('.');
+		if (lastDot == std::string::npos)
+			return false;
+
+		std::string extension = file.substr(lastDot + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](const char c) { return static_cast<char>(std::tolower(static_cast<byte>(c))); });
+
+		return extension == "dds" || extension == "ktx2";
+	}
+
+	bool TextureContainer::ParseDds()
+	{
+		const byte* data = File.GetData();
+		const uint64 size = File.GetSize();
+
+		if (size < DdsHeaderOffset + DdsHeaderSize)
+			return false;
+
+		const byte* header = data + DdsHeaderOffset;
+		if (ReadUint32(header, 0) != DdsHeaderSize)
+			return false;
+
+		const uint32 flags = ReadUint32(header, 4);
+		Height = ReadUint32(header, 8);
+		Width = ReadUint32(header, 12);
+
+		const uint32 mipCount = flags & DdsFlagMipMapCount ? std::max(ReadUint32(header, 24), 1u) : 1;
+
+		const uint32 pixelFlags = ReadUint32(header, 76);
+		const uint32 fourCC = ReadUint32(header, 80);
+		const uint32 bitCount = ReadUint32(header, 84);
+		const uint32 redMask = ReadUint32(header, 88);
+		const uint32 greenMask = ReadUint32(header, 92);
+		const uint32 blueMask = ReadUint32(header, 96);
+		const uint32 alphaMask = ReadUint32(header, 100);
+
+		const uint32 caps2 = ReadUint32(header, 108);
+		if (caps2 & (DdsCaps2CubeMap | DdsCaps2Volume))
+			return false;
+
+		uint64 offset = DdsHeaderOffset + DdsHeaderSize;
+
+		if (pixelFlags & DdsPixelFlagFourCC)
+		{
+			switch (fourCC)
+			{
+			case MakeFourCC('D', 'X', '1', '0'):
+			{
+				if (size < offset + DdsHeader10Size)
+					return false;
+
+				const uint32 dxgiFormat = ReadUint32(data, offset);
+				const uint32 dimension = ReadUint32(data, offset + 4);
+				const uint32 miscFlags = ReadUint32(data, offset + 8);
+				const uint32 arraySize = ReadUint32(data, offset + 12);
+
+				if (dimension != DdsDimensionTexture2D || (miscFlags & DdsMiscTextureCube) || arraySize > 1)
+					return false;
+
+				if (!SetDxgiFormat(dxgiFormat))
+					return false;
+
+				offset += DdsHeader10Size;
+				break;
+			}
+
+			case MakeFourCC('D', 'X', 'T', '1'):	SetFormat(TextureFormat::Rgba, TextureFormat::Bc1, TextureDataType::UnsignedByte); break;
+			case MakeFourCC('D', 'X', 'T', '5'):	SetFormat(TextureFormat::Rgba, TextureFormat::Bc3, TextureDataType::UnsignedByte); break;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'):	SetFormat(TextureFormat::Rgba, TextureFormat::Bc4, TextureDataType::UnsignedByte); break;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'):	SetFormat(TextureFormat::Rgba, TextureFormat::Bc5, TextureDataType::UnsignedByte); break;
+
+			default:
+				return false;
+			}
+		}
+		else if (pixelFlags & DdsPixelFlagRgb)
+		{
+			// Only the orders matching the texture formats, BGR data would need swizzling.
+			if (redMask != 0x000000FF || greenMask != 0x0000FF00 || blueMask != 0x00FF0000)
+				return false;
+
+			if (bitCount == 32 && alphaMask == 0xFF000000)
+				SetFormat(TextureFormat::Rgba, TextureFormat::Rgba, TextureDataType::UnsignedByte);
+			else if (bitCount == 24)
+				SetFormat(TextureFormat::Rgb, TextureFormat::Rgb, TextureDataType::UnsignedByte);
+			else
+				return false;
+		}
+		else
+		{
+			return false;
+		}
+
+		if (!IsSizeSupported())
+			return false;
+
+		// Levels follow each other without padding.
+		TextureCreateInfo createInfo;
+		createInfo.Format = Format;
+		createInfo.InternalFormat = InternalFormat;
+		createInfo.DataType = DataType;
+
+		for (uint32 level = 0; level < mipCount; ++level)
+		{
+			const uint64 levelSize = GetTextureLevelDataSize(GetMipLevelSize(Width, level), GetMipLevelSize(Height, level), createInfo);
+			if (!AddLevel(offset, levelSize))
+				return false;
+
+			offset += levelSize;
+		}
+
+		return true;
+	}
+
+	bool TextureContainer::ParseKtx2()
+	{
+		const byte* data = File.GetData();
+		const uint64 size = File.GetSize();
+
+		if (size < Ktx2LevelIndexOffset)
+			return false;
+
+		const uint32 vkFormat = ReadUint32(data, 12);
+		Width = ReadUint32(data, 20);
+		Height = ReadUint32(data, 24);
+
+		const uint32 depth = ReadUint32(data, 28);
+		const uint32 layerCount = ReadUint32(data, 32);
+		const uint32 faceCount = ReadUint32(data, 36);
+		const uint32 levelCount = std::max(ReadUint32(data, 40), 1u);
+		const uint32 supercompressionScheme = ReadUint32(data, 44);
+
+		if (depth > 0 || layerCount > 1 || faceCount != 1 || supercompressionScheme != 0)
+			return false;
+
+		if (!IsSizeSupported() || !SetVulkanFormat(vkFormat))
+			return false;
+
+		if (size < Ktx2LevelIndexOffset + uint64(levelCount) * Ktx2LevelIndexEntrySize)
+			return false;
+
+		// Level 0 comes first in the index, the data itself is stored from the smallest level.
+		for (uint32 level = 0; level < levelCount; ++level)
+		{
+			const uint64 entry = Ktx2LevelIndexOffset + level * Ktx2LevelIndexEntrySize;
+			if (!AddLevel(ReadUint64(data, entry), ReadUint64(data, entry + 8)))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool TextureContainer::SetDxgiFormat(const uint32 dxgiFormat)
+	{
+		switch (dxgiFormat)
+		{
+		case 2:		SetFormat(TextureFormat::Rgba, TextureFormat::Rgba32f, TextureDataType::Float); break;			// R32G32B32A32_FLOAT
+		case 6:		SetFormat(TextureFormat::Rgb, TextureFormat::Rgb32f, TextureDataType::Float); break;			// R32G32B32_FLOAT
+		case 28:	SetFormat(TextureFormat::Rgba, TextureFormat::Rgba, TextureDataType::UnsignedByte); break;		// R8G8B8A8_UNORM
+		case 49:	SetFormat(TextureFormat::Rg, TextureFormat::Rg, TextureDataType::UnsignedByte); break;			// R8G8_UNORM
+		case 71:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc1, TextureDataType::UnsignedByte); break;		// BC1_UNORM
+		case 72:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc1Srgb, TextureDataType::UnsignedByte); break;	// BC1_UNORM_SRGB
+		case 77:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc3, TextureDataType::UnsignedByte); break;		// BC3_UNORM
+		case 78:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc3Srgb, TextureDataType::UnsignedByte); break;	// BC3_UNORM_SRGB
+		case 80:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc4, TextureDataType::UnsignedByte); break;		// BC4_UNORM
+		case 83:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc5, TextureDataType::UnsignedByte); break;		// BC5_UNORM
+		case 95:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc6h, TextureDataType::Float); break;			// BC6H_UF16
+		case 98:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc7, TextureDataType::UnsignedByte); break;		// BC7_UNORM
+		case 99:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc7Srgb, TextureDataType::UnsignedByte); break;	// BC7_UNORM_SRGB
+
+		default:
+			return false;
+		}
+
+		return true;
+	}
+
+	bool TextureContainer::SetVulkanFormat(const uint32 vkFormat)
+	{
+		switch (vkFormat)
+		{
+		case 16:	SetFormat(TextureFormat::Rg, TextureFormat::Rg, TextureDataType::UnsignedByte); break;			// R8G8_UNORM
+		case 23:	SetFormat(TextureFormat::Rgb, TextureFormat::Rgb, TextureDataType::UnsignedByte); break;		// R8G8B8_UNORM
+		case 29:	SetFormat(TextureFormat::Rgb, TextureFormat::Srgb, TextureDataType::UnsignedByte); break;		// R8G8B8_SRGB
+		case 37:	SetFormat(TextureFormat::Rgba, TextureFormat::Rgba, TextureDataType::UnsignedByte); break;		// R8G8B8A8_UNORM
+		case 106:	SetFormat(TextureFormat::Rgb, TextureFormat::Rgb32f, TextureDataType::Float); break;			// R32G32B32_SFLOAT
+		case 109:	SetFormat(TextureFormat::Rgba, TextureFormat::Rgba32f, TextureDataType::Float); break;			// R32G32B32A32_SFLOAT
+		case 131:
+		case 133:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc1, TextureDataType::UnsignedByte); break;		// BC1_RGB(A)_UNORM_BLOCK
+		case 132:
+		case 134:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc1Srgb, TextureDataType::UnsignedByte); break;	// BC1_RGB(A)_SRGB_BLOCK
+		case 137:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc3, TextureDataType::UnsignedByte); break;		// BC3_UNORM_BLOCK
+		case 138:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc3Srgb, TextureDataType::UnsignedByte); break;	// BC3_SRGB_BLOCK
+		case 139:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc4, TextureDataType::UnsignedByte); break;		// BC4_UNORM_BLOCK
+		case 141:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc5, TextureDataType::UnsignedByte); break;		// BC5_UNORM_BLOCK
+		case 143:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc6h, TextureDataType::Float); break;			// BC6H_UFLOAT_BLOCK
+		case 145:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc7, TextureDataType::UnsignedByte); break;		// BC7_UNORM_BLOCK
+		case 146:	SetFormat(TextureFormat::Rgba, TextureFormat::Bc7Srgb, TextureDataType::UnsignedByte); break;	// BC7_SRGB_BLOCK
+
+		default:
+			return false;
+		}
+
+		return true;
+	}
+
+	void TextureContainer::SetFormat(const TextureFormat format, const TextureFormat internalFormat, const TextureDataType dataType)
+	{
+		Format = format;
+		InternalFormat = internalFormat;
+		DataType = dataType;
+	}
+
+	bool TextureContainer::IsSizeSupported() const
+	{
+		return Width && Height && Width <= MaxTextureSize && Height <= MaxTextureSize;
+	}
+
+	bool TextureContainer::AddLevel(const uint64 offset, const uint64 size)
+	{
+		const uint32 level = static_cast<uint32>(Levels.size());
+		if (level >= GetMipLevelCount(Width, Height))
+			return false;
+
+		TextureCreateInfo createInfo;
+		createInfo.Format = Format;
+		createInfo.InternalFormat = InternalFormat;
+		createInfo.DataType = DataType;
+
+		const uint32 width = GetMipLevelSize(Width, level);
+		const uint32 height = GetMipLevelSize(Height, level);
+
+		// Levels are uploaded in one call each, GL takes their size as 32 bit.
+		if (size != GetTextureLevelDataSize(width, height, createInfo) || size > std::numeric_limits<uint32>::max())
+			return false;
+
+		if (offset > File.GetSize() || size > File.GetSize() - offset)
+			return false;
+
+		TextureContainerLevel entry;
+		entry.Data = File.GetData() + offset;
+		entry.Size = static_cast<uint32>(size);
+		entry.Width = width;
+		entry.Height = height;
+
+		Levels.push_back(entry);
+		return true;
+	}
+
+}
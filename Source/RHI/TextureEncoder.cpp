@@ -0,0 +1,1008 @@
+#include "pch.h"
+
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+#include <glm/gtc/packing.hpp>
+
+#include "PBR/Core/Simd.h"
+#include "PBR/RHI/TextureEncoder.h"
+#include "PBR/RHI/TextureMipFilter.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureEncoderUtils /////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static constexpr uint32 BlockTexelCount = 16;
+
+	// Rows of blocks per task, small levels are encoded on the calling thread.
+	static constexpr uint32 MinBlockRowsPerChunk = 8;
+
+	// The 16 texels of a block, one array per channel. A row of the block fills one SSE2 register.
+	struct alignas(16) SourceBlock
+	{
+
+		float Channels[4][BlockTexelCount];
+
+	};
+
+#if ENGINE_SSE2
+	static float HorizontalSum(const __m128 value)
+	{
+		const __m128 pairs = _mm_add_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+	}
+
+	static float HorizontalMin(const __m128 value)
+	{
+		const __m128 pairs = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_min_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+	}
+
+	static float HorizontalMax(const __m128 value)
+	{
+		const __m128 pairs = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_max_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+	}
+
+	// Converts the 4 texels of a block row to floats and splits them into channels.
+	static void FetchBlockRow(const byte* texels, const uint32 channels, const uint32 row, SourceBlock& block)
+	{
+		// Copied, so rows of fewer than 4 channels are not read past their end.
+		alignas(16) byte bytes[16] = { };
+		std::memcpy(bytes, texels, 4 * channels);
+
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+		const __m128i low = _mm_unpacklo_epi8(packed, zero);
+		const __m128i high = _mm_unpackhi_epi8(packed, zero);
+
+		// The bytes of the row in order, still interleaved.
+		__m128 a = _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero));
+		__m128 b = _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero));
+		__m128 c = _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero));
+		__m128 d = _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero));
+
+		float* const target[4] = { block.Channels[0] + row * 4, block.Channels[1] + row * 4, block.Channels[2] + row * 4, block.Channels[3] + row * 4 };
+
+		switch (channels)
+		{
+		case 1:
+			_mm_store_ps(target[0], a);
+			break;
+
+		case 2:
+			_mm_store_ps(target[0], _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_store_ps(target[1], _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+			break;
+
+		case 3:
+		{
+			// a = r0 g0 b0 r1, b = g1 b1 r2 g2, c = b2 r3 g3 b3
+			const __m128 redHigh = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+			const __m128 greenLow = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1));
+			const __m128 greenHigh = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3));
+			const __m128 blueLow = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2));
+
+			_mm_store_ps(target[0], _mm_shuffle_ps(a, redHigh, _MM_SHUFFLE(2, 0, 3, 0)));
+			_mm_store_ps(target[1], _mm_shuffle_ps(greenLow, greenHigh, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_store_ps(target[2], _mm_shuffle_ps(blueLow, c, _MM_SHUFFLE(3, 0, 2, 0)));
+			break;
+		}
+
+		case 4:
+			_MM_TRANSPOSE4_PS(a, b, c, d);
+			_mm_store_ps(target[0], a);
+			_mm_store_ps(target[1], b);
+			_mm_store_ps(target[2], c);
+			_mm_store_ps(target[3], d);
+			break;
+
+		default: break;
+		}
+	}
+#endif
+
+	static void FetchBlock(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const uint32 blockX, const uint32 blockY, SourceBlock& block)
+	{
+		for (uint32 c = channels; c < 4; ++c)
+			std::fill(block.Channels[c], block.Channels[c] + BlockTexelCount, c == 3 ? 255.0f : 0.0f);
+
+#if ENGINE_SSE2
+		// Partial blocks at the edges repeat texels and are fetched one by one.
+		if (blockX * 4 + 4 <= width && blockY * 4 + 4 <= height)
+		{
+			for (uint32 row = 0; row < 4; ++row)
+				FetchBlockRow(pixels + ((blockY * 4 + row) * width + blockX * 4) * channels, channels, row, block);
+
+			return;
+		}
+#endif
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			const uint32 x = std::min(blockX * 4 + i % 4, width - 1);
+			const uint32 y = std::min(blockY * 4 + i / 4, height - 1);
+
+			const byte* texel = pixels + (y * width + x) * channels;
+
+			for (uint32 c = 0; c < channels; ++c)
+				block.Channels[c][i] = static_cast<float>(texel[c]);
+		}
+	}
+
+	// Bc6h is fit on the bit patterns of the half floats, which grow roughly with the logarithm of
+	// the value. Negative values and NaNs read as 0, the format is unsigned.
+	static void FetchHalfBlock(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const uint32 blockX, const uint32 blockY, SourceBlock& block)
+	{
+		const float maxHalf = 65504.0f;
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			const uint32 x = std::min(blockX * 4 + i % 4, width - 1);
+			const uint32 y = std::min(blockY * 4 + i / 4, height - 1);
+
+			const float* texel = pixels + (y * width + x) * channels;
+
+			for (uint32 c = 0; c < 3; ++c)
+			{
+				const float value = c < channels && texel[c] > 0.0f ? std::min(texel[c], maxHalf) : 0.0f;
+				block.Channels[c][i] = static_cast<float>(glm::packHalf1x16(value));
+			}
+		}
+	}
+
+	// Blocks are filled from the lowest bit of the first byte on.
+	static void WriteBits(byte* output, uint32& position, const uint32 value, const uint32 bits)
+	{
+		for (uint32 i = 0; i < bits; ++i, ++position)
+			output[position / 8] |= static_cast<byte>(((value >> i) & 1) << (position % 8));
+	}
+
+	// Endpoints at both ends of the texels projected onto the principal axis of the first Channels
+	// channels, endpoint0 at the larger projection.
+	template<uint32 Channels>
+	static void FitPrincipalAxis(const SourceBlock& block, float endpoint0[Channels], float endpoint1[Channels])
+	{
+		float mean[Channels] = { };
+		float minimum[Channels];
+		float maximum[Channels];
+		float covariance[Channels][Channels] = { };
+
+#if ENGINE_SSE2
+		// Offsets of the texels from the mean, four registers per channel.
+		__m128 offsets[Channels][4];
+
+		for (uint32 c = 0; c < Channels; ++c)
+		{
+			const __m128 texels[4] = { _mm_load_ps(block.Channels[c]), _mm_load_ps(block.Channels[c] + 4), _mm_load_ps(block.Channels[c] + 8), _mm_load_ps(block.Channels[c] + 12) };
+
+			mean[c] = HorizontalSum(_mm_add_ps(_mm_add_ps(texels[0], texels[1]), _mm_add_ps(texels[2], texels[3]))) / BlockTexelCount;
+			minimum[c] = HorizontalMin(_mm_min_ps(_mm_min_ps(texels[0], texels[1]), _mm_min_ps(texels[2], texels[3])));
+			maximum[c] = HorizontalMax(_mm_max_ps(_mm_max_ps(texels[0], texels[1]), _mm_max_ps(texels[2], texels[3])));
+
+			const __m128 meanVector = _mm_set1_ps(mean[c]);
+			for (uint32 q = 0; q < 4; ++q)
+				offsets[c][q] = _mm_sub_ps(texels[q], meanVector);
+		}
+
+		for (uint32 row = 0; row < Channels; ++row)
+		{
+			for (uint32 column = row; column < Channels; ++column)
+			{
+				__m128 sum = _mm_mul_ps(offsets[row][0], offsets[column][0]);
+				for (uint32 q = 1; q < 4; ++q)
+					sum = _mm_add_ps(sum, _mm_mul_ps(offsets[row][q], offsets[column][q]));
+
+				covariance[row][column] = HorizontalSum(sum);
+			}
+		}
+#else
+		for (uint32 c = 0; c < Channels; ++c)
+		{
+			minimum[c] = FLT_MAX;
+			maximum[c] = -FLT_MAX;
+
+			for (uint32 i = 0; i < BlockTexelCount; ++i)
+			{
+				mean[c] += block.Channels[c][i];
+				minimum[c] = std::min(minimum[c], block.Channels[c][i]);
+				maximum[c] = std::max(maximum[c], block.Channels[c][i]);
+			}
+
+			mean[c] /= BlockTexelCount;
+		}
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			float offset[Channels];
+			for (uint32 c = 0; c < Channels; ++c)
+				offset[c] = block.Channels[c][i] - mean[c];
+
+			for (uint32 row = 0; row < Channels; ++row)
+			{
+				for (uint32 column = row; column < Channels; ++column)
+					covariance[row][column] += offset[row] * offset[column];
+			}
+		}
+#endif
+
+		for (uint32 row = 1; row < Channels; ++row)
+		{
+			for (uint32 column = 0; column < row; ++column)
+				covariance[row][column] = covariance[column][row];
+		}
+
+		// Principal axis by power iteration, starting from the diagonal of the bounding box.
+		float axis[Channels];
+		for (uint32 c = 0; c < Channels; ++c)
+			axis[c] = maximum[c] - minimum[c];
+
+		for (uint32 iteration = 0; iteration < 4; ++iteration)
+		{
+			float product[Channels] = { };
+			float length = 0.0f;
+
+			for (uint32 row = 0; row < Channels; ++row)
+			{
+				for (uint32 column = 0; column < Channels; ++column)
+					product[row] += covariance[row][column] * axis[column];
+
+				length = std::max(length, std::abs(product[row]));
+			}
+
+			if (length < 1e-6f)
+				break;
+
+			for (uint32 c = 0; c < Channels; ++c)
+				axis[c] = product[c] / length;
+		}
+
+		float minProjection = FLT_MAX;
+		float maxProjection = -FLT_MAX;
+
+#if ENGINE_SSE2
+		__m128 minVector = _mm_set1_ps(FLT_MAX);
+		__m128 maxVector = _mm_set1_ps(-FLT_MAX);
+
+		for (uint32 q = 0; q < 4; ++q)
+		{
+			__m128 projection = _mm_mul_ps(offsets[0][q], _mm_set1_ps(axis[0]));
+			for (uint32 c = 1; c < Channels; ++c)
+				projection = _mm_add_ps(projection, _mm_mul_ps(offsets[c][q], _mm_set1_ps(axis[c])));
+
+			minVector = _mm_min_ps(minVector, projection);
+			maxVector = _mm_max_ps(maxVector, projection);
+		}
+
+		minProjection = HorizontalMin(minVector);
+		maxProjection = HorizontalMax(maxVector);
+#else
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			float projection = 0.0f;
+			for (uint32 c = 0; c < Channels; ++c)
+				projection += (block.Channels[c][i] - mean[c]) * axis[c];
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+#endif
+
+		float axisLengthSquared = 0.0f;
+		for (uint32 c = 0; c < Channels; ++c)
+			axisLengthSquared += axis[c] * axis[c];
+
+		if (axisLengthSquared > 0.0f)
+		{
+			minProjection /= axisLengthSquared;
+			maxProjection /= axisLengthSquared;
+		}
+
+		for (uint32 c = 0; c < Channels; ++c)
+		{
+			endpoint0[c] = mean[c] + axis[c] * maxProjection;
+			endpoint1[c] = mean[c] + axis[c] * minProjection;
+		}
+	}
+
+	// Endpoints minimizing the squared error for the given indices, weights holds the share of
+	// endpoint0 for every index. False if the indices do not constrain both endpoints.
+	template<uint32 Channels>
+	static bool RefitEndpoints(const SourceBlock& block, const uint32 indices[BlockTexelCount], const float* weights, float endpoint0[Channels], float endpoint1[Channels])
+	{
+		float aa = 0.0f;
+		float ab = 0.0f;
+		float bb = 0.0f;
+		float ax[Channels] = { };
+		float bx[Channels] = { };
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			const float a = weights[indices[i]];
+			const float b = 1.0f - a;
+
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+
+			for (uint32 c = 0; c < Channels; ++c)
+			{
+				ax[c] += a * block.Channels[c][i];
+				bx[c] += b * block.Channels[c][i];
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		for (uint32 c = 0; c < Channels; ++c)
+		{
+			endpoint0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+			endpoint1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+		}
+
+		return true;
+	}
+
+	static uint16 PackColor565(const float r, const float g, const float b)
+	{
+		const uint32 r5 = static_cast<uint32>(std::clamp(r, 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+		const uint32 g6 = static_cast<uint32>(std::clamp(g, 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+		const uint32 b5 = static_cast<uint32>(std::clamp(b, 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+
+		return static_cast<uint16>((r5 << 11) | (g6 << 5) | b5);
+	}
+
+	static void UnpackColor565(const uint16 color, float rgb[3])
+	{
+		const uint32 r5 = (color >> 11) & 31;
+		const uint32 g6 = (color >> 5) & 63;
+		const uint32 b5 = color & 31;
+
+		rgb[0] = static_cast<float>((r5 << 3) | (r5 >> 2));
+		rgb[1] = static_cast<float>((g6 << 2) | (g6 >> 4));
+		rgb[2] = static_cast<float>((b5 << 3) | (b5 >> 2));
+	}
+
+	// Picks the palette color closest to the projection of every texel onto the line between the
+	// endpoints, returns the squared error.
+	static float SelectColorIndices(const SourceBlock& block, const uint16 color0, const uint16 color1, uint32 indices[BlockTexelCount])
+	{
+		// Palette entries ordered from color1 to color0.
+		static const uint32 RampIndices[4] = { 1, 3, 2, 0 };
+
+		float palette[4][3];
+		UnpackColor565(color0, palette[0]);
+		UnpackColor565(color1, palette[1]);
+
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+
+		const float direction[3] = { palette[0][0] - palette[1][0], palette[0][1] - palette[1][1], palette[0][2] - palette[1][2] };
+		const float lengthSquared = direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2];
+		const float scale = lengthSquared > 0.0f ? 3.0f / lengthSquared : 0.0f;
+
+#if ENGINE_SSE2
+		// Four texels at a time, the palette color of every step is selected with masks.
+		const __m128i stepValues[4] = { _mm_set1_epi32(0), _mm_set1_epi32(1), _mm_set1_epi32(2), _mm_set1_epi32(3) };
+
+		alignas(16) int32 steps[BlockTexelCount];
+		__m128 errors = _mm_setzero_ps();
+
+		for (uint32 i = 0; i < BlockTexelCount; i += 4)
+		{
+			__m128 projection = _mm_setzero_ps();
+			for (uint32 c = 0; c < 3; ++c)
+				projection = _mm_add_ps(projection, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(block.Channels[c] + i), _mm_set1_ps(palette[1][c])), _mm_set1_ps(direction[c])));
+
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(projection, _mm_set1_ps(scale)), _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(3.0f));
+			const __m128i step = _mm_cvttps_epi32(clamped);
+			_mm_store_si128(reinterpret_cast<__m128i*>(steps + i), step);
+
+			for (uint32 c = 0; c < 3; ++c)
+			{
+				__m128 color = _mm_setzero_ps();
+				for (uint32 s = 0; s < 4; ++s)
+				{
+					const __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(step, stepValues[s]));
+					color = _mm_or_ps(color, _mm_and_ps(mask, _mm_set1_ps(palette[RampIndices[s]][c])));
+				}
+
+				const __m128 difference = _mm_sub_ps(_mm_load_ps(block.Channels[c] + i), color);
+				errors = _mm_add_ps(errors, _mm_mul_ps(difference, difference));
+			}
+		}
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+			indices[i] = RampIndices[steps[i]];
+
+		return HorizontalSum(errors);
+#else
+		float error = 0.0f;
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			const float projection =
+				(block.Channels[0][i] - palette[1][0]) * direction[0] +
+				(block.Channels[1][i] - palette[1][1]) * direction[1] +
+				(block.Channels[2][i] - palette[1][2]) * direction[2];
+
+			const uint32 step = static_cast<uint32>(std::clamp(projection * scale + 0.5f, 0.0f, 3.0f));
+			indices[i] = RampIndices[step];
+
+			const float* color = palette[indices[i]];
+			const float dr = block.Channels[0][i] - color[0];
+			const float dg = block.Channels[1][i] - color[1];
+			const float db = block.Channels[2][i] - color[2];
+
+			error += dr * dr + dg * dg + db * db;
+		}
+
+		return error;
+#endif
+	}
+
+	// 4 color mode, color0 has to be larger than color1. Bc3 always decodes the color block this way.
+	static void EncodeColorBlock(const SourceBlock& block, byte* output)
+	{
+		float endpoint0[3];
+		float endpoint1[3];
+		FitPrincipalAxis<3>(block, endpoint0, endpoint1);
+
+		uint16 color0 = PackColor565(endpoint0[0], endpoint0[1], endpoint0[2]);
+		uint16 color1 = PackColor565(endpoint1[0], endpoint1[1], endpoint1[2]);
+
+		// Share of color0 in the palette entries.
+		static const float Weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		uint32 indices[BlockTexelCount];
+		float error = SelectColorIndices(block, color0, color1, indices);
+
+		if (error > 0.0f && RefitEndpoints<3>(block, indices, Weights, endpoint0, endpoint1))
+		{
+			const uint16 refitColor0 = PackColor565(endpoint0[0], endpoint0[1], endpoint0[2]);
+			const uint16 refitColor1 = PackColor565(endpoint1[0], endpoint1[1], endpoint1[2]);
+
+			uint32 refitIndices[BlockTexelCount];
+			const float refitError = SelectColorIndices(block, refitColor0, refitColor1, refitIndices);
+
+			if (refitError < error)
+			{
+				color0 = refitColor0;
+				color1 = refitColor1;
+				std::copy(refitIndices, refitIndices + BlockTexelCount, indices);
+			}
+		}
+
+		// Swapping the endpoints swaps indices 0 and 1 as well as 2 and 3.
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+
+			for (uint32 i = 0; i < BlockTexelCount; ++i)
+				indices[i] ^= 1;
+		}
+		else if (color0 == color1)
+		{
+			std::fill(indices, indices + BlockTexelCount, 0u);
+		}
+
+		uint32 packedIndices = 0;
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+			packedIndices |= indices[i] << (i * 2);
+
+		output[0] = static_cast<byte>(color0 & 0xFF);
+		output[1] = static_cast<byte>(color0 >> 8);
+		output[2] = static_cast<byte>(color1 & 0xFF);
+		output[3] = static_cast<byte>(color1 >> 8);
+
+		for (uint32 i = 0; i < 4; ++i)
+			output[4 + i] = static_cast<byte>(packedIndices >> (i * 8));
+	}
+
+	// 8 value mode, endpoint0 is the maximum and endpoint1 the minimum of the channel.
+	static void EncodeChannelBlock(const float values[BlockTexelCount], byte* output)
+	{
+		float minimum = 255.0f;
+		float maximum = 0.0f;
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			minimum = std::min(minimum, values[i]);
+			maximum = std::max(maximum, values[i]);
+		}
+
+		const byte endpoint0 = static_cast<byte>(maximum + 0.5f);
+		const byte endpoint1 = static_cast<byte>(minimum + 0.5f);
+
+		output[0] = endpoint0;
+		output[1] = endpoint1;
+
+		uint64 packedIndices = 0;
+
+		if (endpoint0 > endpoint1)
+		{
+			// Palette entries ordered from endpoint0 to endpoint1, the values are evenly spaced.
+			static const uint64 RampIndices[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+			const float scale = 7.0f / (endpoint0 - endpoint1);
+
+			for (uint32 i = 0; i < BlockTexelCount; ++i)
+			{
+				const uint32 step = static_cast<uint32>(std::clamp((endpoint0 - values[i]) * scale + 0.5f, 0.0f, 7.0f));
+				packedIndices |= RampIndices[step] << (i * 3);
+			}
+		}
+
+		for (uint32 i = 0; i < 6; ++i)
+			output[2 + i] = static_cast<byte>(packedIndices >> (i * 8));
+	}
+
+	// Interpolation weights of 4 bit indices in 64ths, shared by Bc6h and Bc7. Symmetric, index 15 - i
+	// weighs the endpoints like index i with the endpoints swapped.
+	static const uint32 IndexWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	static uint32 InterpolateEndpoints(const uint32 endpoint0, const uint32 endpoint1, const uint32 index)
+	{
+		return ((64 - IndexWeights[index]) * endpoint0 + IndexWeights[index] * endpoint1 + 32) >> 6;
+	}
+
+	// Picks the closest of the 16 palette entries for every texel, returns the squared error. The
+	// entries are evenly spaced enough that only the neighbours of the projection are compared.
+	template<uint32 Channels>
+	static float SelectIndices(const SourceBlock& block, const float palette[16][4], uint32 indices[BlockTexelCount])
+	{
+		float direction[Channels];
+		float lengthSquared = 0.0f;
+
+		for (uint32 c = 0; c < Channels; ++c)
+		{
+			direction[c] = palette[15][c] - palette[0][c];
+			lengthSquared += direction[c] * direction[c];
+		}
+
+		const float scale = lengthSquared > 0.0f ? 15.0f / lengthSquared : 0.0f;
+
+		float error = 0.0f;
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+		{
+			float projection = 0.0f;
+			for (uint32 c = 0; c < Channels; ++c)
+				projection += (block.Channels[c][i] - palette[0][c]) * direction[c];
+
+			const uint32 step = static_cast<uint32>(std::clamp(projection * scale + 0.5f, 0.0f, 15.0f));
+
+			float bestError = FLT_MAX;
+			for (uint32 index = step > 0 ? step - 1 : 0; index <= std::min(step + 1, 15u); ++index)
+			{
+				float texelError = 0.0f;
+				for (uint32 c = 0; c < Channels; ++c)
+				{
+					const float difference = block.Channels[c][i] - palette[index][c];
+					texelError += difference * difference;
+				}
+
+				if (texelError < bestError)
+				{
+					bestError = texelError;
+					indices[i] = index;
+				}
+			}
+
+			error += bestError;
+		}
+
+		return error;
+	}
+
+	// The 7 bit channels of a Bc7 endpoint share one extra low bit, the one closer to the endpoint is
+	// picked.
+	static void QuantizeBc7Endpoint(const float endpoint[4], uint32 channels[4], uint32& pBit)
+	{
+		float bestError = FLT_MAX;
+
+		for (uint32 p = 0; p < 2; ++p)
+		{
+			uint32 candidate[4];
+			float error = 0.0f;
+
+			for (uint32 c = 0; c < 4; ++c)
+			{
+				candidate[c] = static_cast<uint32>(std::clamp((endpoint[c] - p) * 0.5f + 0.5f, 0.0f, 127.0f));
+
+				const float difference = endpoint[c] - static_cast<float>(candidate[c] * 2 + p);
+				error += difference * difference;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				pBit = p;
+				std::copy(candidate, candidate + 4, channels);
+			}
+		}
+	}
+
+	static float SelectBc7Indices(const SourceBlock& block, const uint32 endpoints[2][4], const uint32 pBits[2], uint32 indices[BlockTexelCount])
+	{
+		float palette[16][4];
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			const uint32 endpoint0 = (endpoints[0][c] << 1) | pBits[0];
+			const uint32 endpoint1 = (endpoints[1][c] << 1) | pBits[1];
+
+			for (uint32 index = 0; index < 16; ++index)
+				palette[index][c] = static_cast<float>(InterpolateEndpoints(endpoint0, endpoint1, index));
+		}
+
+		return SelectIndices<4>(block, palette, indices);
+	}
+
+	// Mode 6, a single subset with 7 bit RGBA endpoints plus a low bit per endpoint and 4 bit indices.
+	// The most significant index bit of the first texel is implied 0.
+	static void EncodeBc7Block(const SourceBlock& block, byte* output)
+	{
+		float endpoint0[4];
+		float endpoint1[4];
+		FitPrincipalAxis<4>(block, endpoint0, endpoint1);
+
+		uint32 endpoints[2][4];
+		uint32 pBits[2];
+		QuantizeBc7Endpoint(endpoint0, endpoints[0], pBits[0]);
+		QuantizeBc7Endpoint(endpoint1, endpoints[1], pBits[1]);
+
+		uint32 indices[BlockTexelCount];
+		const float error = SelectBc7Indices(block, endpoints, pBits, indices);
+
+		float weights[16];
+		for (uint32 index = 0; index < 16; ++index)
+			weights[index] = (64 - IndexWeights[index]) / 64.0f;
+
+		if (error > 0.0f && RefitEndpoints<4>(block, indices, weights, endpoint0, endpoint1))
+		{
+			uint32 refitEndpoints[2][4];
+			uint32 refitPBits[2];
+			QuantizeBc7Endpoint(endpoint0, refitEndpoints[0], refitPBits[0]);
+			QuantizeBc7Endpoint(endpoint1, refitEndpoints[1], refitPBits[1]);
+
+			uint32 refitIndices[BlockTexelCount];
+			const float refitError = SelectBc7Indices(block, refitEndpoints, refitPBits, refitIndices);
+
+			if (refitError < error)
+			{
+				std::copy(&refitEndpoints[0][0], &refitEndpoints[0][0] + 8, &endpoints[0][0]);
+				std::copy(refitPBits, refitPBits + 2, pBits);
+				std::copy(refitIndices, refitIndices + BlockTexelCount, indices);
+			}
+		}
+
+		if (indices[0] >= 8)
+		{
+			std::swap(endpoints[0], endpoints[1]);
+			std::swap(pBits[0], pBits[1]);
+
+			for (uint32 i = 0; i < BlockTexelCount; ++i)
+				indices[i] = 15 - indices[i];
+		}
+
+		std::fill(output, output + 16, static_cast<byte>(0));
+
+		uint32 position = 0;
+		WriteBits(output, position, 1 << 6, 7);
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			WriteBits(output, position, endpoints[0][c], 7);
+			WriteBits(output, position, endpoints[1][c], 7);
+		}
+
+		WriteBits(output, position, pBits[0], 1);
+		WriteBits(output, position, pBits[1], 1);
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+			WriteBits(output, position, indices[i], i == 0 ? 3 : 4);
+	}
+
+	// 10 bit endpoints are unquantized to 16 bit, interpolated and scaled by 31 / 64 to the bits of a
+	// half float, at most 0x7BFF.
+	static uint32 UnquantizeBc6hEndpoint(const uint32 endpoint)
+	{
+		if (endpoint == 0)
+			return 0;
+
+		return endpoint == 1023 ? 0xFFFF : (endpoint << 6) + 32;
+	}
+
+	static uint32 QuantizeBc6hEndpoint(const float half)
+	{
+		return static_cast<uint32>(std::clamp((half - 15.5f) / 31.0f + 0.5f, 0.0f, 1023.0f));
+	}
+
+	static float SelectBc6hIndices(const SourceBlock& block, const uint32 endpoints[2][3], uint32 indices[BlockTexelCount])
+	{
+		float palette[16][4];
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			const uint32 endpoint0 = UnquantizeBc6hEndpoint(endpoints[0][c]);
+			const uint32 endpoint1 = UnquantizeBc6hEndpoint(endpoints[1][c]);
+
+			for (uint32 index = 0; index < 16; ++index)
+				palette[index][c] = static_cast<float>((InterpolateEndpoints(endpoint0, endpoint1, index) * 31) >> 6);
+		}
+
+		return SelectIndices<3>(block, palette, indices);
+	}
+
+	// Mode 11 of the unsigned format, a single region with untransformed 10 bit endpoints and 4 bit
+	// indices. The most significant index bit of the first texel is implied 0.
+	static void EncodeBc6hBlock(const SourceBlock& block, byte* output)
+	{
+		float endpoint0[3];
+		float endpoint1[3];
+		FitPrincipalAxis<3>(block, endpoint0, endpoint1);
+
+		uint32 endpoints[2][3];
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			endpoints[0][c] = QuantizeBc6hEndpoint(endpoint0[c]);
+			endpoints[1][c] = QuantizeBc6hEndpoint(endpoint1[c]);
+		}
+
+		uint32 indices[BlockTexelCount];
+		const float error = SelectBc6hIndices(block, endpoints, indices);
+
+		float weights[16];
+		for (uint32 index = 0; index < 16; ++index)
+			weights[index] = (64 - IndexWeights[index]) / 64.0f;
+
+		if (error > 0.0f && RefitEndpoints<3>(block, indices, weights, endpoint0, endpoint1))
+		{
+			uint32 refitEndpoints[2][3];
+			for (uint32 c = 0; c < 3; ++c)
+			{
+				refitEndpoints[0][c] = QuantizeBc6hEndpoint(endpoint0[c]);
+				refitEndpoints[1][c] = QuantizeBc6hEndpoint(endpoint1[c]);
+			}
+
+			uint32 refitIndices[BlockTexelCount];
+			const float refitError = SelectBc6hIndices(block, refitEndpoints, refitIndices);
+
+			if (refitError < error)
+			{
+				std::copy(&refitEndpoints[0][0], &refitEndpoints[0][0] + 6, &endpoints[0][0]);
+				std::copy(refitIndices, refitIndices + BlockTexelCount, indices);
+			}
+		}
+
+		if (indices[0] >= 8)
+		{
+			std::swap(endpoints[0], endpoints[1]);
+
+			for (uint32 i = 0; i < BlockTexelCount; ++i)
+				indices[i] = 15 - indices[i];
+		}
+
+		std::fill(output, output + 16, static_cast<byte>(0));
+
+		uint32 position = 0;
+		WriteBits(output, position, 0x03, 5);
+
+		for (uint32 e = 0; e < 2; ++e)
+		{
+			for (uint32 c = 0; c < 3; ++c)
+				WriteBits(output, position, endpoints[e][c], 10);
+		}
+
+		for (uint32 i = 0; i < BlockTexelCount; ++i)
+			WriteBits(output, position, indices[i], i == 0 ? 3 : 4);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureEncoder //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool TextureEncoder::CanEncode(const TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::Bc1:
+		case TextureFormat::Bc1Srgb:
+		case TextureFormat::Bc3:
+		case TextureFormat::Bc3Srgb:
+		case TextureFormat::Bc4:
+		case TextureFormat::Bc5:
+		case TextureFormat::Bc6h:
+		case TextureFormat::Bc7:
+		case TextureFormat::Bc7Srgb:		return true;
+
+		default: break;
+		}
+
+		return false;
+	}
+
+	uint32 TextureEncoder::GetSourceChannelCount(const TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::Bc3:
+		case TextureFormat::Bc3Srgb:
+		case TextureFormat::Bc7:
+		case TextureFormat::Bc7Srgb:		return 4;
+
+		default: break;
+		}
+
+		return 3;
+	}
+
+	TextureDataType TextureEncoder::GetSourceDataType(const TextureFormat format)
+	{
+		return format == TextureFormat::Bc6h ? TextureDataType::Float : TextureDataType::UnsignedByte;
+	}
+
+	void TextureEncoder::Encode(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format, byte* output, ThreadPool* pool)
+	{
+		assert(CanEncode(format)); // "No CPU encoder for the texture format."
+		assert(GetSourceDataType(format) == TextureDataType::UnsignedByte); // "The texture format is encoded from float images."
+
+		const uint32 blockRows = (height + 3) / 4;
+
+		if (!pool)
+		{
+			EncodeBlockRows(pixels, width, height, channels, format, 0, blockRows, output);
+			return;
+		}
+
+		pool->ParallelFor(blockRows, MinBlockRowsPerChunk, [&](const uint32 begin, const uint32 end, const uint32 chunk)
+		{
+			EncodeBlockRows(pixels, width, height, channels, format, begin, end, output);
+		});
+	}
+
+	void TextureEncoder::Encode(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format, byte* output, ThreadPool* pool)
+	{
+		assert(GetSourceDataType(format) == TextureDataType::Float); // "The texture format is encoded from 8 bit images."
+
+		const uint32 blockRows = (height + 3) / 4;
+
+		if (!pool)
+		{
+			EncodeBlockRows(pixels, width, height, channels, format, 0, blockRows, output);
+			return;
+		}
+
+		pool->ParallelFor(blockRows, MinBlockRowsPerChunk, [&](const uint32 begin, const uint32 end, const uint32 chunk)
+		{
+			EncodeBlockRows(pixels, width, height, channels, format, begin, end, output);
+		});
+	}
+
+	void TextureEncoder::EncodeMipChain(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+		const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool)
+	{
+		TextureMipFilter::GenerateMipChain(pixels, width, height, channels, IsSrgbTextureFormat(format), firstMip, endMip, levels, pool);
+
+		if (!IsCompressedTextureFormat(format))
+			return;
+
+		std::vector<byte> encoded;
+		for (uint32 mip = firstMip; mip < endMip; ++mip)
+		{
+			const uint32 levelWidth = GetMipLevelSize(width, mip);
+			const uint32 levelHeight = GetMipLevelSize(height, mip);
+
+			encoded.resize(static_cast<size_t>(GetTextureLevelSize(levelWidth, levelHeight, format)));
+			Encode(levels[mip - firstMip].data(), levelWidth, levelHeight, channels, format, encoded.data(), pool);
+
+			levels[mip - firstMip].swap(encoded);
+		}
+	}
+
+	void TextureEncoder::EncodeMipChain(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+		const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool)
+	{
+		std::vector<std::vector<float>> filtered;
+		TextureMipFilter::GenerateMipChain(pixels, width, height, channels, firstMip, endMip, filtered, pool);
+
+		levels.resize(endMip - firstMip);
+
+		for (uint32 mip = firstMip; mip < endMip; ++mip)
+		{
+			const std::vector<float>& level = filtered[mip - firstMip];
+
+			if (!IsCompressedTextureFormat(format))
+			{
+				const byte* data = reinterpret_cast<const byte*>(level.data());
+				levels[mip - firstMip].assign(data, data + level.size() * sizeof(float));
+				continue;
+			}
+
+			const uint32 levelWidth = GetMipLevelSize(width, mip);
+			const uint32 levelHeight = GetMipLevelSize(height, mip);
+
+			levels[mip - firstMip].resize(static_cast<size_t>(GetTextureLevelSize(levelWidth, levelHeight, format)));
+			Encode(level.data(), levelWidth, levelHeight, channels, format, levels[mip - firstMip].data(), pool);
+		}
+	}
+
+	void TextureEncoder::EncodeBlockRows(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+		const uint32 beginRow, const uint32 endRow, byte* output)
+	{
+		const uint32 blockColumns = (width + 3) / 4;
+		const uint32 blockSize = GetTextureBlockSize(format);
+
+		SourceBlock block;
+
+		for (uint32 blockY = beginRow; blockY < endRow; ++blockY)
+		{
+			byte* target = output + static_cast<size_t>(blockY) * blockColumns * blockSize;
+
+			for (uint32 blockX = 0; blockX < blockColumns; ++blockX, target += blockSize)
+			{
+				FetchBlock(pixels, width, height, channels, blockX, blockY, block);
+
+				switch (format)
+				{
+				case TextureFormat::Bc1:
+				case TextureFormat::Bc1Srgb:
+					EncodeColorBlock(block, target);
+					break;
+
+				case TextureFormat::Bc3:
+				case TextureFormat::Bc3Srgb:
+					EncodeChannelBlock(block.Channels[3], target);
+					EncodeColorBlock(block, target + 8);
+					break;
+
+				case TextureFormat::Bc4:
+					EncodeChannelBlock(block.Channels[0], target);
+					break;
+
+				case TextureFormat::Bc5:
+					EncodeChannelBlock(block.Channels[0], target);
+					EncodeChannelBlock(block.Channels[1], target + 8);
+					break;
+
+				case TextureFormat::Bc7:
+				case TextureFormat::Bc7Srgb:
+					EncodeBc7Block(block, target);
+					break;
+
+				default: break;
+				}
+			}
+		}
+	}
+
+	void TextureEncoder::EncodeBlockRows(const float* pixels, const uint32 width, const uint32 height, const uint32 channels, const TextureFormat format,
+		const uint32 beginRow, const uint32 endRow, byte* output)
+	{
+		const uint32 blockColumns = (width + 3) / 4;
+		const uint32 blockSize = GetTextureBlockSize(format);
+
+		SourceBlock block;
+
+		for (uint32 blockY = beginRow; blockY < endRow; ++blockY)
+		{
+			byte* target = output + static_cast<size_t>(blockY) * blockColumns * blockSize;
+
+			for (uint32 blockX = 0; blockX < blockColumns; ++blockX, target += blockSize)
+			{
+				FetchHalfBlock(pixels, width, height, channels, blockX, blockY, block);
+				EncodeBc6hBlock(block, target);
+			}
+		}
+	}
+
+}
@@ -0,0 +1,464 @@
+#include "pch.h"
+
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#include "PBR/Core/Simd.h"
+#include "PBR/RHI/TextureMipFilter.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureMipFilterUtils ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Rows per task, small levels are filtered on the calling thread.
+	static constexpr uint32 MinRowsPerChunk = 32;
+
+	// Taps of a kernel halving the size.
+	static constexpr uint32 HalvingTapCount = static_cast<uint32>(4.0f * TextureMipFilter::KernelRadius) + 1;
+
+	// Linear values are quantized to this many steps before they are converted to sRGB, fine enough
+	// to be exact for all but the darkest 8 bit values.
+	static constexpr uint32 LinearToSrgbSize = 16384;
+
+	static float SrgbToLinear(const float value)
+	{
+		return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	static float LinearToSrgb(const float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	struct ColorTables
+	{
+
+		ColorTables()
+		{
+			for (uint32 i = 0; i < 256; ++i)
+			{
+				UnormToFloat[i] = i / 255.0f;
+				SrgbToFloat[i] = SrgbToLinear(i / 255.0f);
+			}
+
+			for (uint32 i = 0; i < LinearToSrgbSize; ++i)
+				FloatToSrgb[i] = static_cast<byte>(LinearToSrgb(i / float(LinearToSrgbSize - 1)) * 255.0f + 0.5f);
+		}
+
+		float UnormToFloat[256];
+		float SrgbToFloat[256];
+		byte FloatToSrgb[LinearToSrgbSize];
+
+	};
+
+	static const ColorTables& GetColorTables()
+	{
+		static const ColorTables tables;
+		return tables;
+	}
+
+	// Modified Bessel function of the first kind, the series converges quickly for the alphas used.
+	static float BesselI0(const float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+
+		for (uint32 k = 1; k < 32; ++k)
+		{
+			const float factor = x / (2.0f * k);
+			term *= factor * factor;
+			sum += term;
+
+			if (term < sum * 1e-7f)
+				break;
+		}
+
+		return sum;
+	}
+
+	// Distance in texels of the smaller level.
+	static float EvaluateKernel(const float distance)
+	{
+		const float radius = TextureMipFilter::KernelRadius;
+		if (std::abs(distance) >= radius)
+			return 0.0f;
+
+		const float pi = 3.14159265358979f;
+		const float sinc = distance == 0.0f ? 1.0f : std::sin(pi * distance) / (pi * distance);
+
+		const float ratio = distance / radius;
+		const float window = BesselI0(TextureMipFilter::KaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / BesselI0(TextureMipFilter::KaiserAlpha);
+
+		return sinc * window;
+	}
+
+	static int32 FloorHalf(const int32 value)
+	{
+		return (value - (value < 0 ? 1 : 0)) / 2;
+	}
+
+	template<typename TTask>
+	static void ForEachRow(ThreadPool* pool, const uint32 rowCount, const TTask& task)
+	{
+		if (pool)
+			pool->ParallelFor(rowCount, MinRowsPerChunk, [&task](const uint32 begin, const uint32 end, const uint32 chunk) { task(begin, end); });
+		else
+			task(0, rowCount);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureMipFilter ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TextureMipFilter::GenerateMipChain(const byte* pixels, const uint32 width, const uint32 height, const uint32 channels, const bool srgb,
+		const uint32 firstMip, const uint32 endMip, std::vector<std::vector<byte>>& levels, ThreadPool* pool)
+	{
+		assert(channels >= 1 && channels <= 4); // "Unsupported channel count."
+
+		const ColorTables& tables = GetColorTables();
+
+		const float* decode[4];
+		for (uint32 c = 0; c < 4; ++c)
+			decode[c] = srgb && c < 3 ? tables.SrgbToFloat : tables.UnormToFloat;
+
+		levels.resize(endMip - firstMip);
+
+		if (firstMip == 0 && endMip > 0)
+			levels[0].assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+
+		std::vector<float> level;
+		std::vector<float> nextLevel;
+		std::vector<float> scratch;
+
+		for (uint32 mip = 1; mip < endMip; ++mip)
+		{
+			const uint32 sourceWidth = GetMipLevelSize(width, mip - 1);
+			const uint32 sourceHeight = GetMipLevelSize(height, mip - 1);
+			const uint32 levelWidth = GetMipLevelSize(width, mip);
+			const uint32 levelHeight = GetMipLevelSize(height, mip);
+
+			// Level 0 is decoded while it is filtered, it is never held as floats.
+			if (mip == 1)
+				Downsample(pixels, sourceWidth, sourceHeight, channels, decode, scratch, nextLevel, levelWidth, levelHeight, pool);
+			else
+				Downsample(level.data(), sourceWidth, sourceHeight, channels, decode, scratch, nextLevel, levelWidth, levelHeight, pool);
+
+			level.swap(nextLevel);
+
+			if (mip >= firstMip)
+				WriteLevel(level.data(), levelWidth * levelHeight, channels, srgb, levels[mip - firstMip]);
+		}
+	}
+
+	void TextureMipFilter::GenerateMipChain(const float* pixels, const uint32 width, const uint32 height, const uint32 channels,
+		const uint32 firstMip, const uint32 endMip, std::vector<std::vector<float>>& levels, ThreadPool* pool)
+	{
+		assert(channels >= 1 && channels <= 4); // "Unsupported channel count."
+
+		levels.resize(endMip - firstMip);
+
+		if (firstMip == 0 && endMip > 0)
+			levels[0].assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+
+		std::vector<float> level;
+		std::vector<float> nextLevel;
+		std::vector<float> scratch;
+
+		for (uint32 mip = 1; mip < endMip; ++mip)
+		{
+			const uint32 sourceWidth = GetMipLevelSize(width, mip - 1);
+			const uint32 sourceHeight = GetMipLevelSize(height, mip - 1);
+			const uint32 levelWidth = GetMipLevelSize(width, mip);
+			const uint32 levelHeight = GetMipLevelSize(height, mip);
+
+			Downsample(mip == 1 ? pixels : level.data(), sourceWidth, sourceHeight, channels, nullptr, scratch, nextLevel, levelWidth, levelHeight, pool);
+			level.swap(nextLevel);
+
+			// Like 8 bit levels, the next level is filtered from the unclamped values.
+			if (mip >= firstMip)
+			{
+				std::vector<float>& target = levels[mip - firstMip];
+				target.resize(level.size());
+
+				for (size_t i = 0; i < level.size(); ++i)
+					target[i] = std::max(level[i], 0.0f);
+			}
+		}
+	}
+
+	void TextureMipFilter::ComputeTaps(const uint32 sourceSize, const uint32 targetSize, FilterTaps& taps)
+	{
+		const float scale = sourceSize / float(targetSize);
+		const float support = KernelRadius * scale;
+
+		taps.TapCount = static_cast<uint32>(std::ceil(2.0f * support)) + 1;
+		taps.Indices.resize(static_cast<size_t>(targetSize) * taps.TapCount);
+		taps.Weights.resize(static_cast<size_t>(targetSize) * taps.TapCount);
+
+		taps.bIsHalving = sourceSize == 2 * targetSize;
+		taps.FirstTap = static_cast<int32>(std::floor(0.5f * scale - support));
+
+		for (uint32 i = 0; i < targetSize; ++i)
+		{
+			uint32* indices = &taps.Indices[static_cast<size_t>(i) * taps.TapCount];
+			float* weights = &taps.Weights[static_cast<size_t>(i) * taps.TapCount];
+
+			const float center = (i + 0.5f) * scale;
+			const int32 first = static_cast<int32>(std::floor(center - support));
+
+			float sum = 0.0f;
+			for (uint32 t = 0; t < taps.TapCount; ++t)
+			{
+				const int32 index = first + static_cast<int32>(t);
+
+				indices[t] = static_cast<uint32>(std::clamp(index, 0, static_cast<int32>(sourceSize) - 1));
+				weights[t] = EvaluateKernel((index + 0.5f - center) / scale);
+
+				sum += weights[t];
+			}
+
+			for (uint32 t = 0; t < taps.TapCount; ++t)
+				weights[t] /= sum;
+		}
+	}
+
+	template<typename T>
+	void TextureMipFilter::Downsample(const T* source, const uint32 width, const uint32 height, const uint32 channels, const float* const* decode,
+		std::vector<float>& scratch, std::vector<float>& target, const uint32 targetWidth, const uint32 targetHeight, ThreadPool* pool)
+	{
+		FilterTaps columnTaps;
+		FilterTaps rowTaps;
+
+		ComputeTaps(height, targetHeight, columnTaps);
+		ComputeTaps(width, targetWidth, rowTaps);
+
+		const size_t rowLength = static_cast<size_t>(width) * channels;
+		const size_t targetRowLength = static_cast<size_t>(targetWidth) * channels;
+
+		scratch.resize(targetRowLength * height);
+		target.resize(targetRowLength * targetHeight);
+
+		// Rows first, 8 bit rows are decoded once instead of for every tap reading them.
+		ForEachRow(pool, height, [&](const uint32 begin, const uint32 end)
+		{
+			std::vector<float> phases;
+			std::vector<float> decoded;
+			if constexpr (!std::is_same<T, float>::value)
+				decoded.resize(rowLength);
+
+			for (uint32 y = begin; y < end; ++y)
+			{
+				const float* input = nullptr;
+
+				if constexpr (std::is_same<T, float>::value)
+				{
+					input = source + y * rowLength;
+				}
+				else
+				{
+					const T* row = source + y * rowLength;
+					for (size_t i = 0; i < rowLength; i += channels)
+					{
+						for (uint32 c = 0; c < channels; ++c)
+							decoded[i + c] = decode[c][row[i + c]];
+					}
+
+					input = decoded.data();
+				}
+
+				float* output = scratch.data() + y * targetRowLength;
+
+				if (rowTaps.bIsHalving)
+				{
+					switch (channels)
+					{
+					case 1: FilterRowHalving<1>(input, width, rowTaps, targetWidth, phases, output); break;
+					case 2: FilterRowHalving<2>(input, width, rowTaps, targetWidth, phases, output); break;
+					case 3: FilterRowHalving<3>(input, width, rowTaps, targetWidth, phases, output); break;
+					case 4: FilterRowHalving<4>(input, width, rowTaps, targetWidth, phases, output); break;
+
+					default: break;
+					}
+
+					continue;
+				}
+
+				switch (channels)
+				{
+				case 1: FilterRow<1>(input, rowTaps, targetWidth, output); break;
+				case 2: FilterRow<2>(input, rowTaps, targetWidth, output); break;
+				case 3: FilterRow<3>(input, rowTaps, targetWidth, output); break;
+				case 4: FilterRow<4>(input, rowTaps, targetWidth, output); break;
+
+				default: break;
+				}
+			}
+		});
+
+		// Columns, every tap adds a whole filtered row.
+		ForEachRow(pool, targetHeight, [&](const uint32 begin, const uint32 end)
+		{
+			for (uint32 y = begin; y < end; ++y)
+			{
+				float* output = target.data() + y * targetRowLength;
+				std::fill(output, output + targetRowLength, 0.0f);
+
+				for (uint32 t = 0; t < columnTaps.TapCount; ++t)
+				{
+					const float weight = columnTaps.Weights[y * columnTaps.TapCount + t];
+					const float* input = scratch.data() + columnTaps.Indices[y * columnTaps.TapCount + t] * targetRowLength;
+
+					for (size_t i = 0; i < targetRowLength; ++i)
+						output[i] += weight * input[i];
+				}
+			}
+		});
+	}
+
+	template<uint32 Channels>
+	void TextureMipFilter::FilterRow(const float* input, const FilterTaps& taps, const uint32 targetWidth, float* output)
+	{
+		const uint32* indices = taps.Indices.data();
+		const float* weights = taps.Weights.data();
+
+		for (uint32 x = 0; x < targetWidth; ++x)
+		{
+			float texel[Channels] = { };
+
+			for (uint32 t = 0; t < taps.TapCount; ++t, ++indices, ++weights)
+			{
+				const float* sample = input + *indices * Channels;
+				for (uint32 c = 0; c < Channels; ++c)
+					texel[c] += *weights * sample[c];
+			}
+
+			for (uint32 c = 0; c < Channels; ++c)
+				output[x * Channels + c] = texel[c];
+		}
+	}
+
+	template<uint32 Channels>
+	void TextureMipFilter::FilterRowHalving(const float* input, const uint32 width, const FilterTaps& taps, const uint32 targetWidth,
+		std::vector<float>& phases, float* output)
+	{
+		// Texels of the even and odd phase read by any tap, edge texels repeated.
+		const int32 firstPhase = FloorHalf(taps.FirstTap);
+		const int32 lastPhase = static_cast<int32>(targetWidth) - 1 + FloorHalf(taps.FirstTap + static_cast<int32>(taps.TapCount) - 1);
+		const size_t phaseLength = static_cast<size_t>(lastPhase - firstPhase + 1) * Channels;
+
+		phases.resize(2 * phaseLength);
+
+		float* even = phases.data();
+		float* odd = phases.data() + phaseLength;
+
+		const int32 lastTexel = static_cast<int32>(width) - 1;
+		auto copyClamped = [&](const int32 phase)
+		{
+			const float* evenTexel = input + std::clamp(2 * phase, 0, lastTexel) * Channels;
+			const float* oddTexel = input + std::clamp(2 * phase + 1, 0, lastTexel) * Channels;
+
+			for (uint32 c = 0; c < Channels; ++c)
+			{
+				even[(phase - firstPhase) * Channels + c] = evenTexel[c];
+				odd[(phase - firstPhase) * Channels + c] = oddTexel[c];
+			}
+		};
+
+		// Phases [0, width / 2) read both texels inside the row.
+		const int32 interiorEnd = std::min(static_cast<int32>(width / 2), lastPhase + 1);
+
+		const int32 interiorBegin = std::max(firstPhase, 0);
+
+		int32 phase = firstPhase;
+		for (; phase < interiorBegin; ++phase)
+			copyClamped(phase);
+
+		const float* pairs = input + static_cast<size_t>(2 * phase) * Channels;
+		float* evenTexels = even + static_cast<size_t>(phase - firstPhase) * Channels;
+		float* oddTexels = odd + static_cast<size_t>(phase - firstPhase) * Channels;
+
+		for (; phase < interiorEnd; ++phase, pairs += 2 * Channels, evenTexels += Channels, oddTexels += Channels)
+		{
+			for (uint32 c = 0; c < Channels; ++c)
+			{
+				evenTexels[c] = pairs[c];
+				oddTexels[c] = pairs[Channels + c];
+			}
+		}
+
+		for (; phase <= lastPhase; ++phase)
+			copyClamped(phase);
+
+		assert(taps.TapCount == HalvingTapCount); // "Unexpected tap count of a halving kernel."
+
+		const float* sources[HalvingTapCount];
+		for (uint32 t = 0; t < taps.TapCount; ++t)
+		{
+			const int32 offset = taps.FirstTap + static_cast<int32>(t);
+			sources[t] = (offset & 1 ? odd : even) + (FloorHalf(offset) - firstPhase) * Channels;
+		}
+
+		// Taps are added in the same order as by FilterRow(), the results are identical.
+		const size_t targetRowLength = static_cast<size_t>(targetWidth) * Channels;
+		size_t i = 0;
+
+#if ENGINE_SSE2
+		for (; i + 8 <= targetRowLength; i += 8)
+		{
+			__m128 low = _mm_setzero_ps();
+			__m128 high = _mm_setzero_ps();
+			for (uint32 t = 0; t < taps.TapCount; ++t)
+			{
+				const __m128 weight = _mm_set1_ps(taps.Weights[t]);
+				low = _mm_add_ps(low, _mm_mul_ps(weight, _mm_loadu_ps(sources[t] + i)));
+				high = _mm_add_ps(high, _mm_mul_ps(weight, _mm_loadu_ps(sources[t] + i + 4)));
+			}
+
+			_mm_storeu_ps(output + i, low);
+			_mm_storeu_ps(output + i + 4, high);
+		}
+
+		for (; i + 4 <= targetRowLength; i += 4)
+		{
+			__m128 sum = _mm_setzero_ps();
+			for (uint32 t = 0; t < taps.TapCount; ++t)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps.Weights[t]), _mm_loadu_ps(sources[t] + i)));
+
+			_mm_storeu_ps(output + i, sum);
+		}
+#endif
+
+		for (; i < targetRowLength; ++i)
+		{
+			float sum = 0.0f;
+			for (uint32 t = 0; t < taps.TapCount; ++t)
+				sum += taps.Weights[t] * sources[t][i];
+
+			output[i] = sum;
+		}
+	}
+
+	void TextureMipFilter::WriteLevel(const float* source, const uint32 texelCount, const uint32 channels, const bool srgb, std::vector<byte>& target)
+	{
+		const ColorTables& tables = GetColorTables();
+
+		target.resize(static_cast<size_t>(texelCount) * channels);
+
+		// The negative lobes of the kernel ring around edges, results are clamped.
+		for (size_t i = 0; i < target.size(); ++i)
+		{
+			const float value = std::clamp(source[i], 0.0f, 1.0f);
+
+			if (srgb && i % channels < 3)
+				target[i] = tables.FloatToSrgb[static_cast<uint32>(value * (LinearToSrgbSize - 1) + 0.5f)];
+			else
+				target[i] = static_cast<byte>(value * 255.0f + 0.5f);
+		}
+	}
+
+}
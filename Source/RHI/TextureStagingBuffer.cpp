@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "PBR/RHI/TextureStagingBuffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStagingBuffer ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	TextureStagingBuffer::TextureStagingBuffer(const uint32 frameSize)
+		: Buffer()
+		, Memory(nullptr)
+		, Fences()
+		, FrameSize(frameSize)
+		, FrameIndex(FrameCount - 1)
+		, FrameOffset(0)
+	{
+		assert(frameSize && frameSize % Alignment == 0);
+
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i] = GpuFence::Create();
+
+		Buffer = PixelBuffer::CreateMapped(frameSize * FrameCount);
+		Memory = static_cast<byte*>(Buffer->GetMappedMemory());
+	}
+
+	TextureStagingBuffer::~TextureStagingBuffer()
+	{
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i]->Wait();
+	}
+
+	void TextureStagingBuffer::BeginFrame()
+	{
+		FrameIndex = (FrameIndex + 1) % FrameCount;
+		Fences[FrameIndex]->Wait();
+
+		FrameOffset = 0;
+	}
+
+	void TextureStagingBuffer::EndFrame()
+	{
+		Fences[FrameIndex]->Signal();
+	}
+
+	void TextureStagingBuffer::Upload(const Texture2DRef& texture, const uint32 mip, const void* data, const uint32 size)
+	{
+		const uint32 alignedSize = (size + Alignment - 1) & ~(Alignment - 1);
+
+		if (!Memory || FrameOffset + alignedSize > FrameSize)
+		{
+			texture->SetMipData(mip, data);
+			return;
+		}
+
+		const uint32 offset = FrameIndex * FrameSize + FrameOffset;
+		std::memcpy(Memory + offset, data, size);
+
+		texture->SetMipData(mip, Buffer, offset);
+		FrameOffset += alignedSize;
+	}
+
+}
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "PBR/RHI/UniformRingBuffer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// UniformRingBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	UniformRingBuffer::UniformRingBuffer(const uint32 frameSize)
+		: Buffer()
+		, Memory(nullptr)
+		, Fences()
+		, FrameSize(0)
+		, FrameIndex(FrameCount - 1)
+		, FrameOffset(0)
+	{
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i] = GpuFence::Create();
+
+		Resize(frameSize);
+	}
+
+	UniformRingBuffer::~UniformRingBuffer()
+	{
+		for (uint32 i = 0; i < FrameCount; ++i)
+			Fences[i]->Wait();
+	}
+
+	void UniformRingBuffer::BeginFrame()
+	{
+		const uint32 requiredSize = FrameOffset.load(std::memory_order_relaxed);
+		if (requiredSize > FrameSize)
+		{
+			uint32 frameSize = FrameSize;
+			while (frameSize < requiredSize)
+				frameSize *= 2;
+
+			std::cout << "Warning: Uniform ring buffer overflowed, growing to " << frameSize << " bytes per frame." << std::endl;
+
+			// Commands of earlier frames still reference the old buffer.
+			for (uint32 i = 0; i < FrameCount; ++i)
+				Fences[i]->Wait();
+
+			Resize(frameSize);
+		}
+
+		FrameIndex = (FrameIndex + 1) % FrameCount;
+		Fences[FrameIndex]->Wait();
+
+		FrameOffset.store(0, std::memory_order_relaxed);
+	}
+
+	void UniformRingBuffer::EndFrame()
+	{
+		Fences[FrameIndex]->Signal();
+	}
+
+	UniformAllocation UniformRingBuffer::Allocate(const uint32 size)
+	{
+		UniformAllocation allocation;
+
+		if (!Memory)
+			return allocation;
+
+		const uint32 alignedSize = (size + Alignment - 1) & ~(Alignment - 1);
+		const uint32 offset = FrameOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+
+		if (offset + alignedSize > FrameSize)
+			return allocation;
+
+		allocation.Offset = FrameIndex * FrameSize + offset;
+		allocation.Size = size;
+		allocation.Memory = Memory + allocation.Offset;
+
+		return allocation;
+	}
+
+	UniformAllocation UniformRingBuffer::Upload(const void* data, const uint32 size)
+	{
+		UniformAllocation allocation = Allocate(size);
+		if (allocation.IsValid())
+			std::memcpy(allocation.Memory, data, size);
+
+		return allocation;
+	}
+
+	void UniformRingBuffer::Resize(const uint32 frameSize)
+	{
+		assert(frameSize && frameSize % Alignment == 0);
+
+		Buffer = UniformBuffer::CreateMapped(frameSize * FrameCount);
+		Memory = static_cast<byte*>(Buffer->GetMappedMemory());
+
+		FrameSize = frameSize;
+	}
+
+}
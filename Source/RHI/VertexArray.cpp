@@ -2,6 +2,7 @@
 
 #include "PBR/RHI/VertexArray.h"
 #include "PBR/RHIOpenGL/OpenGLVertexArray.h"
+#include "PBR/RHINull/NullVertexArray.h"
 
 #include "PBR/Renderer/Renderer.h"
 
@@ -13,6 +14,7 @@ namespace EngineCore
 	{
 		switch (Renderer::GetApi())
 		{
+		case RenderApi::None: return new NullVertexArray();
 		case RenderApi::OpenGL: return new OpenGLVertexArray();
 
 		default:
@@ -0,0 +1,166 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullBuffer.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullVertexBuffer ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullVertexBuffer::NullVertexBuffer(const void* data, const uint32 size, const BufferUsage usage)
+		: Layout()
+		, Size(size)
+		, Usage(usage)
+	{
+
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+
+	}
+
+	void NullVertexBuffer::SetData(const void* data, const uint32 offset, const uint32 size)
+	{
+		if (offset + size > Size)
+			NullContext::Get().ReportError("VertexBuffer::SetData out of bounds.");
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullIndexBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullIndexBuffer::NullIndexBuffer(const void* data, const uint32 count, const IndexType type, const BufferUsage usage)
+		: Count(count)
+		, Type(type)
+	{
+
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+
+	}
+
+	void NullIndexBuffer::SetData(const void* data, const uint32 offset, const uint32 count)
+	{
+		if (offset + count > Count)
+			NullContext::Get().ReportError("IndexBuffer::SetData out of bounds.");
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullUniformBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullUniformBuffer::NullUniformBuffer(const uint32 size, const BufferUsage usage, const bool mapped)
+		: Data(size)
+		, bIsMapped(mapped)
+	{
+
+	}
+
+	NullUniformBuffer::NullUniformBuffer(const void* data, const uint32 size, const BufferUsage usage)
+		: Data(size)
+		, bIsMapped(false)
+	{
+		if (data)
+			std::memcpy(Data.data(), data, size);
+	}
+
+	NullUniformBuffer::~NullUniformBuffer()
+	{
+
+	}
+
+	void NullUniformBuffer::BindBlockRange(const uint32 blockIndex, const uint32 offset, const uint32 size) const
+	{
+		if (offset + size > Data.size())
+			NullContext::Get().ReportError("UniformBuffer::BindBlockRange out of bounds.");
+	}
+
+	void NullUniformBuffer::SetData(const void* data, const uint32 size, const uint32 offset)
+	{
+		if (offset + size > Data.size())
+		{
+			NullContext::Get().ReportError("UniformBuffer::SetData out of bounds.");
+			return;
+		}
+
+		std::memcpy(Data.data() + offset, data, size);
+		NullContext::Get().OnUniformUpload(size);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullStorageBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullStorageBuffer::NullStorageBuffer(const uint32 size, const BufferUsage usage)
+		: Data(size)
+	{
+
+	}
+
+	NullStorageBuffer::~NullStorageBuffer()
+	{
+
+	}
+
+	void NullStorageBuffer::SetData(const void* data, const uint32 size, const uint32 offset)
+	{
+		if (offset + size > Data.size())
+		{
+			NullContext::Get().ReportError("StorageBuffer::SetData out of bounds.");
+			return;
+		}
+
+		std::memcpy(Data.data() + offset, data, size);
+		NullContext::Get().OnUniformUpload(size);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullIndirectBuffer //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullIndirectBuffer::NullIndirectBuffer(const uint32 capacity, const BufferUsage usage)
+		: Commands(capacity)
+	{
+
+	}
+
+	NullIndirectBuffer::~NullIndirectBuffer()
+	{
+
+	}
+
+	void NullIndirectBuffer::SetData(const DrawIndexedIndirectCommand* commands, const uint32 count, const uint32 offset)
+	{
+		if (offset + count > Commands.size())
+		{
+			NullContext::Get().ReportError("IndirectBuffer::SetData out of bounds.");
+			return;
+		}
+
+		std::memcpy(Commands.data() + offset, commands, count * sizeof(DrawIndexedIndirectCommand));
+		NullContext::Get().OnUniformUpload(count * sizeof(DrawIndexedIndirectCommand));
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullPixelBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullPixelBuffer::NullPixelBuffer(const uint32 size)
+		: Data(size)
+	{
+
+	}
+
+	NullPixelBuffer::~NullPixelBuffer()
+	{
+
+	}
+
+}
\ No newline at end of file
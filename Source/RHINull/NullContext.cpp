@@ -0,0 +1,319 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullContext.h"
+#include "PBR/RHINull/NullBuffer.h"
+#include "PBR/RHINull/NullShader.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullContext /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullContext::NullContext()
+		: Stats()
+		, BoundShader(nullptr)
+		, BoundFrameBuffer(nullptr)
+		, BoundVertexArray(nullptr)
+		, PendingVertexArray()
+		, PendingPipelineState()
+		, RenderPassDepth(0)
+	{
+
+	}
+
+	NullContext::~NullContext()
+	{
+
+	}
+
+	void NullContext::RHIClear(const ClearFlags flags)
+	{
+		if (flags == ClearFlags::None)
+			ReportError("Clear without any buffer flags.");
+	}
+
+	void NullContext::RHISetClearColor(const glm::vec4& color)
+	{
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHISetDepthFunc(const DepthFunc func)
+	{
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHIDepthMask(const bool value)
+	{
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHISetCullMode(const CullMode mode)
+	{
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHISetBlendFunc(const BlendFunc func)
+	{
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHISetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
+	{
+		if (!width || !height)
+			ReportError("Viewport with zero size.");
+
+		++Stats.StateChanges;
+	}
+
+	void NullContext::RHISetVertexBuffer(const VertexBufferRef& vertexBuffer)
+	{
+
+	}
+
+	void NullContext::RHISetIndexBuffer(const IndexBufferRef& indexBuffer)
+	{
+
+	}
+
+	void NullContext::RHISetVertexArray(const VertexArrayRef& vertexArray)
+	{
+		PendingVertexArray = vertexArray;
+	}
+
+	void NullContext::RHISetShader(const ShaderRef& shader)
+	{
+
+	}
+
+	void NullContext::RHISetPipelineState(const PipelineStateRef& pipelineState)
+	{
+		if (!pipelineState)
+		{
+			ReportError("Binding an empty pipeline state.");
+			return;
+		}
+
+		pipelineState->GetShader()->Bind();
+
+		if (pipelineState != PendingPipelineState)
+			++Stats.PipelineStateChanges;
+
+		PendingPipelineState = pipelineState;
+	}
+
+	void NullContext::RHISetFrameBuffer(const FrameBufferRef& frameBuffer)
+	{
+
+	}
+
+	void NullContext::RHISetShaderParameter()
+	{
+
+	}
+
+	void NullContext::RHISetShaderUniformParameter()
+	{
+
+	}
+
+	void NullContext::RHIBeginRenderPass(const char* name)
+	{
+		++RenderPassDepth;
+	}
+
+	void NullContext::RHIEndRenderPass()
+	{
+		if (--RenderPassDepth < 0)
+		{
+			ReportError("EndRenderPass without BeginRenderPass.");
+			RenderPassDepth = 0;
+		}
+	}
+
+	void NullContext::RHIDrawPrimitive()
+	{
+		if (!ValidateDraw(false))
+			return;
+
+		++Stats.DrawCalls;
+	}
+
+	void NullContext::RHIDrawIndexedPrimitive()
+	{
+		if (!ValidateDraw(true))
+			return;
+
+		++Stats.DrawCalls;
+		++Stats.IndexedDrawCalls;
+
+		Stats.Indices += PendingVertexArray->GetIndexBuffer()->GetCount();
+	}
+
+	void NullContext::RHIDrawIndexedInstancedPrimitive(const uint32 instances)
+	{
+		if (!ValidateDraw(true))
+			return;
+
+		if (!instances)
+			ReportError("Instanced draw with zero instances.");
+
+		++Stats.DrawCalls;
+		++Stats.InstancedDrawCalls;
+
+		Stats.Indices += uint64(PendingVertexArray->GetIndexBuffer()->GetCount()) * instances;
+		Stats.Instances += instances;
+	}
+
+	void NullContext::RHIDrawIndexedRangePrimitive(const uint32 count, const uint32 firstIndex, const int32 baseVertex)
+	{
+		if (!ValidateDraw(true))
+			return;
+
+		if (firstIndex + count > PendingVertexArray->GetIndexBuffer()->GetCount())
+			ReportError("Indexed draw out of the index buffer bounds.");
+
+		if (baseVertex < 0)
+			ReportError("Indexed draw with a negative base vertex.");
+
+		++Stats.DrawCalls;
+		++Stats.IndexedDrawCalls;
+
+		Stats.Indices += count;
+	}
+
+	void NullContext::RHIDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset)
+	{
+		RHIMultiDrawIndexedIndirect(indirectBuffer, offset, 1);
+	}
+
+	void NullContext::RHIMultiDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount)
+	{
+		if (!ValidateDraw(true))
+			return;
+
+		if (!indirectBuffer || offset + drawCount > indirectBuffer->GetCapacity())
+		{
+			ReportError("Indirect draw out of the indirect buffer bounds.");
+			return;
+		}
+
+		const uint32 indexCount = PendingVertexArray->GetIndexBuffer()->GetCount();
+		const DrawIndexedIndirectCommand* commands = static_cast<const NullIndirectBuffer*>(indirectBuffer.GetReference())->GetCommands() + offset;
+
+		for (uint32 i = 0; i < drawCount; ++i)
+		{
+			if (commands[i].FirstIndex + commands[i].Count > indexCount)
+				ReportError("Indirect draw command out of the index buffer bounds.");
+
+			if (commands[i].BaseVertex < 0)
+				ReportError("Indirect draw command with a negative base vertex.");
+
+			Stats.Indices += uint64(commands[i].Count) * commands[i].InstanceCount;
+			Stats.Instances += commands[i].InstanceCount;
+		}
+
+		++Stats.DrawCalls;
+		++Stats.IndirectDrawCalls;
+		Stats.IndirectCommands += drawCount;
+	}
+
+	void NullContext::RHIDispatchCompute(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ)
+	{
+		if (!BoundShader || !static_cast<const NullShader*>(BoundShader)->IsCompute())
+		{
+			ReportError("Dispatch without a bound compute shader.");
+			return;
+		}
+
+		if (!groupsX || !groupsY || !groupsZ)
+			ReportError("Dispatch without work groups.");
+
+		++Stats.ComputeDispatches;
+	}
+
+	void NullContext::OnBindShader(const Shader* shader)
+	{
+		if (shader && shader != BoundShader)
+			++Stats.ShaderBinds;
+
+		BoundShader = shader;
+	}
+
+	void NullContext::OnBindFrameBuffer(const FrameBuffer* frameBuffer)
+	{
+		if (frameBuffer && frameBuffer != BoundFrameBuffer)
+			++Stats.FrameBufferBinds;
+
+		BoundFrameBuffer = frameBuffer;
+	}
+
+	void NullContext::OnBindVertexArray(const VertexArray* vertexArray)
+	{
+		BoundVertexArray = vertexArray;
+	}
+
+	void NullContext::OnUniformUpload(const uint32 size)
+	{
+		++Stats.UniformUploads;
+		Stats.UniformBytes += size;
+	}
+
+	void NullContext::OnFenceSignal()
+	{
+		++Stats.FenceSignals;
+	}
+
+	void NullContext::OnFenceWait()
+	{
+		++Stats.FenceWaits;
+	}
+
+	void NullContext::ReportError(const char* message)
+	{
+		++Stats.ValidationErrors;
+		std::cout << "Warning: Null RHI validation: " << message << std::endl;
+	}
+
+	bool NullContext::ValidateDraw(const bool indexed)
+	{
+		if (!BoundShader)
+		{
+			ReportError("Draw without a bound shader.");
+			return false;
+		}
+
+		if (static_cast<const NullShader*>(BoundShader)->IsCompute())
+		{
+			ReportError("Draw with a compute shader bound.");
+			return false;
+		}
+
+		if (!PendingVertexArray)
+		{
+			ReportError("Draw without a vertex array.");
+			return false;
+		}
+
+		if (PendingVertexArray.GetReference() != BoundVertexArray)
+			ReportError("Draw with a vertex array that is not bound.");
+
+		if (PendingVertexArray->GetVertexBuffers().empty())
+			ReportError("Draw with a vertex array without vertex buffers.");
+
+		if (indexed)
+		{
+			const IndexBufferRef& indexBuffer = PendingVertexArray->GetIndexBuffer();
+			if (!indexBuffer || !indexBuffer->GetCount())
+			{
+				ReportError("Indexed draw without indices.");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,55 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullFrameBuffer.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullFrameBuffer /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullFrameBuffer::NullFrameBuffer(const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo)
+		: Width(width)
+		, Height(height)
+		, CreateInfo(createInfo)
+	{
+
+	}
+
+	NullFrameBuffer::~NullFrameBuffer()
+	{
+
+	}
+
+	void NullFrameBuffer::Bind() const
+	{
+		NullContext::Get().OnBindFrameBuffer(this);
+	}
+
+	void NullFrameBuffer::Unbind() const
+	{
+		NullContext::Get().OnBindFrameBuffer(nullptr);
+	}
+
+	void NullFrameBuffer::Attach(const Ref<Texture2D>& texture, const TextureAttachment attachment)
+	{
+		if (!texture)
+			NullContext::Get().ReportError("FrameBuffer::Attach with an empty texture.");
+	}
+
+	void NullFrameBuffer::Attach(const Ref<TextureCube>& cubeMap, const CubeMapOrientation orientation, const TextureAttachment attachment, const uint32 mipLevel)
+	{
+		if (!cubeMap)
+			NullContext::Get().ReportError("FrameBuffer::Attach with an empty cube map.");
+	}
+
+	void NullFrameBuffer::Resize(const uint32 width, const uint32 height)
+	{
+		Width = width;
+		Height = height;
+	}
+
+}
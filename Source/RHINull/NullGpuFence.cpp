@@ -0,0 +1,34 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullGpuFence.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuFence ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullGpuFence::NullGpuFence()
+	{
+
+	}
+
+	NullGpuFence::~NullGpuFence()
+	{
+
+	}
+
+	void NullGpuFence::Signal()
+	{
+		NullContext::Get().OnFenceSignal();
+	}
+
+	void NullGpuFence::Wait()
+	{
+		NullContext::Get().OnFenceWait();
+	}
+
+}
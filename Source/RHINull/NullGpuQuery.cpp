@@ -0,0 +1,64 @@
+#include "pch.h"
+
+#include <chrono>
+
+#include "PBR/RHINull/NullGpuQuery.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuTimestampQuery ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullGpuTimestampQuery::NullGpuTimestampQuery()
+		: Timestamp(0)
+	{
+
+	}
+
+	NullGpuTimestampQuery::~NullGpuTimestampQuery()
+	{
+
+	}
+
+	void NullGpuTimestampQuery::Issue()
+	{
+		const auto now = std::chrono::steady_clock::now().time_since_epoch();
+		Timestamp = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullGpuStatisticsQuery //////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullGpuStatisticsQuery::NullGpuStatisticsQuery()
+		: BeginIndices(0)
+		, Statistics()
+	{
+
+	}
+
+	NullGpuStatisticsQuery::~NullGpuStatisticsQuery()
+	{
+
+	}
+
+	void NullGpuStatisticsQuery::Begin()
+	{
+		BeginIndices = NullContext::Get().GetStats().Indices;
+	}
+
+	void NullGpuStatisticsQuery::End()
+	{
+		const uint64 indices = NullContext::Get().GetStats().Indices - BeginIndices;
+
+		Statistics = PipelineStatistics();
+		Statistics.VerticesSubmitted = indices;
+		Statistics.PrimitivesSubmitted = indices / 3;
+		Statistics.ClippingInputPrimitives = indices / 3;
+	}
+
+}
@@ -0,0 +1,39 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullShader.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullShader //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullShader::NullShader(const std::string& name, const ShaderSource& source)
+		: Name(name)
+		, bIsCompute(!source.ComputeSource.empty())
+	{
+		if (bIsCompute && (!source.VertexSource.empty() || !source.FragmentSource.empty()))
+			NullContext::Get().ReportError("Compute shader created with graphics stages.");
+		else if (!bIsCompute && (source.VertexSource.empty() || source.FragmentSource.empty()))
+			NullContext::Get().ReportError("Shader created without vertex or fragment source.");
+	}
+
+	NullShader::~NullShader()
+	{
+
+	}
+
+	void NullShader::Bind() const
+	{
+		NullContext::Get().OnBindShader(this);
+	}
+
+	void NullShader::Unbind() const
+	{
+		NullContext::Get().OnBindShader(nullptr);
+	}
+
+}
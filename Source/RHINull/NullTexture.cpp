@@ -0,0 +1,108 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullTexture.h"
+#include "PBR/RHINull/NullContext.h"
+#include "PBR/RHI/TextureEncoder.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullTexture2D ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullTexture2D::NullTexture2D(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo)
+		: Width(width)
+		, Height(height)
+		, MipCount(createInfo.UseMipMaps ? GetMipLevelCount(width, height) : 1)
+		, CreateInfo(createInfo)
+		, bIsResident(false)
+		, Generation(0)
+	{
+		if (CreateInfo.FirstResidentMip >= MipCount)
+			NullContext::Get().ReportError("Texture2D first resident mip out of range.");
+	}
+
+	NullTexture2D::~NullTexture2D()
+	{
+
+	}
+
+	void NullTexture2D::SetFirstResidentMip(const uint32 mip)
+	{
+		if (mip >= MipCount)
+		{
+			NullContext::Get().ReportError("Texture2D::SetFirstResidentMip out of range.");
+			return;
+		}
+
+		if (mip == CreateInfo.FirstResidentMip)
+			return;
+
+		CreateInfo.FirstResidentMip = mip;
+		++Generation;
+	}
+
+	void NullTexture2D::SetMipData(const uint32 mip, const void* data)
+	{
+		if (mip < CreateInfo.FirstResidentMip || mip >= MipCount)
+			NullContext::Get().ReportError("Texture2D::SetMipData on a mip that is not resident.");
+	}
+
+	void NullTexture2D::SetMipData(const uint32 mip, const PixelBufferRef& buffer, const uint32 offset)
+	{
+		if (mip < CreateInfo.FirstResidentMip || mip >= MipCount)
+		{
+			NullContext::Get().ReportError("Texture2D::SetMipData on a mip that is not resident.");
+			return;
+		}
+
+		const uint64 size = GetTextureLevelDataSize(GetMipLevelSize(Width, mip), GetMipLevelSize(Height, mip), CreateInfo);
+		if (offset + size > buffer->GetSize())
+			NullContext::Get().ReportError("Texture2D::SetMipData reads past the end of the pixel buffer.");
+	}
+
+	void NullTexture2D::Fill(const glm::vec4& color)
+	{
+		if (IsCompressedTextureFormat(CreateInfo.InternalFormat) && !TextureEncoder::CanEncode(CreateInfo.InternalFormat))
+			NullContext::Get().ReportError("Texture2D::Fill on a compressed format without encoder.");
+	}
+
+	void NullTexture2D::GenerateMipMaps()
+	{
+		if (CreateInfo.FirstResidentMip != 0)
+			NullContext::Get().ReportError("Texture2D::GenerateMipMaps without level 0 resident.");
+
+		if (IsCompressedTextureFormat(CreateInfo.InternalFormat))
+			NullContext::Get().ReportError("Texture2D::GenerateMipMaps on a compressed format.");
+	}
+
+	void NullTexture2D::BindImage(const uint32 unit, const uint32 mip) const
+	{
+		if (mip < CreateInfo.FirstResidentMip || mip >= MipCount)
+			NullContext::Get().ReportError("Texture2D::BindImage on a mip that is not resident.");
+
+		if (!IsImageTextureFormat(CreateInfo.InternalFormat))
+			NullContext::Get().ReportError("Texture2D::BindImage on a format that cannot be bound to image units.");
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullTextureCube /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullTextureCube::NullTextureCube(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo)
+		: Width(width)
+		, Height(height)
+		, CreateInfo(createInfo)
+		, bIsResident(false)
+	{
+
+	}
+
+	NullTextureCube::~NullTextureCube()
+	{
+
+	}
+
+}
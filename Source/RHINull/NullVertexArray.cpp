@@ -0,0 +1,49 @@
+#include "pch.h"
+
+#include "PBR/RHINull/NullVertexArray.h"
+#include "PBR/RHINull/NullContext.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// NullVertexArray /////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	NullVertexArray::NullVertexArray()
+		: VertexBuffers()
+		, IndexBuffer()
+	{
+
+	}
+
+	NullVertexArray::~NullVertexArray()
+	{
+
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullContext::Get().OnBindVertexArray(this);
+	}
+
+	void NullVertexArray::Unbind() const
+	{
+		NullContext::Get().OnBindVertexArray(nullptr);
+	}
+
+	void NullVertexArray::AddVertexBuffer(const VertexBufferRef& buffer)
+	{
+		if (buffer->GetLayout().GetElements().empty())
+			NullContext::Get().ReportError("VertexBuffer added without a layout.");
+
+		VertexBuffers.push_back(buffer);
+	}
+
+	void NullVertexArray::SetIndexBuffer(const IndexBufferRef& buffer)
+	{
+		IndexBuffer = buffer;
+	}
+
+}
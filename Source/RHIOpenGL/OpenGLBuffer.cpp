@@ -2,6 +2,7 @@
 
 #include "PBR/RHIOpenGL/OpenGL.h"
 #include "PBR/RHIOpenGL/OpenGLBuffer.h"
+#include "PBR/RHIOpenGL/OpenGLContext.h"
 
 namespace EngineCore
 {
@@ -20,37 +21,87 @@ namespace EngineCore
 		return 0;
 	}
 
+	// Expects the buffer to be bound to target.
+	static void UpdateBufferData(const GLenum target, const BufferUsage usage, const uint32 bufferSize, const void* data, const uint32 offset, const uint32 size)
+	{
+		switch (usage)
+		{
+		case BufferUsage::Dynamic:
+		{
+			// Orphaning hands the driver a fresh allocation, draws still reading the old one don't block.
+			if (offset == 0 && size == bufferSize)
+				glBufferData(target, bufferSize, nullptr, GL_DYNAMIC_DRAW);
+
+			glBufferSubData(target, offset, size, data);
+			return;
+		}
+
+		case BufferUsage::Stream:
+		{
+			// Offset 0 starts a new batch of stream data, everything behind it is appended to that batch
+			// and cannot overlap anything the GPU still reads.
+			const GLbitfield flags = offset == 0
+				? GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+				: GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+
+			void* memory = glMapBufferRange(target, offset, size, flags);
+			if (memory)
+			{
+				std::memcpy(memory, data, size);
+				glUnmapBuffer(target);
+
+				return;
+			}
+
+			std::cout << "Warning: Failed to map buffer range for a stream update." << std::endl;
+			break;
+		}
+
+		default:
+			break;
+		}
+
+		glBufferSubData(target, offset, size, data);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLVertexBuffer //////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(const void* data, const uint32 size, const BufferUsage usage)
-		: Handle(0), Layout()
+		: Handle(0), Layout(), Size(size), Usage(usage)
 	{
 		glGenBuffers(1, &Handle);
-		glBindBuffer(GL_ARRAY_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, Handle);
 		glBufferData(GL_ARRAY_BUFFER, size, data, BufferUsageToGl(usage));
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
 		glDeleteBuffers(1, &Handle);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, Handle);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, const uint32 offset, const uint32 size)
 	{
-		// TODO:
-		assert(false);
+		if (offset + size > Size)
+		{
+			std::cout << "Warning: VertexBuffer::SetData out of bounds." << std::endl;
+			return;
+		}
+
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, Handle);
+		UpdateBufferData(GL_ARRAY_BUFFER, Usage, Size, data, offset, size);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -58,17 +109,17 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLMappedVertexBuffer::OpenGLMappedVertexBuffer(const uint32 size, const BufferUsage usage)
-		: Handle(0), Layout(), MappedMemory(nullptr)
+		: Handle(0), Layout(), MappedMemory(nullptr), Size(size)
 	{
 		glGenBuffers(1, &Handle);
-		glBindBuffer(GL_ARRAY_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, Handle);
 
 		uint32 flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 
 		glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
 		MappedMemory = glMapNamedBufferRange(Handle, 0, size, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void OpenGLMappedVertexBuffer::SetData(const void* data, const uint32 offset, const uint32 size)
@@ -79,44 +130,60 @@ namespace EngineCore
 	OpenGLMappedVertexBuffer::~OpenGLMappedVertexBuffer()
 	{
 		glUnmapNamedBuffer(Handle); // TODO: generates error
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
 		glDeleteBuffers(1, &Handle);
 	}
 
 	void OpenGLMappedVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, Handle);
 	}
 
 	void OpenGLMappedVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLIndexBuffer ///////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32* data, const uint32 count, const BufferUsage usage)
-		: Handle(0), Count(count)
+	OpenGLIndexBuffer::OpenGLIndexBuffer(const void* data, const uint32 count, const IndexType type, const BufferUsage usage)
+		: Handle(0), Count(count), Type(type), Usage(usage)
 	{
 		glGenBuffers(1, &Handle);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Handle);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32), data, BufferUsageToGl(usage));
+		OpenGLContext::Get().CachedBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Handle);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * GetIndexTypeSize(type), data, BufferUsageToGl(usage));
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
-		glDeleteBuffers(GL_ELEMENT_ARRAY_BUFFER, &Handle);
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
+		glDeleteBuffers(1, &Handle);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Handle);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLIndexBuffer::SetData(const void* data, const uint32 offset, const uint32 count)
+	{
+		if (offset + count > Count)
+		{
+			std::cout << "Warning: IndexBuffer::SetData out of bounds." << std::endl;
+			return;
+		}
+
+		// Binding the element array buffer would change the index buffer of the bound vertex array.
+		const uint32 indexSize = GetIndexTypeSize(Type);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, Handle);
+		UpdateBufferData(GL_COPY_WRITE_BUFFER, Usage, Count * indexSize, data, offset * indexSize, count * indexSize);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -128,9 +195,9 @@ namespace EngineCore
 	{
 		glGenBuffers(1, &Handle);
 
-		glBindBuffer(GL_UNIFORM_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
 		glBufferData(GL_UNIFORM_BUFFER, size, nullptr, BufferUsageToGl(Usage));
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 	OpenGLUniformBuffer::OpenGLUniformBuffer(const void* data, const uint32 size, const BufferUsage usage)
@@ -138,41 +205,222 @@ namespace EngineCore
 	{
 		glGenBuffers(1, &Handle);
 		
-		glBindBuffer(GL_UNIFORM_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
 		glBufferData(GL_UNIFORM_BUFFER, size, data, BufferUsageToGl(Usage));
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 	OpenGLUniformBuffer::~OpenGLUniformBuffer()
 	{
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
 		glDeleteBuffers(1, &Handle);
 	}
 
 	void OpenGLUniformBuffer::Bind() const
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
 	}
 
 	void OpenGLUniformBuffer::Unbind() const
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 	void OpenGLUniformBuffer::BindBlock(const uint32 blockIndex) const
 	{
-		glBindBufferBase(GL_UNIFORM_BUFFER, blockIndex, Handle);
+		OpenGLContext::Get().CachedBindBufferBase(GL_UNIFORM_BUFFER, blockIndex, Handle);
 	}
 
 	void OpenGLUniformBuffer::BindBlockRange(const uint32 blockIndex, const uint32 offset, const uint32 size) const
 	{
-		glBindBufferRange(GL_UNIFORM_BUFFER, blockIndex, Handle, offset, size);
+		OpenGLContext::Get().CachedBindBufferRange(GL_UNIFORM_BUFFER, blockIndex, Handle, offset, size);
 	}
 
 	void OpenGLUniformBuffer::SetData(const void* data, const uint32 size, const uint32 offset)
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, Handle);
+		// Binds go through the state cache, so the buffer can stay bound for the next update.
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
 		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLMappedUniformBuffer ///////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLMappedUniformBuffer::OpenGLMappedUniformBuffer(const uint32 size)
+		: Handle(0), Size(size), MappedMemory(nullptr)
+	{
+		glGenBuffers(1, &Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+		MappedMemory = glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags);
+
+		if (!MappedMemory)
+			std::cout << "Warning: Failed to map uniform buffer persistently." << std::endl;
+	}
+
+	OpenGLMappedUniformBuffer::~OpenGLMappedUniformBuffer()
+	{
+		if (MappedMemory)
+		{
+			OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
+			glUnmapBuffer(GL_UNIFORM_BUFFER);
+		}
+
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
+		glDeleteBuffers(1, &Handle);
+	}
+
+	void OpenGLMappedUniformBuffer::Bind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, Handle);
+	}
+
+	void OpenGLMappedUniformBuffer::Unbind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	void OpenGLMappedUniformBuffer::BindBlock(const uint32 blockIndex) const
+	{
+		OpenGLContext::Get().CachedBindBufferBase(GL_UNIFORM_BUFFER, blockIndex, Handle);
+	}
+
+	void OpenGLMappedUniformBuffer::BindBlockRange(const uint32 blockIndex, const uint32 offset, const uint32 size) const
+	{
+		OpenGLContext::Get().CachedBindBufferRange(GL_UNIFORM_BUFFER, blockIndex, Handle, offset, size);
+	}
+
+	void OpenGLMappedUniformBuffer::SetData(const void* data, const uint32 size, const uint32 offset)
+	{
+		assert(offset + size <= Size);
+		std::memcpy(static_cast<byte*>(MappedMemory) + offset, data, size);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLStorageBuffer /////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(const uint32 size, const BufferUsage usage)
+		: Handle(0), Size(size), Usage(usage)
+	{
+		glGenBuffers(1, &Handle);
+
+		OpenGLContext::Get().CachedBindBuffer(GL_SHADER_STORAGE_BUFFER, Handle);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, BufferUsageToGl(Usage));
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
+		glDeleteBuffers(1, &Handle);
+	}
+
+	void OpenGLStorageBuffer::Bind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_SHADER_STORAGE_BUFFER, Handle);
+	}
+
+	void OpenGLStorageBuffer::Unbind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void OpenGLStorageBuffer::BindBlock(const uint32 blockIndex) const
+	{
+		OpenGLContext::Get().CachedBindBufferBase(GL_SHADER_STORAGE_BUFFER, blockIndex, Handle);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, const uint32 size, const uint32 offset)
+	{
+		assert(offset + size <= Size);
+
+		OpenGLContext::Get().CachedBindBuffer(GL_SHADER_STORAGE_BUFFER, Handle);
+		UpdateBufferData(GL_SHADER_STORAGE_BUFFER, Usage, Size, data, offset, size);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLIndirectBuffer ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLIndirectBuffer::OpenGLIndirectBuffer(const uint32 capacity, const BufferUsage usage)
+		: Handle(0), Capacity(capacity), Usage(usage)
+	{
+		glGenBuffers(1, &Handle);
+
+		OpenGLContext::Get().CachedBindBuffer(GL_DRAW_INDIRECT_BUFFER, Handle);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, capacity * sizeof(DrawIndexedIndirectCommand), nullptr, BufferUsageToGl(Usage));
+	}
+
+	OpenGLIndirectBuffer::~OpenGLIndirectBuffer()
+	{
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
+		glDeleteBuffers(1, &Handle);
+	}
+
+	void OpenGLIndirectBuffer::Bind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_DRAW_INDIRECT_BUFFER, Handle);
+	}
+
+	void OpenGLIndirectBuffer::Unbind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	void OpenGLIndirectBuffer::SetData(const DrawIndexedIndirectCommand* commands, const uint32 count, const uint32 offset)
+	{
+		assert(offset + count <= Capacity);
+
+		OpenGLContext::Get().CachedBindBuffer(GL_DRAW_INDIRECT_BUFFER, Handle);
+		UpdateBufferData(GL_DRAW_INDIRECT_BUFFER, Usage, Capacity * sizeof(DrawIndexedIndirectCommand), commands, offset * sizeof(DrawIndexedIndirectCommand), count * sizeof(DrawIndexedIndirectCommand));
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLPixelBuffer ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLPixelBuffer::OpenGLPixelBuffer(const uint32 size)
+		: Handle(0), Size(size), MappedMemory(nullptr)
+	{
+		glGenBuffers(1, &Handle);
+		OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, Handle);
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+		MappedMemory = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+
+		if (!MappedMemory)
+			std::cout << "Warning: Failed to map pixel buffer persistently." << std::endl;
+
+		OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	OpenGLPixelBuffer::~OpenGLPixelBuffer()
+	{
+		if (MappedMemory)
+		{
+			OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, Handle);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		OpenGLContext::Get().OnDeleteBuffer(Handle);
+		glDeleteBuffers(1, &Handle);
+	}
+
+	void OpenGLPixelBuffer::Bind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, Handle);
+	}
+
+	void OpenGLPixelBuffer::Unbind() const
+	{
+		OpenGLContext::Get().CachedBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 	}
 
 }
\ No newline at end of file
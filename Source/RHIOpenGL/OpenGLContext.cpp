@@ -7,13 +7,33 @@
 namespace EngineCore
 {
 
+	GLenum PrimitiveTypeToGl(const PrimitiveType primitive)
+	{
+		switch (primitive)
+		{
+		case PrimitiveType::Points:		return GL_POINTS;
+		case PrimitiveType::Lines:		return GL_LINES;
+		case PrimitiveType::Triangles:	return GL_TRIANGLES;
+
+		default: break;
+		}
+
+		// Quads are not part of the core profile.
+		return GL_TRIANGLES;
+	}
+
+	GLenum IndexTypeToGl(const IndexType type)
+	{
+		return type == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLContextState //////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLContextState::OpenGLContextState()
 	{
-
+		Invalidate();
 	}
 
 	OpenGLContextState::~OpenGLContextState()
@@ -21,14 +41,45 @@ namespace EngineCore
 
 	}
 
+	void OpenGLContextState::Invalidate()
+	{
+		BoundProgram = InvalidHandle;
+		BoundVertexArray = InvalidHandle;
+		BoundFrameBuffer = InvalidHandle;
+
+		BoundVertexBuffer = InvalidHandle;
+		BoundIndexBuffer = InvalidHandle;
+		BoundUniformBuffer = InvalidHandle;
+		BoundStorageBuffer = InvalidHandle;
+		BoundIndirectBuffer = InvalidHandle;
+
+		for (uint32 i = 0; i < MaxUniformBufferBindings; ++i)
+		{
+			UniformBufferBindings[i] = InvalidHandle;
+			UniformBufferOffsets[i] = InvalidHandle;
+			UniformBufferSizes[i] = InvalidHandle;
+		}
+
+		ViewportX = InvalidHandle;
+		ViewportY = InvalidHandle;
+		ViewportWidth = InvalidHandle;
+		ViewportHeight = InvalidHandle;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLRHIState //////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLRHIState::OpenGLRHIState()
-		: CullMode(CullMode::None)
-		, DepthFunc(DepthFunc::None)
-		, BlendFunc(BlendFunc::None)
+		: CullMode(UnknownCullMode)
+		, DepthFunc(UnknownDepthFunc)
+		, BlendFunc(UnknownBlendFunc)
+		, bIsDepthMaskKnown(false)
+		, bDepthMask(true)
+		, bIsClearColorKnown(false)
+		, ClearColor(0.0f)
+		, Primitive(PrimitiveType::Triangles)
+		, BoundPipelineState(nullptr)
 		, BoundShader(nullptr)
 		, BoundFrameBuffer(nullptr)
 		, BoundVertexArray(nullptr)
@@ -43,6 +94,7 @@ namespace EngineCore
 
 	void OpenGLRHIState::Reset()
 	{
+		BoundPipelineState = nullptr;
 		BoundShader = nullptr;
 		BoundFrameBuffer = nullptr;
 
@@ -54,11 +106,26 @@ namespace EngineCore
 
 	}
 
+	void OpenGLRHIState::Invalidate()
+	{
+		CullMode = UnknownCullMode;
+		DepthFunc = UnknownDepthFunc;
+		BlendFunc = UnknownBlendFunc;
+
+		bIsDepthMaskKnown = false;
+		bIsClearColorKnown = false;
+
+		BoundPipelineState = nullptr;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLContext ///////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLContext::OpenGLContext()
+		: PendingState()
+		, ContextState()
+		, Stats()
 	{
 	}
 
@@ -75,7 +142,11 @@ namespace EngineCore
 			glFlags |= GL_COLOR_BUFFER_BIT;
 
 		if ((flags & ClearFlags::DepthBuffer) != ClearFlags::None)
+		{
+			// GL masks depth clears with the depth write state, pipeline states may have left it disabled.
+			RHIDepthMask(true);
 			glFlags |= GL_DEPTH_BUFFER_BIT;
+		}
 
 		if ((flags & ClearFlags::StencilBuffer) != ClearFlags::None)
 			glFlags |= GL_STENCIL_BUFFER_BIT;
@@ -85,96 +156,144 @@ namespace EngineCore
 
 	void OpenGLContext::RHISetClearColor(const glm::vec4& color)
 	{
+		if (PendingState.bIsClearColorKnown && PendingState.ClearColor == color)
+		{
+			++Stats.ClearColor.Filtered;
+			return;
+		}
+
 		glClearColor(color.r, color.g, color.b, color.a);
+
+		PendingState.bIsClearColorKnown = true;
+		PendingState.ClearColor = color;
+		++Stats.ClearColor.Issued;
 	}
 
 	void OpenGLContext::RHISetDepthFunc(const DepthFunc func)
 	{
-		// TODO:
-		//if (PendingState.DepthFunc == func)
-		//	return;
-
-		//bool isOldDepthTestActive = PendingState.DepthFunc != DepthFunc::None;
-		//if (func != DepthFunc::None && !isOldDepthTestActive)
-		//	glEnable(GL_DEPTH_TEST);
-		//else if(func == DepthFunc::None && isOldDepthTestActive)
-		//{
-		//	glDisable(GL_DEPTH_TEST);
-		//	PendingState.DepthFunc = func;
-
-		//	return;
-		//}
-
-		//switch (func)
-		//{
-		//	case DepthFunc::Less:		glDepthFunc(GL_LESS);	break;
-		//	case DepthFunc::LessEqual:	glDepthFunc(GL_LEQUAL); break;
-
-		//	default: break;
-		//}
+		if (PendingState.DepthFunc == func)
+		{
+			++Stats.Depth.Filtered;
+			return;
+		}
 
-		//PendingState.DepthFunc = func;
+		const bool wasDepthTestKnown = PendingState.DepthFunc != OpenGLRHIState::UnknownDepthFunc;
+		const bool wasDepthTestActive = wasDepthTestKnown && PendingState.DepthFunc != DepthFunc::None;
 
-		switch (func)
+		if (func == DepthFunc::None)
+		{
+			glDisable(GL_DEPTH_TEST);
+		}
+		else
 		{
-		case DepthFunc::None:		glDisable(GL_DEPTH_TEST);
-		case DepthFunc::Less:		glEnable(GL_DEPTH_TEST); glDepthFunc(GL_LESS);	break;
-		case DepthFunc::LessEqual:	glEnable(GL_DEPTH_TEST); glDepthFunc(GL_LEQUAL); break;
+			if (!wasDepthTestActive)
+				glEnable(GL_DEPTH_TEST);
 
-		default: break;
+			switch (func)
+			{
+			case DepthFunc::Less:		glDepthFunc(GL_LESS);	break;
+			case DepthFunc::LessEqual:	glDepthFunc(GL_LEQUAL); break;
+
+			default: break;
+			}
 		}
+
+		PendingState.DepthFunc = func;
+		PendingState.BoundPipelineState = nullptr;
+		++Stats.Depth.Issued;
 	}
 
 	void OpenGLContext::RHIDepthMask(const bool value)
 	{
+		if (PendingState.bIsDepthMaskKnown && PendingState.bDepthMask == value)
+		{
+			++Stats.Depth.Filtered;
+			return;
+		}
+
 		glDepthMask(value ? GL_TRUE : GL_FALSE);
+
+		PendingState.bIsDepthMaskKnown = true;
+		PendingState.bDepthMask = value;
+		PendingState.BoundPipelineState = nullptr;
+		++Stats.Depth.Issued;
 	}
 
 	void OpenGLContext::RHISetCullMode(const CullMode mode)
 	{
-		// TODO:
-		//if (PendingState.CullMode == mode)
-		//	return;
-
-		//bool isOldCullModeActive = PendingState.CullMode != CullMode::None;
-		//if (mode != CullMode::None && !isOldCullModeActive)
-		//	glEnable(GL_CULL_FACE);
-		//else if(mode == CullMode::None && isOldCullModeActive)
-		//{
-		//	glDisable(GL_CULL_FACE);
-		//	PendingState.CullMode = mode;
-
-		//	return;
-		//}
-
-		//switch (mode)
-		//{
-		//	case CullMode::Front:	glCullFace(GL_FRONT);	break;
-		//	case CullMode::Back:	glCullFace(GL_BACK);	break;
-
-		//	default: break;
-		//}
+		if (PendingState.CullMode == mode)
+		{
+			++Stats.Cull.Filtered;
+			return;
+		}
 
-		//PendingState.CullMode = mode;
+		const bool wasCullModeKnown = PendingState.CullMode != OpenGLRHIState::UnknownCullMode;
+		const bool wasCullModeActive = wasCullModeKnown && PendingState.CullMode != CullMode::None;
 
-		switch (mode)
+		if (mode == CullMode::None)
+		{
+			glDisable(GL_CULL_FACE);
+		}
+		else
 		{
-		case CullMode::None:	glDisable(GL_CULL_FACE); break;
-		case CullMode::Front:	glEnable(GL_CULL_FACE); glCullFace(GL_FRONT);	break;
-		case CullMode::Back:	glEnable(GL_CULL_FACE); glCullFace(GL_BACK);	break;
+			if (!wasCullModeActive)
+				glEnable(GL_CULL_FACE);
 
-		default: break;
+			switch (mode)
+			{
+			case CullMode::Front:	glCullFace(GL_FRONT);	break;
+			case CullMode::Back:	glCullFace(GL_BACK);	break;
+
+			default: break;
+			}
 		}
+
+		PendingState.CullMode = mode;
+		PendingState.BoundPipelineState = nullptr;
+		++Stats.Cull.Issued;
 	}
 
 	void OpenGLContext::RHISetBlendFunc(const BlendFunc func)
 	{
+		if (PendingState.BlendFunc == func)
+		{
+			++Stats.Blend.Filtered;
+			return;
+		}
+
+		const bool wasBlendKnown = PendingState.BlendFunc != OpenGLRHIState::UnknownBlendFunc;
+		const bool wasBlendActive = wasBlendKnown && PendingState.BlendFunc != BlendFunc::None;
+
+		if (func == BlendFunc::None)
+		{
+			glDisable(GL_BLEND);
+		}
+		else
+		{
+			if (!wasBlendActive)
+				glEnable(GL_BLEND);
+
+			// The equations documented at BlendFunc.
+			switch (func)
+			{
+			case BlendFunc::Zero:					glBlendFunc(GL_ONE, GL_ZERO);							break;
+			case BlendFunc::One:					glBlendFunc(GL_ONE, GL_ONE);							break;
+			case BlendFunc::SourceAlpha:			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);		break;
+			case BlendFunc::DestinationAlpha:		glBlendFunc(GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA);		break;
+			case BlendFunc::OneMinusSourceAlpha:	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);			break;
+
+			default: break;
+			}
+		}
 
+		PendingState.BlendFunc = func;
+		PendingState.BoundPipelineState = nullptr;
+		++Stats.Blend.Issued;
 	}
 
 	void OpenGLContext::RHISetViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
 	{
-		glViewport(x, y, width, height);
+		CachedViewport(x, y, width, height);
 	}
 
 	void OpenGLContext::RHISetVertexBuffer(const VertexBufferRef& vertexBuffer)
@@ -197,6 +316,31 @@ namespace EngineCore
 		PendingState.BoundShader = shader;
 	}
 
+	void OpenGLContext::RHISetPipelineState(const PipelineStateRef& pipelineState)
+	{
+		const PipelineStateDesc& desc = pipelineState->GetDesc();
+
+		// Shaders can still be bound directly, the program bind is filtered by the state cache anyway.
+		desc.Shader->Bind();
+		PendingState.BoundShader = desc.Shader;
+
+		if (PendingState.BoundPipelineState == pipelineState)
+		{
+			++Stats.PipelineState.Filtered;
+			return;
+		}
+
+		// Only the sub states that differ from the current ones reach GL.
+		RHISetCullMode(desc.Rasterizer.CullingMode);
+		RHISetDepthFunc(desc.DepthStencil.DepthTest);
+		RHIDepthMask(desc.DepthStencil.bDepthWrite);
+		RHISetBlendFunc(desc.Blend.BlendingFunc);
+
+		PendingState.Primitive = desc.Rasterizer.Primitive;
+		PendingState.BoundPipelineState = pipelineState;
+		++Stats.PipelineState.Issued;
+	}
+
 	void OpenGLContext::RHISetFrameBuffer(const FrameBufferRef& frameBuffer)
 	{
 		PendingState.BoundFrameBuffer = frameBuffer;
@@ -212,14 +356,14 @@ namespace EngineCore
 
 	}
 
-	void OpenGLContext::RHIBeginRenderPass()
+	void OpenGLContext::RHIBeginRenderPass(const char* name)
 	{
-
+		glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
 	}
 
 	void OpenGLContext::RHIEndRenderPass()
 	{
-
+		glPopDebugGroup();
 	}
 
 	void OpenGLContext::RHIDrawPrimitive()
@@ -245,41 +389,247 @@ namespace EngineCore
 
 	void OpenGLContext::RHIDrawIndexedPrimitive()
 	{
-		const uint32 count = PendingState.BoundVertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		const IndexBufferRef& indexBuffer = PendingState.BoundVertexArray->GetIndexBuffer();
+		glDrawElements(PrimitiveTypeToGl(PendingState.Primitive), indexBuffer->GetCount(), IndexTypeToGl(indexBuffer->GetIndexType()), nullptr);
 	}
 
 	void OpenGLContext::RHIDrawIndexedInstancedPrimitive(const uint32 instances)
 	{
-		const uint32 count = PendingState.BoundVertexArray->GetIndexBuffer()->GetCount();
-		glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instances);
+		const IndexBufferRef& indexBuffer = PendingState.BoundVertexArray->GetIndexBuffer();
+		glDrawElementsInstanced(PrimitiveTypeToGl(PendingState.Primitive), indexBuffer->GetCount(), IndexTypeToGl(indexBuffer->GetIndexType()), nullptr, instances);
+	}
+
+	void OpenGLContext::RHIDrawIndexedRangePrimitive(const uint32 count, const uint32 firstIndex, const int32 baseVertex)
+	{
+		const IndexBufferRef& indexBuffer = PendingState.BoundVertexArray->GetIndexBuffer();
+
+		const uint64 byteOffset = uint64(firstIndex) * GetIndexTypeSize(indexBuffer->GetIndexType());
+		glDrawElementsBaseVertex(PrimitiveTypeToGl(PendingState.Primitive), count, IndexTypeToGl(indexBuffer->GetIndexType()), reinterpret_cast<const void*>(byteOffset), baseVertex);
+	}
+
+	void OpenGLContext::RHIDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset)
+	{
+		indirectBuffer->Bind();
+
+		// FirstIndex of the commands counts indices, not bytes, so it is independent of the type.
+		const GLenum type = IndexTypeToGl(PendingState.BoundVertexArray->GetIndexBuffer()->GetIndexType());
+
+		const uint64 byteOffset = uint64(offset) * sizeof(DrawIndexedIndirectCommand);
+		glDrawElementsIndirect(PrimitiveTypeToGl(PendingState.Primitive), type, reinterpret_cast<const void*>(byteOffset));
 	}
 
-	void OpenGLContext::CachedBindVertexArray(OpenGLContextState& context, const uint32 vertexArray)
+	void OpenGLContext::RHIMultiDrawIndexedIndirect(const IndirectBufferRef& indirectBuffer, const uint32 offset, const uint32 drawCount)
 	{
-		if (context.BoundVertexArray == vertexArray)
+		indirectBuffer->Bind();
+
+		// All commands of a batch share the index buffer of the bound vertex array.
+		const GLenum type = IndexTypeToGl(PendingState.BoundVertexArray->GetIndexBuffer()->GetIndexType());
+
+		const uint64 byteOffset = uint64(offset) * sizeof(DrawIndexedIndirectCommand);
+		glMultiDrawElementsIndirect(PrimitiveTypeToGl(PendingState.Primitive), type, reinterpret_cast<const void*>(byteOffset), drawCount, 0);
+	}
+
+	void OpenGLContext::RHIDispatchCompute(const uint32 groupsX, const uint32 groupsY, const uint32 groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+	}
+
+	void OpenGLContext::CachedUseProgram(const uint32 program)
+	{
+		if (ContextState.BoundProgram == program)
+		{
+			++Stats.Program.Filtered;
 			return;
+		}
+
+		glUseProgram(program);
+
+		ContextState.BoundProgram = program;
+		++Stats.Program.Issued;
+	}
+
+	void OpenGLContext::CachedBindVertexArray(const uint32 vertexArray)
+	{
+		if (ContextState.BoundVertexArray == vertexArray)
+		{
+			++Stats.VertexArray.Filtered;
+			return;
+		}
 
 		glBindVertexArray(vertexArray);
-		context.BoundVertexArray = vertexArray;
+
+		// The element array binding is part of the vertex array object.
+		ContextState.BoundVertexArray = vertexArray;
+		ContextState.BoundIndexBuffer = OpenGLContextState::InvalidHandle;
+		++Stats.VertexArray.Issued;
+	}
+
+	void OpenGLContext::CachedBindFrameBuffer(const uint32 frameBuffer)
+	{
+		if (ContextState.BoundFrameBuffer == frameBuffer)
+		{
+			++Stats.FrameBuffer.Filtered;
+			return;
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+
+		ContextState.BoundFrameBuffer = frameBuffer;
+		++Stats.FrameBuffer.Issued;
 	}
 
-	void OpenGLContext::CachedBindVertexBuffer(OpenGLContextState& context, const uint32 vertexBuffer)
+	void OpenGLContext::CachedBindBuffer(const uint32 target, const uint32 buffer)
 	{
-		if (context.BoundVertexBuffer == vertexBuffer)
+		uint32* boundBuffer = nullptr;
+
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:			boundBuffer = &ContextState.BoundVertexBuffer;	break;
+		case GL_ELEMENT_ARRAY_BUFFER:	boundBuffer = &ContextState.BoundIndexBuffer;	break;
+		case GL_UNIFORM_BUFFER:			boundBuffer = &ContextState.BoundUniformBuffer;	break;
+		case GL_SHADER_STORAGE_BUFFER:	boundBuffer = &ContextState.BoundStorageBuffer;	break;
+		case GL_DRAW_INDIRECT_BUFFER:	boundBuffer = &ContextState.BoundIndirectBuffer;	break;
+
+		default: break;
+		}
+
+		if (boundBuffer && *boundBuffer == buffer)
+		{
+			++Stats.Buffer.Filtered;
 			return;
+		}
 
-		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
-		context.BoundVertexBuffer = vertexBuffer;
+		glBindBuffer(target, buffer);
+
+		if (boundBuffer)
+			*boundBuffer = buffer;
+
+		++Stats.Buffer.Issued;
 	}
 
-	void OpenGLContext::CachedBindIndexBuffer(OpenGLContextState& context, const uint32 indexBuffer)
+	void OpenGLContext::CachedBindBufferBase(const uint32 target, const uint32 index, const uint32 buffer)
 	{
-		if (context.BoundIndexBuffer == indexBuffer)
+		if (target != GL_UNIFORM_BUFFER || index >= OpenGLContextState::MaxUniformBufferBindings)
+		{
+			glBindBufferBase(target, index, buffer);
+			++Stats.Buffer.Issued;
+
 			return;
+		}
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-		context.BoundIndexBuffer = indexBuffer;
+		// A base binding covers the whole buffer, it is stored as range [0, InvalidHandle).
+		if (ContextState.UniformBufferBindings[index] == buffer && ContextState.UniformBufferOffsets[index] == 0
+			&& ContextState.UniformBufferSizes[index] == OpenGLContextState::InvalidHandle)
+		{
+			++Stats.Buffer.Filtered;
+			return;
+		}
+
+		glBindBufferBase(target, index, buffer);
+
+		// Binding to an indexed target also changes the generic binding point.
+		ContextState.UniformBufferBindings[index] = buffer;
+		ContextState.UniformBufferOffsets[index] = 0;
+		ContextState.UniformBufferSizes[index] = OpenGLContextState::InvalidHandle;
+		ContextState.BoundUniformBuffer = buffer;
+		++Stats.Buffer.Issued;
+	}
+
+	void OpenGLContext::CachedBindBufferRange(const uint32 target, const uint32 index, const uint32 buffer, const uint32 offset, const uint32 size)
+	{
+		if (target != GL_UNIFORM_BUFFER || index >= OpenGLContextState::MaxUniformBufferBindings)
+		{
+			glBindBufferRange(target, index, buffer, offset, size);
+			++Stats.Buffer.Issued;
+
+			return;
+		}
+
+		if (ContextState.UniformBufferBindings[index] == buffer && ContextState.UniformBufferOffsets[index] == offset
+			&& ContextState.UniformBufferSizes[index] == size)
+		{
+			++Stats.Buffer.Filtered;
+			return;
+		}
+
+		glBindBufferRange(target, index, buffer, offset, size);
+
+		ContextState.UniformBufferBindings[index] = buffer;
+		ContextState.UniformBufferOffsets[index] = offset;
+		ContextState.UniformBufferSizes[index] = size;
+		ContextState.BoundUniformBuffer = buffer;
+		++Stats.Buffer.Issued;
+	}
+
+	void OpenGLContext::CachedViewport(const uint32 x, const uint32 y, const uint32 width, const uint32 height)
+	{
+		if (ContextState.ViewportX == x && ContextState.ViewportY == y
+			&& ContextState.ViewportWidth == width && ContextState.ViewportHeight == height)
+		{
+			++Stats.Viewport.Filtered;
+			return;
+		}
+
+		glViewport(x, y, width, height);
+
+		ContextState.ViewportX = x;
+		ContextState.ViewportY = y;
+		ContextState.ViewportWidth = width;
+		ContextState.ViewportHeight = height;
+		++Stats.Viewport.Issued;
+	}
+
+	void OpenGLContext::OnDeleteProgram(const uint32 program)
+	{
+		if (ContextState.BoundProgram == program)
+			ContextState.BoundProgram = 0;
+	}
+
+	void OpenGLContext::OnDeleteVertexArray(const uint32 vertexArray)
+	{
+		if (ContextState.BoundVertexArray == vertexArray)
+		{
+			ContextState.BoundVertexArray = 0;
+			ContextState.BoundIndexBuffer = OpenGLContextState::InvalidHandle;
+		}
+	}
+
+	void OpenGLContext::OnDeleteFrameBuffer(const uint32 frameBuffer)
+	{
+		if (ContextState.BoundFrameBuffer == frameBuffer)
+			ContextState.BoundFrameBuffer = 0;
+	}
+
+	void OpenGLContext::OnDeleteBuffer(const uint32 buffer)
+	{
+		// Deleting a bound buffer resets the binding to zero.
+		if (ContextState.BoundVertexBuffer == buffer)
+			ContextState.BoundVertexBuffer = 0;
+
+		if (ContextState.BoundIndexBuffer == buffer)
+			ContextState.BoundIndexBuffer = 0;
+
+		if (ContextState.BoundUniformBuffer == buffer)
+			ContextState.BoundUniformBuffer = 0;
+
+		if (ContextState.BoundStorageBuffer == buffer)
+			ContextState.BoundStorageBuffer = 0;
+
+		if (ContextState.BoundIndirectBuffer == buffer)
+			ContextState.BoundIndirectBuffer = 0;
+
+		for (uint32 i = 0; i < OpenGLContextState::MaxUniformBufferBindings; ++i)
+		{
+			if (ContextState.UniformBufferBindings[i] == buffer)
+				ContextState.UniformBufferBindings[i] = OpenGLContextState::InvalidHandle;
+		}
+	}
+
+	void OpenGLContext::InvalidateState()
+	{
+		PendingState.Invalidate();
+		ContextState.Invalidate();
 	}
 
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include "PBR/RHIOpenGl/OpenGl.h"
 #include "PBR/RHIOpenGl/OpenGLFrameBuffer.h"
+#include "PBR/RHIOpenGL/OpenGLContext.h"
 #include "PBR/RHIOpenGL/OpenGLTexture.h"
 
 
@@ -22,7 +23,7 @@ namespace EngineCore
 		glBindRenderbuffer(GL_RENDERBUFFER, DepthHandle);
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32, width, height);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, FrameHandle);
+		OpenGLContext::Get().CachedBindFrameBuffer(FrameHandle);
 		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, DepthHandle);
 
 		if (!createInfo.RenderColorBuffer)
@@ -31,35 +32,36 @@ namespace EngineCore
 			glReadBuffer(GL_NONE);
 		}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		OpenGLContext::Get().CachedBindFrameBuffer(0);
 	}
 
 	OpenGLFrameBuffer::~OpenGLFrameBuffer()
 	{
+		OpenGLContext::Get().OnDeleteFrameBuffer(FrameHandle);
 		glDeleteFramebuffers(1, &FrameHandle);
 		glDeleteRenderbuffers(1, &DepthHandle);
 	}
 
 	void OpenGLFrameBuffer::Bind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, FrameHandle);
-		glViewport(0, 0, Width, Height);
+		OpenGLContext::Get().CachedBindFrameBuffer(FrameHandle);
+		OpenGLContext::Get().CachedViewport(0, 0, Width, Height);
 	}
 
 	void OpenGLFrameBuffer::Unbind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		OpenGLContext::Get().CachedBindFrameBuffer(0);
 	}
 
 	void OpenGLFrameBuffer::Attach(const Ref<Texture2D>& texture, const TextureAttachment attachment)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, FrameHandle);
+		OpenGLContext::Get().CachedBindFrameBuffer(FrameHandle);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, TextureAttachmentToGl(attachment), GL_TEXTURE_2D, RefCast<OpenGLTexture2D>(texture)->GetHandle(), 0);
 	}
 
 	void OpenGLFrameBuffer::Attach(const Ref<TextureCube>& cubeMap, const CubeMapOrientation orientation, const TextureAttachment attachment, const uint32 mipLevel)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, FrameHandle);
+		OpenGLContext::Get().CachedBindFrameBuffer(FrameHandle);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, TextureAttachmentToGl(attachment), CubeMapOrientationToGl(orientation), RefCast<OpenGLTextureCube>(cubeMap)->GetHandle(), mipLevel);
 	}
 
@@ -71,13 +73,13 @@ namespace EngineCore
 		glBindRenderbuffer(GL_RENDERBUFFER, DepthHandle);
 		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32, width, height);
 
-		glViewport(0, 0, width, height);
+		OpenGLContext::Get().CachedViewport(0, 0, width, height);
 	}
 
 	void OpenGLFrameBuffer::Clear()
 	{
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		OpenGLContext::Get().RHISetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		OpenGLContext::Get().RHIClear(ClearFlags::ColorBuffer | ClearFlags::DepthBuffer);
 	}
 
 	uint32 OpenGLFrameBuffer::TextureAttachmentToGl(const TextureAttachment attachment) const
@@ -0,0 +1,82 @@
+#include "pch.h"
+
+#include "PBR/RHIOpenGL/OpenGL.h"
+#include "PBR/RHIOpenGL/OpenGLGpuFence.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuFence //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLGpuFence::OpenGLGpuFence()
+		: Sync(nullptr)
+	{
+
+	}
+
+	OpenGLGpuFence::~OpenGLGpuFence()
+	{
+		Release();
+	}
+
+	void OpenGLGpuFence::Signal()
+	{
+		Release();
+		Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void OpenGLGpuFence::Wait()
+	{
+		if (!Sync)
+			return;
+
+		// The first wait flushes, so the fence is guaranteed to reach the GPU. Later waits
+		// only poll with a one millisecond timeout.
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		GLuint64 timeout = 0;
+
+		while (true)
+		{
+			const GLenum result = glClientWaitSync(static_cast<GLsync>(Sync), flags, timeout);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+				break;
+
+			if (result == GL_WAIT_FAILED)
+			{
+				std::cout << "Warning: glClientWaitSync failed." << std::endl;
+				break;
+			}
+
+			flags = 0;
+			timeout = 1000000;
+		}
+
+		Release();
+	}
+
+	bool OpenGLGpuFence::IsSignaled()
+	{
+		if (!Sync)
+			return true;
+
+		const GLenum result = glClientWaitSync(static_cast<GLsync>(Sync), 0, 0);
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+			return false;
+
+		Release();
+		return true;
+	}
+
+	void OpenGLGpuFence::Release()
+	{
+		if (!Sync)
+			return;
+
+		glDeleteSync(static_cast<GLsync>(Sync));
+		Sync = nullptr;
+	}
+
+}
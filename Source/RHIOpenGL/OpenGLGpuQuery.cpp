@@ -0,0 +1,124 @@
+#include "pch.h"
+
+#include "PBR/RHIOpenGL/OpenGL.h"
+#include "PBR/RHIOpenGL/OpenGLGpuQuery.h"
+
+#ifndef GL_VERTICES_SUBMITTED
+#define GL_VERTICES_SUBMITTED			0x82EE
+#define GL_PRIMITIVES_SUBMITTED			0x82EF
+#define GL_VERTEX_SHADER_INVOCATIONS	0x82F0
+#define GL_FRAGMENT_SHADER_INVOCATIONS	0x82F4
+#define GL_CLIPPING_INPUT_PRIMITIVES	0x82F6
+#define GL_CLIPPING_OUTPUT_PRIMITIVES	0x82F7
+#endif
+
+
+namespace EngineCore
+{
+
+	static const GLenum StatisticsTargets[OpenGLGpuStatisticsQuery::CounterCount] = {
+		GL_VERTICES_SUBMITTED,
+		GL_PRIMITIVES_SUBMITTED,
+		GL_VERTEX_SHADER_INVOCATIONS,
+		GL_CLIPPING_INPUT_PRIMITIVES,
+		GL_CLIPPING_OUTPUT_PRIMITIVES,
+		GL_FRAGMENT_SHADER_INVOCATIONS
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuTimestampQuery /////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLGpuTimestampQuery::OpenGLGpuTimestampQuery()
+		: RendererId(0)
+	{
+		glGenQueries(1, &RendererId);
+	}
+
+	OpenGLGpuTimestampQuery::~OpenGLGpuTimestampQuery()
+	{
+		glDeleteQueries(1, &RendererId);
+	}
+
+	void OpenGLGpuTimestampQuery::Issue()
+	{
+		glQueryCounter(RendererId, GL_TIMESTAMP);
+	}
+
+	bool OpenGLGpuTimestampQuery::IsResultAvailable()
+	{
+		GLuint available = GL_FALSE;
+		glGetQueryObjectuiv(RendererId, GL_QUERY_RESULT_AVAILABLE, &available);
+
+		return available == GL_TRUE;
+	}
+
+	uint64 OpenGLGpuTimestampQuery::GetResult()
+	{
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(RendererId, GL_QUERY_RESULT, &result);
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLGpuStatisticsQuery ////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	OpenGLGpuStatisticsQuery::OpenGLGpuStatisticsQuery()
+	{
+		glGenQueries(CounterCount, RendererIds);
+	}
+
+	OpenGLGpuStatisticsQuery::~OpenGLGpuStatisticsQuery()
+	{
+		glDeleteQueries(CounterCount, RendererIds);
+	}
+
+	void OpenGLGpuStatisticsQuery::Begin()
+	{
+		for (uint32 i = 0; i < CounterCount; ++i)
+			glBeginQuery(StatisticsTargets[i], RendererIds[i]);
+	}
+
+	void OpenGLGpuStatisticsQuery::End()
+	{
+		for (uint32 i = 0; i < CounterCount; ++i)
+			glEndQuery(StatisticsTargets[i]);
+	}
+
+	bool OpenGLGpuStatisticsQuery::IsResultAvailable()
+	{
+		// Results become available in order, the last counter is enough.
+		GLuint available = GL_FALSE;
+		glGetQueryObjectuiv(RendererIds[CounterCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		return available == GL_TRUE;
+	}
+
+	void OpenGLGpuStatisticsQuery::GetResult(PipelineStatistics& statistics)
+	{
+		GLuint64 results[CounterCount] = { };
+		for (uint32 i = 0; i < CounterCount; ++i)
+			glGetQueryObjectui64v(RendererIds[i], GL_QUERY_RESULT, &results[i]);
+
+		statistics.VerticesSubmitted = results[0];
+		statistics.PrimitivesSubmitted = results[1];
+		statistics.VertexShaderInvocations = results[2];
+		statistics.ClippingInputPrimitives = results[3];
+		statistics.ClippingOutputPrimitives = results[4];
+		statistics.FragmentShaderInvocations = results[5];
+	}
+
+	bool OpenGLGpuStatisticsQuery::IsSupported()
+	{
+		// Unknown targets report zero counter bits (and raise GL_INVALID_ENUM, which is cleared).
+		GLint bits = 0;
+		glGetQueryiv(GL_VERTICES_SUBMITTED, GL_QUERY_COUNTER_BITS, &bits);
+
+		while (glGetError() != GL_NO_ERROR) { }
+
+		return bits > 0;
+	}
+
+}
@@ -1,19 +1,44 @@
 #include "pch.h"
 
 #include <iostream>
+#include <vector>
 
 #include "PBR/RHIOpenGL/OpenGL.h"
 #include "PBR/RHIOpenGL/OpenGLShader.h"
+#include "PBR/RHIOpenGL/OpenGLContext.h"
 
 namespace EngineCore
 {
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLShaderUtils ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Part of the cache keys, binaries of another driver or driver version are never restored.
+	static const std::string& GetDriverDescription()
+	{
+		static const std::string description =
+			std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + "|" +
+			std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) + "|" +
+			std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+		return description;
+	}
+
+	static bool IsProgramBinarySupported()
+	{
+		int32 formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+		return formatCount > 0;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLShader ////////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	OpenGLShader::OpenGLShader(const std::string& name, const ShaderSource& source)
-		: Handle(CreateShader(source))
+	OpenGLShader::OpenGLShader(const std::string& name, const ShaderSource& source, ShaderCache* cache)
+		: Handle(CreateShader(name, source, cache))
 		, Name(name)
 		, UniformLocationCache()
 	{
@@ -21,17 +46,18 @@ namespace EngineCore
 
 	OpenGLShader::~OpenGLShader()
 	{
+		OpenGLContext::Get().OnDeleteProgram(Handle);
 		glDeleteProgram(Handle);
 	}
 
 	void OpenGLShader::Bind() const
 	{
-		glUseProgram(Handle);
+		OpenGLContext::Get().CachedUseProgram(Handle);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		glUseProgram(0);
+		OpenGLContext::Get().CachedUseProgram(0);
 	}
 
 	void OpenGLShader::BindBlock(const std::string& name, const uint32 blockBinding)
@@ -107,7 +133,9 @@ namespace EngineCore
 			char* message = static_cast<char*>(alloca(length * sizeof(char)));
 			glGetShaderInfoLog(id, length, &length, message);
 
-			std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << std::endl;
+			const char* stage = type == GL_VERTEX_SHADER ? "vertex" : type == GL_COMPUTE_SHADER ? "compute" : "fragment";
+
+			std::cout << "Failed to compile " << stage << " shader!" << std::endl;
 			std::cout << message << std::endl;
 
 			glDeleteShader(id);
@@ -117,15 +145,42 @@ namespace EngineCore
 		return id;
 	}
 
-	uint32 OpenGLShader::CreateShader(const ShaderSource& source) const
+	uint32 OpenGLShader::CreateShader(const std::string& name, const ShaderSource& source, ShaderCache* cache) const
 	{
+		if (cache && (!cache->IsEnabled() || !IsProgramBinarySupported()))
+			cache = nullptr;
+
+		const uint64 key = cache ? ShaderCache::ComputeKey(source, GetDriverDescription()) : 0;
+
+		if (cache)
+		{
+			const uint32 program = LoadProgram(name, key, *cache);
+			if (program)
+				return program;
+		}
+
 		const uint32 program = glCreateProgram();
 
-		const uint32 vs = CompileShader(source.VertexSource, GL_VERTEX_SHADER);
-		const uint32 fs = CompileShader(source.FragmentSource, GL_FRAGMENT_SHADER);
+		if (cache)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-		glAttachShader(program, vs);
-		glAttachShader(program, fs);
+		// Compute programs consist of the compute stage only.
+		uint32 stages[2] = { 0, 0 };
+		if (!source.ComputeSource.empty())
+		{
+			stages[0] = CompileShader(source.ComputeSource, GL_COMPUTE_SHADER);
+		}
+		else
+		{
+			stages[0] = CompileShader(source.VertexSource, GL_VERTEX_SHADER);
+			stages[1] = CompileShader(source.FragmentSource, GL_FRAGMENT_SHADER);
+		}
+
+		for (const uint32 stage : stages)
+		{
+			if (stage)
+				glAttachShader(program, stage);
+		}
 
 		glLinkProgram(program);
 
@@ -149,12 +204,60 @@ namespace EngineCore
 
 		glValidateProgram(program);
 
-		glDeleteShader(vs);
-		glDeleteShader(fs);
+		for (const uint32 stage : stages)
+		{
+			if (stage)
+				glDeleteShader(stage);
+		}
+
+		if (cache)
+			StoreProgram(name, key, program, *cache);
+
+		return program;
+	}
+
+	uint32 OpenGLShader::LoadProgram(const std::string& name, const uint64 key, ShaderCache& cache) const
+	{
+		uint32 format = 0;
+		std::vector<byte> binary;
+
+		if (!cache.Load(name, key, format, binary))
+			return 0;
+
+		const uint32 program = glCreateProgram();
+		glProgramBinary(program, format, binary.data(), static_cast<int32>(binary.size()));
+
+		int32 success = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+		// Drivers may reject binaries for reasons the key does not cover, e.g. other hardware with
+		// the same renderer string. The program is compiled and the entry replaced.
+		if (success == GL_FALSE)
+		{
+			std::cout << "Warning: Cached program " << name << " was rejected by the driver, compiling it." << std::endl;
+
+			glDeleteProgram(program);
+			return 0;
+		}
 
 		return program;
 	}
 
+	void OpenGLShader::StoreProgram(const std::string& name, const uint64 key, const uint32 program, ShaderCache& cache) const
+	{
+		int32 length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if (length <= 0)
+			return;
+
+		std::vector<byte> binary(length);
+		uint32 format = 0;
+
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+		cache.Store(name, key, format, binary.data(), static_cast<uint32>(length));
+	}
+
 	int32 OpenGLShader::GetUniformLocation(const std::string& name)
 	{
 		if (UniformLocationCache.find(name) != UniformLocationCache.end())
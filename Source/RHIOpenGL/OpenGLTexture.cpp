@@ -2,6 +2,18 @@
 
 #include "PBR/RHIOpenGL/OpenGL.h"
 #include "PBR/RHIOpenGL/OpenGLTexture.h"
+#include "PBR/RHI/TextureEncoder.h"
+#include "PBR/RHI/DeferredReleaseQueue.h"
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT		0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT		0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT	0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT	0x8C4F
+#endif
 
 
 namespace EngineCore
@@ -46,6 +58,16 @@ namespace EngineCore
 		case TextureFormat::Depth16:			return GL_DEPTH_COMPONENT16;
 		case TextureFormat::Depth32:			return GL_DEPTH_COMPONENT32;
 
+		case TextureFormat::Bc1:				return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case TextureFormat::Bc1Srgb:			return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+		case TextureFormat::Bc3:				return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case TextureFormat::Bc3Srgb:			return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+		case TextureFormat::Bc4:				return GL_COMPRESSED_RED_RGTC1;
+		case TextureFormat::Bc5:				return GL_COMPRESSED_RG_RGTC2;
+		case TextureFormat::Bc6h:				return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+		case TextureFormat::Bc7:				return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		case TextureFormat::Bc7Srgb:			return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+
 		default: break;
 		}
 
@@ -97,20 +119,60 @@ namespace EngineCore
 		return 0;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// OpenGLRetiredTexture ////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Texture object replaced by SetFirstResidentMip(). Its bindless handle stays valid until the
+	// frames in flight that read it from material buffers have retired.
+	struct OpenGLRetiredTexture : public RefCountedObject
+	{
+
+		OpenGLRetiredTexture(const uint32 handle)
+			: Handle(handle)
+		{
+		}
+
+		virtual ~OpenGLRetiredTexture()
+		{
+			glDeleteTextures(1, &Handle);
+		}
+
+		uint32 Handle;
+
+	};
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	// OpenGLTexture2D /////////////////////////////////////////////////////////////////////////////////
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLTexture2D::OpenGLTexture2D(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo)
-		: Width(width), Height(height), CreateInfo(createInfo)
+		: Handle(0)
+		, ShaderHandle(0)
+		, Width(width)
+		, Height(height)
+		, MipCount(createInfo.UseMipMaps ? GetMipLevelCount(width, height) : 1)
+		, MemorySize(GetTextureMemorySize(width, height, 1, createInfo))
+		, bIsResident(false)
+		, CreateInfo(createInfo)
 	{
-		Create(width, height, nullptr, createInfo);
+		assert(CreateInfo.FirstResidentMip < MipCount); // "First resident mip out of range."
+		Create(nullptr);
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const uint32 width, const uint32 height, const void* data, const TextureCreateInfo& createInfo)
-		: Width(width), Height(height), CreateInfo(createInfo)
+		: Handle(0)
+		, ShaderHandle(0)
+		, Width(width)
+		, Height(height)
+		, MipCount(createInfo.UseMipMaps ? GetMipLevelCount(width, height) : 1)
+		, MemorySize(GetTextureMemorySize(width, height, 1, createInfo))
+		, bIsResident(false)
+		, CreateInfo(createInfo)
 	{
-		Create(width, height, data, createInfo);
+		assert(CreateInfo.FirstResidentMip == 0); // "Textures created with data have all levels resident."
+		assert(!IsCompressedTextureFormat(CreateInfo.InternalFormat) || !CreateInfo.UseMipMaps); // "Compressed mip maps are set with SetMipData()."
+		Create(data);
 	}
 
 	OpenGLTexture2D::~OpenGLTexture2D()
@@ -129,6 +191,19 @@ namespace EngineCore
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	void OpenGLTexture2D::SetResident(const bool resident)
+	{
+		if (bIsResident == resident)
+			return;
+
+		if (resident)
+			glMakeTextureHandleResidentARB(ShaderHandle);
+		else
+			glMakeTextureHandleNonResidentARB(ShaderHandle);
+
+		bIsResident = resident;
+	}
+
 	void OpenGLTexture2D::SetData(const byte* data)
 	{
 		glBindTexture(GL_TEXTURE_2D, Handle);
@@ -136,54 +211,253 @@ namespace EngineCore
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
-	void OpenGLTexture2D::Create(const uint32 width, const uint32 height, const void* data, const TextureCreateInfo& createInfo)
+	void OpenGLTexture2D::SetFirstResidentMip(const uint32 mip)
+	{
+		assert(mip < MipCount); // "First resident mip out of range."
+
+		const uint32 previousMip = CreateInfo.FirstResidentMip;
+		if (mip == previousMip)
+			return;
+
+		const uint32 previousHandle = Handle;
+		const bool resident = bIsResident;
+
+		// Bindless textures are immutable once a handle exists, so a new one is created.
+		CreateInfo.FirstResidentMip = mip;
+		MemorySize = GetTextureMemorySize(Width, Height, 1, CreateInfo);
+
+		bIsResident = false;
+		Create(nullptr);
+
+		for (uint32 level = std::max(mip, previousMip); level < MipCount; ++level)
+		{
+			glCopyImageSubData(
+				previousHandle, GL_TEXTURE_2D, level - previousMip, 0, 0, 0,
+				Handle, GL_TEXTURE_2D, level - mip, 0, 0, 0,
+				GetMipLevelSize(Width, level), GetMipLevelSize(Height, level), 1
+			);
+		}
+
+		// The driver keeps the storage alive for commands already issued, but nothing guarantees
+		// that for bindless handles read from buffers. The deletion waits for the frames in flight.
+		DeferredReleaseQueue* releaseQueue = DeferredReleaseQueue::GetInstance();
+		if (releaseQueue)
+			releaseQueue->Release(new OpenGLRetiredTexture(previousHandle));
+		else
+			glDeleteTextures(1, &previousHandle);
+
+		SetResident(resident);
+	}
+
+	void OpenGLTexture2D::SetMipData(const uint32 mip, const void* data)
+	{
+		assert(mip >= CreateInfo.FirstResidentMip && mip < MipCount); // "Mip level is not resident."
+
+		const uint32 width = GetMipLevelSize(Width, mip);
+		const uint32 height = GetMipLevelSize(Height, mip);
+
+		glBindTexture(GL_TEXTURE_2D, Handle);
+
+		if (IsCompressedTextureFormat(CreateInfo.InternalFormat))
+		{
+			glCompressedTexSubImage2D(
+				GL_TEXTURE_2D,
+				mip - CreateInfo.FirstResidentMip,
+				0,
+				0,
+				width,
+				height,
+				OpenGLTextureUtils::TextureFormatToGl(CreateInfo.InternalFormat),
+				static_cast<GLsizei>(GetTextureLevelDataSize(width, height, CreateInfo)),
+				data
+			);
+		}
+		else
+		{
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+			glTexSubImage2D(
+				GL_TEXTURE_2D,
+				mip - CreateInfo.FirstResidentMip,
+				0,
+				0,
+				width,
+				height,
+				OpenGLTextureUtils::TextureFormatToGl(CreateInfo.Format),
+				OpenGLTextureUtils::TextureDataTypeToGl(CreateInfo.DataType),
+				data
+			);
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLTexture2D::SetMipData(const uint32 mip, const PixelBufferRef& buffer, const uint32 offset)
+	{
+		// With a buffer bound to the unpack target the data pointer is an offset into it.
+		buffer->Bind();
+		SetMipData(mip, reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)));
+		buffer->Unbind();
+	}
+
+	void OpenGLTexture2D::Fill(const glm::vec4& color)
+	{
+		if (!IsCompressedTextureFormat(CreateInfo.InternalFormat))
+		{
+			for (uint32 level = 0; level < MipCount - CreateInfo.FirstResidentMip; ++level)
+				glClearTexImage(Handle, level, GL_RGBA, GL_FLOAT, &color[0]);
+
+			return;
+		}
+
+		// Compressed textures cannot be cleared, every level is uploaded as copies of one block.
+		if (!TextureEncoder::CanEncode(CreateInfo.InternalFormat))
+		{
+			std::cout << "Warning: Compressed texture format cannot be filled." << std::endl;
+			return;
+		}
+
+		const uint32 blockSize = GetTextureBlockSize(CreateInfo.InternalFormat);
+
+		byte block[16];
+		if (TextureEncoder::GetSourceDataType(CreateInfo.InternalFormat) == TextureDataType::Float)
+		{
+			float texels[16 * 4];
+			for (uint32 i = 0; i < 16 * 4; ++i)
+				texels[i] = color[i % 4];
+
+			TextureEncoder::Encode(texels, 4, 4, 4, CreateInfo.InternalFormat, block);
+		}
+		else
+		{
+			byte texels[16 * 4];
+			for (uint32 i = 0; i < 16 * 4; ++i)
+				texels[i] = static_cast<byte>(std::clamp(color[i % 4], 0.0f, 1.0f) * 255.0f + 0.5f);
+
+			TextureEncoder::Encode(texels, 4, 4, 4, CreateInfo.InternalFormat, block);
+		}
+
+		std::vector<byte> level(static_cast<size_t>(GetTextureLevelDataSize(GetMipLevelSize(Width, CreateInfo.FirstResidentMip), GetMipLevelSize(Height, CreateInfo.FirstResidentMip), CreateInfo)));
+		for (size_t offset = 0; offset < level.size(); offset += blockSize)
+			std::memcpy(level.data() + offset, block, blockSize);
+
+		for (uint32 mip = CreateInfo.FirstResidentMip; mip < MipCount; ++mip)
+			SetMipData(mip, level.data());
+	}
+
+	void OpenGLTexture2D::GenerateMipMaps()
+	{
+		assert(CreateInfo.FirstResidentMip == 0); // "Level 0 is not resident."
+		assert(!IsCompressedTextureFormat(CreateInfo.InternalFormat)); // "Compressed mip maps are encoded on the CPU."
+
+		glBindTexture(GL_TEXTURE_2D, Handle);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void OpenGLTexture2D::BindImage(const uint32 unit, const uint32 mip) const
 	{
+		assert(mip >= CreateInfo.FirstResidentMip && mip < MipCount); // "Mip level is not resident."
+		assert(IsImageTextureFormat(CreateInfo.InternalFormat)); // "Format cannot be bound to image units."
+
+		glBindImageTexture(unit, Handle, mip - CreateInfo.FirstResidentMip, GL_FALSE, 0, GL_READ_WRITE, OpenGLTextureUtils::TextureFormatToGl(CreateInfo.InternalFormat));
+	}
+
+	void OpenGLTexture2D::Create(const void* data)
+	{
+		const uint32 firstMip = CreateInfo.FirstResidentMip;
+
 		glGenTextures(1, &Handle);
 		glBindTexture(GL_TEXTURE_2D, Handle);
 
-		if (createInfo.UseMipMaps)
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, createInfo.Filter == TextureFilter::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST);
+		if (CreateInfo.UseMipMaps)
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, CreateInfo.Filter == TextureFilter::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST);
 		else
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, createInfo.Filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, CreateInfo.Filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, createInfo.Filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, OpenGLTextureUtils::TextureWrapToGl(createInfo.Wrap));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, OpenGLTextureUtils::TextureWrapToGl(createInfo.Wrap));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, CreateInfo.Filter == TextureFilter::Linear ? GL_LINEAR : GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, OpenGLTextureUtils::TextureWrapToGl(CreateInfo.Wrap));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, OpenGLTextureUtils::TextureWrapToGl(CreateInfo.Wrap));
 
-		if (createInfo.IsShadowTexture)
+		if (CreateInfo.IsShadowTexture)
 		{
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
 		}
 
-		glTexImage2D(
-			GL_TEXTURE_2D,
-			0,
-			OpenGLTextureUtils::TextureFormatToGl(createInfo.InternalFormat),
-			width,
-			height,
-			0,
-			OpenGLTextureUtils::TextureFormatToGl(createInfo.Format),
-			OpenGLTextureUtils::TextureDataTypeToGl(createInfo.DataType),
-			data
-		);
-
-		if (createInfo.UseMipMaps)
+		if (IsCompressedTextureFormat(CreateInfo.InternalFormat))
 		{
-			glGenerateMipmap(GL_TEXTURE_2D);
-
-			if (createInfo.AnisotropyLevel > 0.0f)
+			// Allocated without data unless there is only one level, the others are set by SetMipData().
+			for (uint32 level = firstMip; level < MipCount; ++level)
 			{
-				float maxAnisotropy = 0.0f;
-				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+				const uint32 width = GetMipLevelSize(Width, level);
+				const uint32 height = GetMipLevelSize(Height, level);
+
+				glCompressedTexImage2D(
+					GL_TEXTURE_2D,
+					level - firstMip,
+					OpenGLTextureUtils::TextureFormatToGl(CreateInfo.InternalFormat),
+					width,
+					height,
+					0,
+					static_cast<GLsizei>(GetTextureLevelDataSize(width, height, CreateInfo)),
+					level == 0 ? data : nullptr
+				);
+			}
 
-				float amount = std::min(maxAnisotropy, createInfo.AnisotropyLevel);
-				glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, amount);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MipCount - 1 - firstMip);
+		}
+		else if (firstMip == 0 && data)
+		{
+			glTexImage2D(
+				GL_TEXTURE_2D,
+				0,
+				OpenGLTextureUtils::TextureFormatToGl(CreateInfo.InternalFormat),
+				Width,
+				Height,
+				0,
+				OpenGLTextureUtils::TextureFormatToGl(CreateInfo.Format),
+				OpenGLTextureUtils::TextureDataTypeToGl(CreateInfo.DataType),
+				data
+			);
+
+			if (CreateInfo.UseMipMaps)
+				glGenerateMipmap(GL_TEXTURE_2D);
+		}
+		else
+		{
+			// Levels are filled by SetMipData() or rendered to, generating them from an undefined level 0
+			// would only cost time.
+			for (uint32 level = firstMip; level < MipCount; ++level)
+			{
+				glTexImage2D(
+					GL_TEXTURE_2D,
+					level - firstMip,
+					OpenGLTextureUtils::TextureFormatToGl(CreateInfo.InternalFormat),
+					GetMipLevelSize(Width, level),
+					GetMipLevelSize(Height, level),
+					0,
+					OpenGLTextureUtils::TextureFormatToGl(CreateInfo.Format),
+					OpenGLTextureUtils::TextureDataTypeToGl(CreateInfo.DataType),
+					nullptr
+				);
 			}
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MipCount - 1 - firstMip);
+		}
+
+		if (CreateInfo.UseMipMaps && CreateInfo.AnisotropyLevel > 0.0f)
+		{
+			float maxAnisotropy = 0.0f;
+			glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+
+			float amount = std::min(maxAnisotropy, CreateInfo.AnisotropyLevel);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, amount);
 		}
 
 		ShaderHandle = glGetTextureHandleARB(Handle);
-		glMakeTextureHandleResidentARB(ShaderHandle);
 
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
@@ -193,13 +467,13 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	OpenGLTextureCube::OpenGLTextureCube(const uint32 width, const uint32 height, const TextureCreateInfo& createInfo)
-		: Handle(0), Width(width), Height(height)
+		: Handle(0), Width(width), Height(height), MemorySize(GetTextureMemorySize(width, height, 6, createInfo)), bIsResident(false)
 	{
 		Create(Width, height, CubeMapCreateData(), createInfo);
 	}
 
 	OpenGLTextureCube::OpenGLTextureCube(const uint32 width, const uint32 height, const CubeMapCreateData& data, const TextureCreateInfo& createInfo)
-		: Handle(0), Width(width), Height(height)
+		: Handle(0), Width(width), Height(height), MemorySize(GetTextureMemorySize(width, height, 6, createInfo)), bIsResident(false)
 	{
 		Create(width, height, data, createInfo);
 	}
@@ -220,6 +494,19 @@ namespace EngineCore
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
+	void OpenGLTextureCube::SetResident(const bool resident)
+	{
+		if (bIsResident == resident)
+			return;
+
+		if (resident)
+			glMakeTextureHandleResidentARB(ShaderHandle);
+		else
+			glMakeTextureHandleNonResidentARB(ShaderHandle);
+
+		bIsResident = resident;
+	}
+
 	void OpenGLTextureCube::SetData(const byte* data, const CubeMapOrientation orientation)
 	{
 		// TODO:
@@ -252,7 +539,6 @@ namespace EngineCore
 			glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 		ShaderHandle = glGetTextureHandleARB(Handle);
-		glMakeTextureHandleResidentARB(ShaderHandle);
 
 		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
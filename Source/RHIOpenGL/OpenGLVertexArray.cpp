@@ -6,6 +6,7 @@
 
 #include "PBR/RHIOpenGL/OpenGL.h"
 #include "PBR/RHIOpenGL/OpenGLVertexArray.h"
+#include "PBR/RHIOpenGL/OpenGLContext.h"
 
 
 
@@ -27,17 +28,18 @@ namespace EngineCore
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
+		OpenGLContext::Get().OnDeleteVertexArray(Handle);
 		glDeleteVertexArrays(1, &Handle);
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
-		glBindVertexArray(Handle);
+		OpenGLContext::Get().CachedBindVertexArray(Handle);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		OpenGLContext::Get().CachedBindVertexArray(0);
 	}
 
 	GLenum ShaderDataTypeToGlBaseType(const ShaderDataType type)
@@ -59,6 +61,11 @@ namespace EngineCore
 
 		case ShaderDataType::Bool:		return GL_BOOL;
 
+		case ShaderDataType::Half2:		return GL_HALF_FLOAT;
+		case ShaderDataType::Half4:		return GL_HALF_FLOAT;
+		case ShaderDataType::Short2:	return GL_SHORT;
+		case ShaderDataType::Short4:	return GL_SHORT;
+
 		default: break;
 		}
 
@@ -69,7 +76,7 @@ namespace EngineCore
 	{
 		assert(buffer->GetLayout().GetElements().size()); // "VertexBuffer has no layout."
 
-		glBindVertexArray(Handle);
+		OpenGLContext::Get().CachedBindVertexArray(Handle);
 		buffer->Bind();
 
 		uint32 offset = 0;
@@ -99,7 +106,7 @@ namespace EngineCore
 
 	void OpenGLVertexArray::SetIndexBuffer(const IndexBufferRef& buffer)
 	{
-		glBindVertexArray(Handle);
+		OpenGLContext::Get().CachedBindVertexArray(Handle);
 		buffer->Bind();
 
 		IndexBuffer = buffer;
@@ -0,0 +1,397 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "PBR/RenderCore/GeometryPool.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RangeAllocator //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RangeAllocator::RangeAllocator(const uint32 capacity)
+		: FreeRanges()
+		, Capacity(capacity)
+		, FreeSize(capacity)
+	{
+		if (capacity)
+			FreeRanges.push_back({ 0, capacity });
+	}
+
+	RangeAllocator::~RangeAllocator()
+	{
+
+	}
+
+	uint32 RangeAllocator::Allocate(const uint32 size)
+	{
+		assert(size); // "Empty ranges cannot be allocated."
+
+		for (uint32 i = 0; i < FreeRanges.size(); ++i)
+		{
+			Range& range = FreeRanges[i];
+			if (range.Size < size)
+				continue;
+
+			const uint32 offset = range.Offset;
+
+			range.Offset += size;
+			range.Size -= size;
+
+			if (!range.Size)
+				FreeRanges.erase(FreeRanges.begin() + i);
+
+			FreeSize -= size;
+			return offset;
+		}
+
+		return InvalidOffset;
+	}
+
+	void RangeAllocator::Free(const uint32 offset, const uint32 size)
+	{
+		assert(offset + size <= Capacity); // "Freed range out of the allocator bounds."
+
+		auto next = std::lower_bound(FreeRanges.begin(), FreeRanges.end(), offset, [](const Range& range, const uint32 value) { return range.Offset < value; });
+
+		assert(next == FreeRanges.end() || offset + size <= next->Offset); // "Range freed twice."
+
+		const bool mergesPrevious = next != FreeRanges.begin() && (next - 1)->Offset + (next - 1)->Size == offset;
+		const bool mergesNext = next != FreeRanges.end() && offset + size == next->Offset;
+
+		if (mergesPrevious && mergesNext)
+		{
+			(next - 1)->Size += size + next->Size;
+			FreeRanges.erase(next);
+		}
+		else if (mergesPrevious)
+		{
+			(next - 1)->Size += size;
+		}
+		else if (mergesNext)
+		{
+			next->Offset = offset;
+			next->Size += size;
+		}
+		else
+		{
+			FreeRanges.insert(next, { offset, size });
+		}
+
+		FreeSize += size;
+	}
+
+	void RangeAllocator::Grow(const uint32 capacity)
+	{
+		assert(capacity >= Capacity); // "RangeAllocator cannot shrink."
+
+		if (capacity == Capacity)
+			return;
+
+		const uint32 added = capacity - Capacity;
+		const uint32 offset = Capacity;
+
+		Capacity = capacity;
+		Free(offset, added);
+	}
+
+	void RangeAllocator::Reset(const uint32 usedSize)
+	{
+		assert(usedSize <= Capacity); // "RangeAllocator::Reset out of bounds."
+
+		FreeRanges.clear();
+		FreeSize = Capacity - usedSize;
+
+		if (FreeSize)
+			FreeRanges.push_back({ usedSize, FreeSize });
+	}
+
+	float RangeAllocator::GetFragmentation() const
+	{
+		if (!FreeSize)
+			return 0.0f;
+
+		uint32 largest = 0;
+		for (const Range& range : FreeRanges)
+			largest = std::max(largest, range.Size);
+
+		return 1.0f - static_cast<float>(largest) / static_cast<float>(FreeSize);
+	}
+
+	bool RangeAllocator::IsCompact() const
+	{
+		return FreeRanges.empty() || (FreeRanges.size() == 1 && FreeRanges[0].Offset + FreeRanges[0].Size == Capacity);
+	}
+
+	uint32 RangeAllocator::GetTrailingFreeSize() const
+	{
+		if (FreeRanges.empty() || FreeRanges.back().Offset + FreeRanges.back().Size != Capacity)
+			return 0;
+
+		return FreeRanges.back().Size;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryBuffer //////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GeometryBuffer::GeometryBuffer(const BufferLayout& layout, const IndexType indexType, const uint32 vertexCapacity, const uint32 indexCapacity)
+		: Layout(layout)
+		, Type(indexType)
+		, VertexStride(layout.GetStride())
+		, IndexStride(GetIndexTypeSize(indexType))
+		, VertexRanges(vertexCapacity)
+		, IndexRanges(indexCapacity)
+		, VertexData(size_t(vertexCapacity) * layout.GetStride())
+		, IndexData(size_t(indexCapacity) * GetIndexTypeSize(indexType))
+		, Allocations()
+		, FreeHandles()
+		, VertexArray()
+		, Mutex()
+	{
+		CreateBuffers();
+	}
+
+	GeometryBuffer::~GeometryBuffer()
+	{
+
+	}
+
+	GeometryHandle GeometryBuffer::Allocate(const void* vertices, const uint32 vertexCount, const void* indices, const uint32 indexCount)
+	{
+		assert(vertexCount && indexCount); // "Empty geometry cannot be allocated."
+		assert(Type == IndexType::UInt32 || vertexCount <= 0xFFFF + 1); // "Too many vertices for 16 bit indices."
+
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		uint32 firstVertex = VertexRanges.Allocate(vertexCount);
+		uint32 firstIndex = IndexRanges.Allocate(indexCount);
+
+		bool bIsGrown = false;
+
+		if (firstVertex == RangeAllocator::InvalidOffset || firstIndex == RangeAllocator::InvalidOffset)
+		{
+			if (firstVertex != RangeAllocator::InvalidOffset)
+				VertexRanges.Free(firstVertex, vertexCount);
+
+			if (firstIndex != RangeAllocator::InvalidOffset)
+				IndexRanges.Free(firstIndex, indexCount);
+
+			// Meshes drawn by pending command lists and indirect arguments must keep their offsets,
+			// so the buffers only grow at the end until the trailing free range fits. Scattered free
+			// space is left to Defragment() at the start of a frame.
+			const uint32 vertexEnd = VertexRanges.GetCapacity() - VertexRanges.GetTrailingFreeSize();
+			uint32 vertexCapacity = VertexRanges.GetCapacity();
+			while (vertexCapacity - vertexEnd < vertexCount)
+				vertexCapacity *= 2;
+
+			const uint32 indexEnd = IndexRanges.GetCapacity() - IndexRanges.GetTrailingFreeSize();
+			uint32 indexCapacity = IndexRanges.GetCapacity();
+			while (indexCapacity - indexEnd < indexCount)
+				indexCapacity *= 2;
+
+			bIsGrown = Grow(vertexCapacity, indexCapacity);
+
+			firstVertex = VertexRanges.Allocate(vertexCount);
+			firstIndex = IndexRanges.Allocate(indexCount);
+		}
+
+		assert(firstVertex != RangeAllocator::InvalidOffset && firstIndex != RangeAllocator::InvalidOffset); // "Geometry allocation failed."
+
+		std::memcpy(VertexData.data() + size_t(firstVertex) * VertexStride, vertices, size_t(vertexCount) * VertexStride);
+		std::memcpy(IndexData.data() + size_t(firstIndex) * IndexStride, indices, size_t(indexCount) * IndexStride);
+
+		if (bIsGrown)
+		{
+			Upload();
+		}
+		else
+		{
+			VertexArray->GetVertexBuffers()[0]->SetData(vertices, firstVertex * VertexStride, vertexCount * VertexStride);
+			VertexArray->GetIndexBuffer()->SetData(indices, firstIndex, indexCount);
+		}
+
+		GeometryHandle handle;
+		if (!FreeHandles.empty())
+		{
+			handle = FreeHandles.back();
+			FreeHandles.pop_back();
+		}
+		else
+		{
+			handle = static_cast<GeometryHandle>(Allocations.size());
+			Allocations.emplace_back();
+		}
+
+		Allocations[handle] = { firstVertex, vertexCount, firstIndex, indexCount };
+		return handle;
+	}
+
+	void GeometryBuffer::Free(const GeometryHandle handle)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		assert(handle < Allocations.size() && Allocations[handle].VertexCount); // "Invalid geometry handle."
+
+		GeometryAllocation& allocation = Allocations[handle];
+
+		VertexRanges.Free(allocation.FirstVertex, allocation.VertexCount);
+		IndexRanges.Free(allocation.FirstIndex, allocation.IndexCount);
+
+		allocation = GeometryAllocation();
+		FreeHandles.push_back(handle);
+	}
+
+	bool GeometryBuffer::Defragment()
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return Compact();
+	}
+
+	float GeometryBuffer::GetFragmentation() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return std::max(VertexRanges.GetFragmentation(), IndexRanges.GetFragmentation());
+	}
+
+	bool GeometryBuffer::Compact()
+	{
+		if (VertexRanges.IsCompact() && IndexRanges.IsCompact())
+			return false;
+
+		PROFILE_SCOPE("GeometryBuffer::Defragment");
+
+		std::vector<GeometryHandle> order;
+		order.reserve(Allocations.size());
+
+		for (GeometryHandle handle = 0; handle < Allocations.size(); ++handle)
+		{
+			if (Allocations[handle].VertexCount)
+				order.push_back(handle);
+		}
+
+		std::vector<byte> vertexData(VertexData.size());
+		std::vector<byte> indexData(IndexData.size());
+
+		// Vertices and indices are compacted separately, both keep their relative order.
+		std::sort(order.begin(), order.end(), [this](const GeometryHandle lhs, const GeometryHandle rhs) { return Allocations[lhs].FirstVertex < Allocations[rhs].FirstVertex; });
+
+		uint32 vertexOffset = 0;
+		for (const GeometryHandle handle : order)
+		{
+			GeometryAllocation& allocation = Allocations[handle];
+			std::memcpy(vertexData.data() + size_t(vertexOffset) * VertexStride, VertexData.data() + size_t(allocation.FirstVertex) * VertexStride, size_t(allocation.VertexCount) * VertexStride);
+
+			allocation.FirstVertex = vertexOffset;
+			vertexOffset += allocation.VertexCount;
+		}
+
+		std::sort(order.begin(), order.end(), [this](const GeometryHandle lhs, const GeometryHandle rhs) { return Allocations[lhs].FirstIndex < Allocations[rhs].FirstIndex; });
+
+		uint32 indexOffset = 0;
+		for (const GeometryHandle handle : order)
+		{
+			GeometryAllocation& allocation = Allocations[handle];
+			std::memcpy(indexData.data() + size_t(indexOffset) * IndexStride, IndexData.data() + size_t(allocation.FirstIndex) * IndexStride, size_t(allocation.IndexCount) * IndexStride);
+
+			allocation.FirstIndex = indexOffset;
+			indexOffset += allocation.IndexCount;
+		}
+
+		VertexData.swap(vertexData);
+		IndexData.swap(indexData);
+
+		VertexRanges.Reset(vertexOffset);
+		IndexRanges.Reset(indexOffset);
+
+		Upload();
+		return true;
+	}
+
+	bool GeometryBuffer::Grow(const uint32 vertexCapacity, const uint32 indexCapacity)
+	{
+		if (vertexCapacity == VertexRanges.GetCapacity() && indexCapacity == IndexRanges.GetCapacity())
+			return false;
+
+		VertexRanges.Grow(vertexCapacity);
+		IndexRanges.Grow(indexCapacity);
+
+		VertexData.resize(size_t(vertexCapacity) * VertexStride);
+		IndexData.resize(size_t(indexCapacity) * IndexStride);
+
+		// Command lists still holding the old vertex array keep its buffers alive.
+		CreateBuffers();
+		return true;
+	}
+
+	void GeometryBuffer::CreateBuffers()
+	{
+		const uint32 vertexCapacity = VertexRanges.GetCapacity();
+		const uint32 indexCapacity = IndexRanges.GetCapacity();
+
+		// Dynamic, so uploading the whole buffer after defragmenting orphans it instead of stalling.
+		// The contents are uploaded by the caller.
+		VertexBufferRef vertexBuffer = VertexBuffer::Create(nullptr, vertexCapacity * VertexStride, BufferUsage::Dynamic);
+		vertexBuffer->SetLayout(Layout);
+
+		IndexBufferRef indexBuffer = Type == IndexType::UInt16
+			? IndexBuffer::Create(static_cast<const uint16*>(nullptr), indexCapacity, BufferUsage::Dynamic)
+			: IndexBuffer::Create(static_cast<const uint32*>(nullptr), indexCapacity, BufferUsage::Dynamic);
+
+		VertexArray = VertexArray::Create();
+		VertexArray->AddVertexBuffer(vertexBuffer);
+		VertexArray->SetIndexBuffer(indexBuffer);
+	}
+
+	void GeometryBuffer::Upload()
+	{
+		VertexArray->GetVertexBuffers()[0]->SetData(VertexData.data(), 0, VertexRanges.GetCapacity() * VertexStride);
+		VertexArray->GetIndexBuffer()->SetData(IndexData.data(), 0, IndexRanges.GetCapacity());
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GeometryPool ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GeometryPool* GeometryPool::Instance = nullptr;
+
+	GeometryPool::GeometryPool()
+		: Buffers()
+	{
+		assert(!Instance); // "Only one GeometryPool can exist."
+		Instance = this;
+	}
+
+	GeometryPool::~GeometryPool()
+	{
+		// Meshes keep their buffer alive, the pool only stops handing it out.
+		Instance = nullptr;
+	}
+
+	const GeometryBufferRef& GeometryPool::GetBuffer(const BufferLayout& layout, const IndexType indexType)
+	{
+		for (const Entry& entry : Buffers)
+		{
+			if (entry.Layout == &layout && entry.Type == indexType)
+				return entry.Buffer;
+		}
+
+		Buffers.push_back({ &layout, indexType, new GeometryBuffer(layout, indexType, InitialVertexCapacity, InitialIndexCapacity) });
+		return Buffers.back().Buffer;
+	}
+
+	void GeometryPool::Defragment()
+	{
+		for (const Entry& entry : Buffers)
+		{
+			if (entry.Buffer->GetFragmentation() > MaxFragmentation)
+				entry.Buffer->Defragment();
+		}
+	}
+
+}
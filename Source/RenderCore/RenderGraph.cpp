@@ -0,0 +1,373 @@
+#include "pch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "PBR/RenderCore/RenderGraph.h"
+#include "PBR/Renderer/GpuProfiler.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraphBuilder //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, const uint32 pass)
+		: Graph(graph)
+		, Pass(pass)
+	{
+
+	}
+
+	RenderGraphResource RenderGraphBuilder::CreateTexture(const char* name, const RenderTargetDesc& desc)
+	{
+		const uint32 resource = Graph.AddResource(name, RenderGraph::ResourceType::Texture);
+		Graph.Resources[resource].Desc = desc;
+
+		return Graph.AddAccess(Pass, resource, true);
+	}
+
+	RenderGraphResource RenderGraphBuilder::CreateFrameBuffer(const char* name, const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo)
+	{
+		const uint32 resource = Graph.AddResource(name, RenderGraph::ResourceType::FrameBuffer);
+		Graph.Resources[resource].Desc.Width = width;
+		Graph.Resources[resource].Desc.Height = height;
+		Graph.Resources[resource].FrameBufferInfo = createInfo;
+
+		return Graph.AddAccess(Pass, resource, true);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Read(const char* name)
+	{
+		return Graph.AddAccess(Pass, Graph.FindResource(name), false);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Write(const char* name)
+	{
+		return Graph.AddAccess(Pass, Graph.FindResource(name), true);
+	}
+
+	bool RenderGraphBuilder::HasResource(const char* name) const
+	{
+		return Graph.FindResource(name) != RenderGraph::InvalidIndex;
+	}
+
+	void RenderGraphBuilder::SetSideEffect()
+	{
+		Graph.Passes[Pass].bHasSideEffect = true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraphContext //////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RenderGraphContext::RenderGraphContext(const RenderGraph& graph)
+		: Graph(graph)
+	{
+
+	}
+
+	const Texture2DRef& RenderGraphContext::GetTexture(const RenderGraphResource resource) const
+	{
+		assert(resource < Graph.Resources.size()); // "Invalid render graph resource."
+		assert(Graph.Resources[resource].Type == RenderGraph::ResourceType::Texture); // "Render graph resource is not a texture."
+
+		return Graph.Resources[resource].Texture;
+	}
+
+	const FrameBufferRef& RenderGraphContext::GetFrameBuffer(const RenderGraphResource resource) const
+	{
+		assert(resource < Graph.Resources.size()); // "Invalid render graph resource."
+		assert(Graph.Resources[resource].Type == RenderGraph::ResourceType::FrameBuffer); // "Render graph resource is not a frame buffer."
+
+		return Graph.Resources[resource].FrameBuffer;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderGraph /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RenderGraph::RenderGraph(RenderTargetPool& pool)
+		: Pool(pool)
+		, Passes()
+		, Resources()
+		, Order()
+		, bIsCompiled(false)
+	{
+
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		Reset();
+	}
+
+	void RenderGraph::ImportTexture(const char* name, const Texture2DRef& texture)
+	{
+		const uint32 resource = AddResource(name, ResourceType::Texture);
+		Resources[resource].bIsImported = true;
+		Resources[resource].Texture = texture;
+	}
+
+	void RenderGraph::Compile()
+	{
+		PROFILE_SCOPE("RenderGraph::Compile");
+
+		CullPasses();
+		SortPasses();
+		ComputeLifetimes();
+
+		bIsCompiled = true;
+	}
+
+	void RenderGraph::Execute(GpuProfiler* profiler)
+	{
+		assert(bIsCompiled); // "RenderGraph::Execute called before Compile."
+
+		const RenderGraphContext context(*this);
+
+		for (uint32 i = 0; i < Order.size(); ++i)
+		{
+			const Pass& pass = Passes[Order[i]];
+
+			for (const ResourceAccess& access : pass.Accesses)
+			{
+				Resource& resource = Resources[access.Resource];
+				if (resource.FirstUse == i)
+					AcquireResource(resource);
+			}
+
+			{
+				ProfileScope cpuScope(pass.Name);
+
+				if (profiler)
+				{
+					GpuProfileScope gpuScope(*profiler, pass.Name);
+					pass.Execute(context);
+				}
+				else
+				{
+					pass.Execute(context);
+				}
+			}
+
+			for (const ResourceAccess& access : pass.Accesses)
+			{
+				Resource& resource = Resources[access.Resource];
+				if (resource.LastUse == i)
+					ReleaseResource(resource);
+			}
+		}
+	}
+
+	void RenderGraph::Reset()
+	{
+		for (Resource& resource : Resources)
+			ReleaseResource(resource);
+
+		Passes.clear();
+		Resources.clear();
+		Order.clear();
+
+		bIsCompiled = false;
+	}
+
+	void RenderGraph::GetExecutionOrder(std::vector<const char*>& names) const
+	{
+		for (const uint32 pass : Order)
+			names.push_back(Passes[pass].Name);
+	}
+
+	uint32 RenderGraph::CreatePass(const char* name, const ExecuteFunction& execute)
+	{
+		assert(!bIsCompiled); // "Passes cannot be added to a compiled render graph."
+
+		Passes.push_back({ name, execute, {}, {}, {}, false, false });
+		return static_cast<uint32>(Passes.size() - 1);
+	}
+
+	uint32 RenderGraph::FindResource(const char* name) const
+	{
+		// The latest resource with this name hides older ones.
+		for (uint32 i = static_cast<uint32>(Resources.size()); i > 0; --i)
+		{
+			if (std::strcmp(Resources[i - 1].Name, name) == 0)
+				return i - 1;
+		}
+
+		return InvalidIndex;
+	}
+
+	uint32 RenderGraph::AddResource(const char* name, const ResourceType type)
+	{
+		Resource resource;
+		resource.Name = name;
+		resource.Type = type;
+		resource.bIsImported = false;
+		resource.LastWriter = InvalidIndex;
+		resource.FirstUse = InvalidIndex;
+		resource.LastUse = InvalidIndex;
+
+		Resources.push_back(resource);
+		return static_cast<uint32>(Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraph::AddAccess(const uint32 pass, const uint32 resource, const bool write)
+	{
+		assert(resource != InvalidIndex); // "Render graph resource does not exist."
+
+		Resource& target = Resources[resource];
+		Pass& source = Passes[pass];
+
+		// One access per resource and pass, Execute() acquires and releases resources per access.
+		auto existing = std::find_if(source.Accesses.begin(), source.Accesses.end(), [resource](const ResourceAccess& access) { return access.Resource == resource; });
+		if (existing != source.Accesses.end())
+			existing->bIsWrite |= write;
+		else
+			source.Accesses.push_back({ resource, write });
+
+		if (target.LastWriter != InvalidIndex && target.LastWriter != pass)
+			source.Producers.push_back(target.LastWriter);
+
+		if (!write)
+		{
+			target.Readers.push_back(pass);
+			return resource;
+		}
+
+		// Passes still reading the previous contents have to run before they are overwritten.
+		for (const uint32 reader : target.Readers)
+		{
+			if (reader != pass)
+				source.Predecessors.push_back(reader);
+		}
+
+		target.Readers.clear();
+		target.LastWriter = pass;
+
+		return resource;
+	}
+
+	void RenderGraph::CullPasses()
+	{
+		// Passes only depend on passes added before them, so one walk in reverse order marks
+		// everything that contributes to a pass with side effects.
+		for (Pass& pass : Passes)
+			pass.bIsCulled = !pass.bHasSideEffect;
+
+		for (uint32 i = static_cast<uint32>(Passes.size()); i > 0; --i)
+		{
+			const Pass& pass = Passes[i - 1];
+			if (pass.bIsCulled)
+				continue;
+
+			for (const uint32 producer : pass.Producers)
+				Passes[producer].bIsCulled = false;
+		}
+	}
+
+	void RenderGraph::SortPasses()
+	{
+		// Kahn's algorithm over producer and ordering dependencies, ties are broken by the
+		// order in which passes were added.
+		std::vector<uint32> pending(Passes.size(), 0);
+		std::vector<std::vector<uint32>> successors(Passes.size());
+
+		uint32 executedCount = 0;
+		for (uint32 i = 0; i < Passes.size(); ++i)
+		{
+			const Pass& pass = Passes[i];
+			if (pass.bIsCulled)
+				continue;
+
+			++executedCount;
+
+			for (const std::vector<uint32>* dependencies : { &pass.Producers, &pass.Predecessors })
+			{
+				for (const uint32 dependency : *dependencies)
+				{
+					if (Passes[dependency].bIsCulled)
+						continue;
+
+					successors[dependency].push_back(i);
+					++pending[i];
+				}
+			}
+		}
+
+		Order.clear();
+
+		std::vector<uint32> ready;
+		for (uint32 i = static_cast<uint32>(Passes.size()); i > 0; --i)
+		{
+			if (!Passes[i - 1].bIsCulled && pending[i - 1] == 0)
+				ready.push_back(i - 1);
+		}
+
+		while (!ready.empty())
+		{
+			// Kept sorted in descending order, the earliest added pass is at the back.
+			const uint32 pass = ready.back();
+			ready.pop_back();
+
+			Order.push_back(pass);
+
+			for (const uint32 successor : successors[pass])
+			{
+				if (--pending[successor] == 0)
+					ready.insert(std::upper_bound(ready.begin(), ready.end(), successor, std::greater<uint32>()), successor);
+			}
+		}
+
+		assert(Order.size() == executedCount); // "Render graph contains a cycle."
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		for (uint32 i = 0; i < Order.size(); ++i)
+		{
+			for (const ResourceAccess& access : Passes[Order[i]].Accesses)
+			{
+				Resource& resource = Resources[access.Resource];
+
+				if (resource.FirstUse == InvalidIndex)
+					resource.FirstUse = i;
+
+				resource.LastUse = i;
+			}
+		}
+	}
+
+	void RenderGraph::AcquireResource(Resource& resource)
+	{
+		if (resource.bIsImported)
+			return;
+
+		if (resource.Type == ResourceType::Texture)
+			resource.Texture = Pool.AcquireTarget(resource.Desc);
+		else
+			resource.FrameBuffer = Pool.AcquireFrameBuffer(resource.Desc.Width, resource.Desc.Height, resource.FrameBufferInfo);
+	}
+
+	void RenderGraph::ReleaseResource(Resource& resource)
+	{
+		if (resource.bIsImported)
+			return;
+
+		if (resource.Texture)
+		{
+			Pool.ReleaseTarget(resource.Texture);
+			resource.Texture = nullptr;
+		}
+
+		if (resource.FrameBuffer)
+		{
+			Pool.ReleaseFrameBuffer(resource.FrameBuffer);
+			resource.FrameBuffer = nullptr;
+		}
+	}
+
+}
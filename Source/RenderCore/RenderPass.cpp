@@ -0,0 +1,29 @@
+#include "pch.h"
+
+#include "PBR/RenderCore/RenderPass.h"
+#include "PBR/Renderer/Renderer.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderPass //////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RenderPass::SetUniformBlock(RHICommandList& commandList, const UniformBufferRef& uniformBuffer, const uint32 blockIndex, const void* data, const uint32 size) const
+	{
+		UniformRingBuffer& uniformRing = RendererInstance->GetUniformRingBuffer();
+
+		const UniformAllocation allocation = uniformRing.Upload(data, size);
+		if (allocation.IsValid())
+		{
+			commandList.BindUniformBlockRange(uniformRing.GetBuffer(), blockIndex, allocation.Offset, allocation.Size);
+			return;
+		}
+
+		commandList.SetUniformBufferData(uniformBuffer, data, size);
+		commandList.BindUniformBlock(uniformBuffer, blockIndex);
+	}
+
+}
@@ -14,6 +14,7 @@ namespace EngineCore
 		: Mesh()
 		, Material()
 		, Transformation()
+		, Handle(InvalidPrimitiveHandle)
 	{
 
 	}
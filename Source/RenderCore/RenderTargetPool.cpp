@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include "PBR/RenderCore/RenderTargetPool.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderTargetDesc ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool RenderTargetDesc::operator==(const RenderTargetDesc& other) const
+	{
+		return Width == other.Width
+			&& Height == other.Height
+			&& CreateInfo.DataType == other.CreateInfo.DataType
+			&& CreateInfo.Format == other.CreateInfo.Format
+			&& CreateInfo.InternalFormat == other.CreateInfo.InternalFormat
+			&& CreateInfo.Filter == other.CreateInfo.Filter
+			&& CreateInfo.Wrap == other.CreateInfo.Wrap
+			&& CreateInfo.UseMipMaps == other.CreateInfo.UseMipMaps
+			&& CreateInfo.AnisotropyLevel == other.CreateInfo.AnisotropyLevel
+			&& CreateInfo.IsShadowTexture == other.CreateInfo.IsShadowTexture;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderTargetPool ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RenderTargetPool::RenderTargetPool()
+		: Targets()
+		, FrameBuffers()
+		, FrameNumber(0)
+	{
+
+	}
+
+	RenderTargetPool::~RenderTargetPool()
+	{
+
+	}
+
+	Texture2DRef RenderTargetPool::AcquireTarget(const RenderTargetDesc& desc)
+	{
+		for (TargetEntry& entry : Targets)
+		{
+			if (entry.bIsInUse || entry.Desc != desc)
+				continue;
+
+			entry.bIsInUse = true;
+			entry.LastUsedFrame = FrameNumber;
+
+			return entry.Texture;
+		}
+
+		// Only sampled by passes of the renderer, not part of the texture budget.
+		Targets.push_back({ desc, Texture2D::Create(desc.Width, desc.Height, desc.CreateInfo), true, FrameNumber });
+		Targets.back().Texture->SetResident(true);
+
+		return Targets.back().Texture;
+	}
+
+	void RenderTargetPool::ReleaseTarget(const Texture2DRef& texture)
+	{
+		for (TargetEntry& entry : Targets)
+		{
+			if (entry.Texture != texture)
+				continue;
+
+			assert(entry.bIsInUse); // "Render target released twice."
+			entry.bIsInUse = false;
+
+			return;
+		}
+
+		assert(false); // "Render target does not belong to the pool."
+	}
+
+	FrameBufferRef RenderTargetPool::AcquireFrameBuffer(const uint32 width, const uint32 height, const FrameBufferCreateInfo& createInfo)
+	{
+		for (FrameBufferEntry& entry : FrameBuffers)
+		{
+			if (entry.bIsInUse || entry.Width != width || entry.Height != height || entry.CreateInfo.RenderColorBuffer != createInfo.RenderColorBuffer)
+				continue;
+
+			entry.bIsInUse = true;
+			entry.LastUsedFrame = FrameNumber;
+
+			return entry.FrameBuffer;
+		}
+
+		FrameBuffers.push_back({ width, height, createInfo, FrameBuffer::Create(width, height, createInfo), true, FrameNumber });
+		return FrameBuffers.back().FrameBuffer;
+	}
+
+	void RenderTargetPool::ReleaseFrameBuffer(const FrameBufferRef& frameBuffer)
+	{
+		for (FrameBufferEntry& entry : FrameBuffers)
+		{
+			if (entry.FrameBuffer != frameBuffer)
+				continue;
+
+			assert(entry.bIsInUse); // "Frame buffer released twice."
+			entry.bIsInUse = false;
+
+			return;
+		}
+
+		assert(false); // "Frame buffer does not belong to the pool."
+	}
+
+	void RenderTargetPool::EndFrame()
+	{
+		++FrameNumber;
+
+		auto isUnused = [this](const uint64 lastUsedFrame, const bool inUse)
+		{
+			return !inUse && lastUsedFrame + MaxUnusedFrames < FrameNumber;
+		};
+
+		Targets.erase(std::remove_if(Targets.begin(), Targets.end(), [&isUnused](const TargetEntry& entry) { return isUnused(entry.LastUsedFrame, entry.bIsInUse); }), Targets.end());
+		FrameBuffers.erase(std::remove_if(FrameBuffers.begin(), FrameBuffers.end(), [&isUnused](const FrameBufferEntry& entry) { return isUnused(entry.LastUsedFrame, entry.bIsInUse); }), FrameBuffers.end());
+	}
+
+}
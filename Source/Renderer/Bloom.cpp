@@ -35,7 +35,7 @@ namespace EngineCore
 
 	void BrightPass::Execute(const Texture2DRef& sceneTexture)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("BrightPassData", 0);
@@ -53,7 +53,6 @@ namespace EngineCore
 		RendererInstance->DrawQuad();
 
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -80,7 +79,7 @@ namespace EngineCore
 
 	void BlurPass::Execute(const Texture2DRef& sourceTexture, const bool horizontal)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("BlurInfo", 0);
@@ -130,7 +129,7 @@ namespace EngineCore
 
 	void BlendPass::Execute(const Texture2DRef& sourceTexture1, const Texture2DRef& sourceTexture2)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("Textures", 0);
 
@@ -144,7 +143,6 @@ namespace EngineCore
 		UniformBuffer->SetData(&Uniforms, sizeof(BlendPassUniformStruct));
 		RendererInstance->DrawQuad();
 
-		Shader->Unbind();
 		FrameBuffer->Unbind();
 	}
 
@@ -153,7 +151,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	BloomStage::BloomStage(Renderer* renderer)
-		: BrightPass(new ::EngineCore::BrightPass(renderer))
+		: RenderStage(renderer)
+		, BrightPass(new ::EngineCore::BrightPass(renderer))
 		, BlurPass(new ::EngineCore::BlurPass(renderer))
 		, BlendPass(new ::EngineCore::BlendPass(renderer))
 	{
@@ -186,11 +185,6 @@ namespace EngineCore
 		const uint32 width = static_cast<uint32>(1280.0f * (1.0f / 2.0f));
 		const uint32 height = static_cast<uint32>(720.0f * (1.0f / 2.0f));
 
-		TargetFrameBuffer = FrameBuffer::Create(1280, 720);
-		BloomFrameBuffer = FrameBuffer::Create(width, height);
-		FrameBufferH = FrameBuffer::Create(width, height);
-		FrameBufferV = FrameBuffer::Create(width, height);
-
 		TextureCreateInfo createInfo;
 		createInfo.DataType = TextureDataType::Float;
 		createInfo.Format = TextureFormat::Rgba;
@@ -199,20 +193,57 @@ namespace EngineCore
 		createInfo.Wrap = TextureWrap::Clamp;
 		createInfo.UseMipMaps = false;
 
-		TextureCreateInfo bloomTextureCreateInfo = createInfo;
-		bloomTextureCreateInfo.UseMipMaps = true;
+		TargetDesc.Width = 1280;
+		TargetDesc.Height = 720;
+		TargetDesc.CreateInfo = createInfo;
+
+		BlurDesc.Width = width;
+		BlurDesc.Height = height;
+		BlurDesc.CreateInfo = createInfo;
 
-		TargetTexture = Texture2D::Create(1280, 720, createInfo);
-		BloomTexture = Texture2D::Create(width, height, bloomTextureCreateInfo);
-		BlurTextureH = Texture2D::Create(width, height, createInfo);
-		BlurTextureV = Texture2D::Create(width, height, createInfo);
+		BloomDesc = BlurDesc;
 	}
 
-	void BloomStage::Execute(const Texture2DRef& sceneTexture)
+	void BloomStage::Execute(const Texture2DRef& sceneTexture, const Texture2DRef& target)
 	{
+		RenderTargetPool& pool = RendererInstance->GetRenderTargetPool();
+
+		BloomFrameBuffer = pool.AcquireFrameBuffer(BlurDesc.Width, BlurDesc.Height);
+		BloomTexture = pool.AcquireTarget(BloomDesc);
+		BlurTextureH = pool.AcquireTarget(BlurDesc);
+		BlurTextureV = pool.AcquireTarget(BlurDesc);
+
 		ExecuteBrightnessPass(sceneTexture);
 		ExecuteBlurPass(BloomTexture);
-		ExecuteBlendPass(sceneTexture);
+
+		pool.ReleaseTarget(BloomTexture);
+		pool.ReleaseTarget(BlurTextureH);
+		pool.ReleaseFrameBuffer(BloomFrameBuffer);
+
+		TargetFrameBuffer = pool.AcquireFrameBuffer(TargetDesc.Width, TargetDesc.Height);
+
+		ExecuteBlendPass(sceneTexture, target);
+
+		pool.ReleaseTarget(BlurTextureV);
+		pool.ReleaseFrameBuffer(TargetFrameBuffer);
+
+		BloomTexture = nullptr;
+		BlurTextureH = nullptr;
+		BlurTextureV = nullptr;
+		BloomFrameBuffer = nullptr;
+		TargetFrameBuffer = nullptr;
+	}
+
+	void BloomStage::Resize(const uint32 width, const uint32 height)
+	{
+		TargetDesc.Width = width;
+		TargetDesc.Height = height;
+
+		BlurDesc.Width = std::max(1u, width / 2);
+		BlurDesc.Height = std::max(1u, height / 2);
+
+		BloomDesc.Width = BlurDesc.Width;
+		BloomDesc.Height = BlurDesc.Height;
 	}
 
 	void BloomStage::ExecuteBrightnessPass(const Texture2DRef& sceneTexture)
@@ -228,7 +259,7 @@ namespace EngineCore
 		// 2 horizontal and 2 vertical passes as done by Crytek
 		// Pass 1 H
 		{
-			BlurPass->SetFrameBuffer(FrameBufferH);
+			BlurPass->SetFrameBuffer(BloomFrameBuffer);
 			BlurPass->SetRenderTarget(BlurTextureH);
 
 			BlurPass->Execute(sourceTexture, true);
@@ -236,7 +267,7 @@ namespace EngineCore
 
 		// Pass 1 V
 		{
-			BlurPass->SetFrameBuffer(FrameBufferV);
+			BlurPass->SetFrameBuffer(BloomFrameBuffer);
 			BlurPass->SetRenderTarget(BlurTextureV);
 
 			BlurPass->Execute(BlurTextureH, false);
@@ -244,7 +275,7 @@ namespace EngineCore
 
 		// Pass 2 H
 		{
-			BlurPass->SetFrameBuffer(FrameBufferH);
+			BlurPass->SetFrameBuffer(BloomFrameBuffer);
 			BlurPass->SetRenderTarget(BlurTextureH);
 
 			BlurPass->Execute(BlurTextureV, true);
@@ -252,7 +283,7 @@ namespace EngineCore
 
 		// Pass 2 V
 		{
-			BlurPass->SetFrameBuffer(FrameBufferV);
+			BlurPass->SetFrameBuffer(BloomFrameBuffer);
 			BlurPass->SetRenderTarget(BlurTextureV);
 
 			BlurPass->Execute(BlurTextureH, false);
@@ -260,10 +291,10 @@ namespace EngineCore
 
 	}
 
-	void BloomStage::ExecuteBlendPass(const Texture2DRef& sceneTexture)
+	void BloomStage::ExecuteBlendPass(const Texture2DRef& sceneTexture, const Texture2DRef& target)
 	{
 		BlendPass->SetFrameBuffer(TargetFrameBuffer);
-		BlendPass->SetRenderTarget(TargetTexture);
+		BlendPass->SetRenderTarget(target);
 
 		BlendPass->Execute(sceneTexture, BlurTextureV);
 	}
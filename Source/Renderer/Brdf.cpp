@@ -29,7 +29,7 @@ namespace EngineCore
 
 	void BrdfPass::Execute()
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 
 		FrameBuffer->Bind();
 		FrameBuffer->Attach(RenderTarget);
@@ -38,7 +38,6 @@ namespace EngineCore
 		RendererInstance->DrawQuad();
 
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -46,7 +45,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	BrdfStage::BrdfStage(Renderer* renderer)
-		: BrdfPass(new ::EngineCore::BrdfPass(renderer))
+		: RenderStage(renderer)
+		, BrdfPass(new ::EngineCore::BrdfPass(renderer))
 	{
 
 	}
@@ -73,6 +73,7 @@ namespace EngineCore
 		brdfTextureCreateInfo.UseMipMaps = false;
 
 		BrdfTexture = Texture2D::Create(512, 512, brdfTextureCreateInfo);
+		BrdfTexture->SetResident(true);
 		
 
 		BrdfPass->Init();
@@ -0,0 +1,99 @@
+#include "pch.h"
+
+#include "PBR/Renderer/DynamicResolution.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// DynamicResolution ///////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	DynamicResolution::DynamicResolution()
+		: TargetMilliseconds(16.6f)
+		, MinScale(0.5f)
+		, MaxScale(1.0f)
+		, Scale(1.0f)
+		, AverageMilliseconds(0.0)
+		, SampleCount(0)
+		, FirstFrameAtScale(0)
+		, LastReportFrame(0)
+		, FrameNumber(0)
+		, OutputWidth(1280)
+		, OutputHeight(720)
+		, RenderWidth(1280)
+		, RenderHeight(720)
+	{
+
+	}
+
+	bool DynamicResolution::Update(const GpuFrameReport& report, const uint64 frameNumber)
+	{
+		FrameNumber = frameNumber;
+
+		if (report.FrameNumber < FirstFrameAtScale)
+			return false;
+
+		// Same report as last frame, the GPU has not finished a new frame yet.
+		if (SampleCount && report.FrameNumber == LastReportFrame)
+			return false;
+
+		LastReportFrame = report.FrameNumber;
+
+		// Exponential average, single slow frames must not trigger a resize.
+		AverageMilliseconds = SampleCount ? AverageMilliseconds * 0.8 + report.Milliseconds * 0.2 : report.Milliseconds;
+		++SampleCount;
+
+		if (SampleCount < MinSampleCount)
+			return false;
+
+		const double average = AverageMilliseconds;
+		if (average <= 0.0)
+			return false;
+
+		if (average <= TargetMilliseconds && average >= TargetMilliseconds * UpscaleThreshold)
+			return false;
+
+		// Aim for the middle of the band, the pixel count scales with the square of the scale.
+		const double target = TargetMilliseconds * (1.0 + UpscaleThreshold) * 0.5;
+		float scale = Scale * static_cast<float>(std::sqrt(target / average));
+
+		scale = std::min(std::max(scale, Scale - MaxScaleChange), Scale + MaxScaleChange);
+		scale = std::min(std::max(scale, MinScale), MaxScale);
+		scale = std::round(scale / ScaleStep) * ScaleStep;
+
+		if (std::abs(scale - Scale) < ScaleStep * 0.5f)
+			return false;
+
+		ApplyScale(scale);
+		return true;
+	}
+
+	void DynamicResolution::Reset()
+	{
+		ApplyScale(MaxScale);
+	}
+
+	void DynamicResolution::SetOutputSize(const uint32 width, const uint32 height)
+	{
+		OutputWidth = width;
+		OutputHeight = height;
+
+		ApplyScale(Scale);
+	}
+
+	void DynamicResolution::ApplyScale(const float scale)
+	{
+		Scale = scale;
+
+		RenderWidth = std::max(1u, static_cast<uint32>(static_cast<float>(OutputWidth) * Scale + 0.5f));
+		RenderHeight = std::max(1u, static_cast<uint32>(static_cast<float>(OutputHeight) * Scale + 0.5f));
+
+		// Frames already submitted still use the old resolution.
+		FirstFrameAtScale = FrameNumber;
+		AverageMilliseconds = 0.0;
+		SampleCount = 0;
+	}
+
+}
@@ -39,8 +39,8 @@ namespace EngineCore
 
 	void EnvPreFilterPass::Execute(const TextureCubeRef& environmentMap)
 	{
-		FrameBuffer->Bind();
-		Shader->Bind();
+		RenderTargetPool& pool = RendererInstance->GetRenderTargetPool();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("PreFilterInfo", 0);
@@ -48,9 +48,6 @@ namespace EngineCore
 		Uniforms.ProjectionMatrix = CaptureProjection;
 		Uniforms.EnvironmentMap = environmentMap->GetShaderHandle();
 
-		RHICommandListImmediate& commandListImmediate = RendererInstance->GetCommandList();
-		commandListImmediate.SetCullMode(CullMode::None);
-
 		const uint32 maxMipLevels = 5;
 		for (uint32 mip = 0; mip < maxMipLevels; ++mip)
 		{
@@ -58,7 +55,9 @@ namespace EngineCore
 			uint32 mipWidth = static_cast<uint32>(1024 * std::pow(0.5f, mip));
 			uint32 mipHeight = static_cast<uint32>(1024 * std::pow(0.5f, mip));
 
-			FrameBuffer->Resize(mipWidth, mipHeight);
+			// One pooled frame buffer per mip size instead of resizing the depth buffer every mip.
+			FrameBuffer = pool.AcquireFrameBuffer(mipWidth, mipHeight);
+			FrameBuffer->Bind();
 
 			const float roughness = static_cast<float>(mip) / (static_cast<float>(maxMipLevels) - 1.0f);
 
@@ -75,12 +74,12 @@ namespace EngineCore
 				UniformBuffer->SetData(&Uniforms, sizeof(EnvPreFilterUniformStruct));
 				RendererInstance->DrawCube();
 			}
-		}
 
-		commandListImmediate.SetCullMode(CullMode::Back);
+			FrameBuffer->Unbind();
+			pool.ReleaseFrameBuffer(FrameBuffer);
+		}
 
-		FrameBuffer->Unbind();
-		Shader->Unbind();
+		FrameBuffer = nullptr;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -88,7 +87,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	EnvPreFilterStage::EnvPreFilterStage(Renderer* renderer)
-		: PreFilterPass(new EnvPreFilterPass(renderer))
+		: RenderStage(renderer)
+		, PreFilterPass(new EnvPreFilterPass(renderer))
 	{
 
 	}
@@ -103,8 +103,6 @@ namespace EngineCore
 		ShaderLibrary* shaders = ShaderLibrary::GetInstance();
 		PreFilterShader = shaders->Get("EnvPreFilterPass");
 
-		PreFilterFrameBuffer = FrameBuffer::Create(1024, 1024);
-
 		TextureCreateInfo createInfo;
 		createInfo.DataType = TextureDataType::Float;
 		createInfo.Format = TextureFormat::Rgba;
@@ -114,11 +112,12 @@ namespace EngineCore
 		createInfo.UseMipMaps = true;
 
 		PreFilterCube = TextureCube::Create(1024, 1024, createInfo);
+		PreFilterCube->SetResident(true);
 
 
 		PreFilterPass->Init();
 		PreFilterPass->SetShader(PreFilterShader);
-		PreFilterPass->SetFrameBuffer(PreFilterFrameBuffer);
+		PreFilterPass->SetCullMode(CullMode::None);
 		PreFilterPass->SetCubeRenderTarget(PreFilterCube);
 	}
 
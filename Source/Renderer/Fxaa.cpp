@@ -32,7 +32,7 @@ namespace EngineCore
 
 	void FxaaPass::Execute(const Texture2DRef& source)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("FxaaData", 0);
@@ -47,7 +47,6 @@ namespace EngineCore
 		RendererInstance->DrawQuad();
 
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -55,7 +54,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	FxaaStage::FxaaStage(Renderer* renderer)
-		: FxaaPass(new ::EngineCore::FxaaPass(renderer))
+		: RenderStage(renderer)
+		, FxaaPass(new ::EngineCore::FxaaPass(renderer))
 	{
 
 	}
@@ -70,27 +70,35 @@ namespace EngineCore
 		ShaderLibrary* shaders = ShaderLibrary::GetInstance();
 		FxaaShader = shaders->Get("Fxaa");
 
-		FxaaFrameBuffer = FrameBuffer::Create(1280, 720);
-
-		TextureCreateInfo createInfo;
-		createInfo.DataType = TextureDataType::Float;
-		createInfo.Format = TextureFormat::Rgba;
-		createInfo.InternalFormat = TextureFormat::Rgba16f;
-		createInfo.Filter = TextureFilter::Linear;
-		createInfo.Wrap = TextureWrap::Clamp;
-		createInfo.UseMipMaps = false;
-
-		FxaaTarget = Texture2D::Create(1280, 720, createInfo);
+		TargetDesc.Width = 1280;
+		TargetDesc.Height = 720;
+		TargetDesc.CreateInfo.DataType = TextureDataType::Float;
+		TargetDesc.CreateInfo.Format = TextureFormat::Rgba;
+		TargetDesc.CreateInfo.InternalFormat = TextureFormat::Rgba16f;
+		TargetDesc.CreateInfo.Filter = TextureFilter::Linear;
+		TargetDesc.CreateInfo.Wrap = TextureWrap::Clamp;
+		TargetDesc.CreateInfo.UseMipMaps = false;
 
 		FxaaPass->Init();
 		FxaaPass->SetShader(FxaaShader);
-		FxaaPass->SetFrameBuffer(FxaaFrameBuffer);
-		FxaaPass->SetRenderTarget(FxaaTarget);
 	}
 
-	void FxaaStage::Execute(const Texture2DRef& source)
+	void FxaaStage::Execute(const Texture2DRef& source, const Texture2DRef& target)
 	{
+		RenderTargetPool& pool = RendererInstance->GetRenderTargetPool();
+		const FrameBufferRef frameBuffer = pool.AcquireFrameBuffer(TargetDesc.Width, TargetDesc.Height);
+
+		FxaaPass->SetFrameBuffer(frameBuffer);
+		FxaaPass->SetRenderTarget(target);
 		FxaaPass->Execute(source);
+
+		pool.ReleaseFrameBuffer(frameBuffer);
+	}
+
+	void FxaaStage::Resize(const uint32 width, const uint32 height)
+	{
+		TargetDesc.Width = width;
+		TargetDesc.Height = height;
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "pch.h"
+
+#include "PBR/Renderer/GpuProfiler.h"
+#include "PBR/RHI/CommandList.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuProfiler /////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GpuProfiler::GpuProfiler()
+		: Frames()
+		, FrameNumber(0)
+		, ActiveFrame(nullptr)
+		, ScopeStack()
+		, bIsStatisticsActive(false)
+		, bIsStatisticsSupported(true)
+		, bIsEnabled(true)
+		, bIsPipelineStatisticsEnabled(false)
+		, DroppedFrames(0)
+		, Mutex()
+		, Reports()
+		, LastReport()
+		, bHasLastReport(false)
+	{
+
+	}
+
+	GpuProfiler::~GpuProfiler()
+	{
+
+	}
+
+	void GpuProfiler::BeginFrame()
+	{
+		assert(!ActiveFrame); // "GpuProfiler::BeginFrame called twice."
+
+		ResolveFrames();
+
+		if (!bIsEnabled)
+			return;
+
+		QueryFrame& frame = Frames[FrameNumber % FrameLatency];
+		if (frame.bIsPending)
+		{
+			// Still in flight after FrameLatency frames, waiting for it would stall.
+			frame.bIsPending = false;
+			++DroppedFrames;
+		}
+
+		if (!frame.Begin)
+		{
+			frame.Begin = GpuTimestampQuery::Create();
+			frame.End = GpuTimestampQuery::Create();
+		}
+
+		frame.FrameNumber = FrameNumber;
+		frame.ScopeCount = 0;
+		frame.Begin->Issue();
+
+		ActiveFrame = &frame;
+	}
+
+	void GpuProfiler::EndFrame()
+	{
+		assert(ScopeStack.empty()); // "GpuProfiler scope is still open at the end of the frame."
+
+		if (!ActiveFrame)
+			return;
+
+		ActiveFrame->End->Issue();
+		ActiveFrame->bIsPending = true;
+		ActiveFrame = nullptr;
+
+		++FrameNumber;
+	}
+
+	void GpuProfiler::BeginScope(const char* name)
+	{
+		RHICommandListExecutor::GetImmediateCommandList().BeginRenderPass(name);
+
+		if (!ActiveFrame)
+		{
+			ScopeStack.push_back(InvalidScope);
+			return;
+		}
+
+		QueryFrame& frame = *ActiveFrame;
+		if (frame.ScopeCount == frame.Scopes.size())
+		{
+			frame.Scopes.emplace_back();
+
+			ScopeQueries& queries = frame.Scopes.back();
+			queries.Begin = GpuTimestampQuery::Create();
+			queries.End = GpuTimestampQuery::Create();
+		}
+
+		const uint32 index = frame.ScopeCount++;
+
+		ScopeQueries& scope = frame.Scopes[index];
+		scope.Name = name;
+		scope.Depth = static_cast<uint32>(ScopeStack.size());
+		scope.bHasStatistics = false;
+
+		if (bIsPipelineStatisticsEnabled && bIsStatisticsSupported && !bIsStatisticsActive)
+		{
+			if (!scope.Statistics)
+				scope.Statistics = GpuStatisticsQuery::Create();
+
+			if (scope.Statistics)
+			{
+				scope.Statistics->Begin();
+				scope.bHasStatistics = true;
+				bIsStatisticsActive = true;
+			}
+			else
+			{
+				std::cout << "Warning: Pipeline statistics queries are not supported." << std::endl;
+				bIsStatisticsSupported = false;
+			}
+		}
+
+		scope.Begin->Issue();
+
+		ScopeStack.push_back(index);
+	}
+
+	void GpuProfiler::EndScope()
+	{
+		assert(!ScopeStack.empty()); // "GpuProfiler::EndScope without BeginScope."
+
+		const uint32 index = ScopeStack.back();
+		ScopeStack.pop_back();
+
+		if (index != InvalidScope && ActiveFrame)
+		{
+			ScopeQueries& scope = ActiveFrame->Scopes[index];
+			scope.End->Issue();
+
+			if (scope.bHasStatistics)
+			{
+				scope.Statistics->End();
+				bIsStatisticsActive = false;
+			}
+		}
+
+		RHICommandListExecutor::GetImmediateCommandList().EndRenderPass();
+	}
+
+	bool GpuProfiler::GetLastFrameReport(GpuFrameReport& report) const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (!bHasLastReport)
+			return false;
+
+		report = LastReport;
+		return true;
+	}
+
+	void GpuProfiler::TakeFrameReports(std::vector<GpuFrameReport>& reports)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		for (GpuFrameReport& report : Reports)
+			reports.push_back(std::move(report));
+
+		Reports.clear();
+	}
+
+	void GpuProfiler::ResolveFrames()
+	{
+		// Oldest first, so reports are produced in frame order.
+		for (uint32 i = 0; i < FrameLatency; ++i)
+		{
+			QueryFrame& frame = Frames[(FrameNumber + i) % FrameLatency];
+			if (!frame.bIsPending)
+				continue;
+
+			if (!IsFrameAvailable(frame))
+				break;
+
+			ResolveFrame(frame);
+			frame.bIsPending = false;
+		}
+	}
+
+	bool GpuProfiler::IsFrameAvailable(QueryFrame& frame) const
+	{
+		if (!frame.End->IsResultAvailable())
+			return false;
+
+		for (uint32 i = 0; i < frame.ScopeCount; ++i)
+		{
+			ScopeQueries& scope = frame.Scopes[i];
+			if (!scope.End->IsResultAvailable())
+				return false;
+
+			if (scope.bHasStatistics && !scope.Statistics->IsResultAvailable())
+				return false;
+		}
+
+		return true;
+	}
+
+	void GpuProfiler::ResolveFrame(QueryFrame& frame)
+	{
+		GpuFrameReport report;
+		report.FrameNumber = frame.FrameNumber;
+		report.Milliseconds = static_cast<double>(frame.End->GetResult() - frame.Begin->GetResult()) / 1000000.0;
+		report.Scopes.reserve(frame.ScopeCount);
+
+		for (uint32 i = 0; i < frame.ScopeCount; ++i)
+		{
+			ScopeQueries& scope = frame.Scopes[i];
+
+			GpuScopeTiming timing;
+			timing.Name = scope.Name;
+			timing.Depth = scope.Depth;
+			timing.Milliseconds = static_cast<double>(scope.End->GetResult() - scope.Begin->GetResult()) / 1000000.0;
+			timing.bHasStatistics = scope.bHasStatistics;
+			timing.Statistics = PipelineStatistics();
+
+			if (scope.bHasStatistics)
+				scope.Statistics->GetResult(timing.Statistics);
+
+			report.Scopes.push_back(timing);
+		}
+
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		if (Reports.size() == MaxReportCount)
+			Reports.pop_front();
+
+		Reports.push_back(report);
+
+		LastReport = std::move(report);
+		bHasLastReport = true;
+	}
+
+}
@@ -0,0 +1,341 @@
+#include "pch.h"
+
+#include "PBR/Renderer/GpuScene.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// GpuScene ////////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GpuScene::GpuScene()
+		: FreeHandles()
+		, NextHandle(0)
+		, Objects()
+		, DirtyObjects()
+		, DirtyObjectFlags()
+		, TransientObjects()
+		, Materials()
+		, MaterialData()
+		, DirtyMaterials()
+		, DirtyMaterialFlags()
+		, FreeMaterials()
+		, MaterialIndices()
+		, ObjectBuffer()
+		, MaterialBuffer()
+		, FrameNumber(0)
+		, UploadedBytes(0)
+	{
+
+	}
+
+	GpuScene::~GpuScene()
+	{
+
+	}
+
+	PrimitiveHandle GpuScene::AllocateHandle()
+	{
+		if (!FreeHandles.empty())
+		{
+			const PrimitiveHandle handle = FreeHandles.back();
+			FreeHandles.pop_back();
+
+			return handle;
+		}
+
+		return NextHandle++;
+	}
+
+	void GpuScene::FreeHandle(const PrimitiveHandle handle)
+	{
+		assert(handle < NextHandle);
+		FreeHandles.push_back(handle);
+	}
+
+	void GpuScene::BeginFrame()
+	{
+		++FrameNumber;
+		UploadedBytes = 0;
+
+		TransientObjects.clear();
+
+		// Materials only used by transient objects stay one frame after their last use.
+		for (uint32 i = 0; i < Materials.size(); ++i)
+		{
+			MaterialEntry& entry = Materials[i];
+			if (!entry.Material || entry.ObjectCount || entry.LastUsedFrame + 1 >= FrameNumber)
+				continue;
+
+			MaterialIndices.erase(entry.Material.GetReference());
+			entry.Material = nullptr;
+
+			FreeMaterials.push_back(static_cast<int32>(i));
+		}
+	}
+
+	void GpuScene::ApplyUpdates(const std::vector<GpuSceneUpdate>& updates)
+	{
+		for (const GpuSceneUpdate& update : updates)
+		{
+			if (update.Material)
+				SetObject(update.Handle, update.ModelMatrix, update.Material);
+			else
+				RemoveObject(update.Handle);
+		}
+	}
+
+	uint32 GpuScene::AllocateTransientObjects(const uint32 count)
+	{
+		const uint32 first = static_cast<uint32>(TransientObjects.size());
+		TransientObjects.resize(first + count);
+
+		return static_cast<uint32>(Objects.size()) + first;
+	}
+
+	void GpuScene::SetTransientObject(const uint32 objectIndex, const glm::fmat4& modelMatrix, const int32 materialIndex)
+	{
+		GpuObjectStruct& object = TransientObjects[objectIndex - Objects.size()];
+		object.ModelMatrix = modelMatrix;
+		object.MaterialIndex = materialIndex;
+	}
+
+	int32 GpuScene::UseMaterial(const MaterialRef& material)
+	{
+		auto it = MaterialIndices.find(material.GetReference());
+		if (it != MaterialIndices.end())
+		{
+			Materials[it->second].LastUsedFrame = FrameNumber;
+			return it->second;
+		}
+
+		int32 index = static_cast<int32>(Materials.size());
+		if (!FreeMaterials.empty())
+		{
+			index = FreeMaterials.back();
+			FreeMaterials.pop_back();
+		}
+		else
+		{
+			Materials.emplace_back();
+			MaterialData.emplace_back();
+			DirtyMaterialFlags.push_back(false);
+		}
+
+		MaterialEntry& entry = Materials[index];
+		entry.Material = material;
+		entry.Revision = material->GetRevision();
+		entry.ObjectCount = 0;
+		entry.LastUsedFrame = FrameNumber;
+
+		material->GetShaderParameters(MaterialData[index].Material);
+		MaterialIndices[material.GetReference()] = index;
+
+		if (!DirtyMaterialFlags[index])
+		{
+			DirtyMaterialFlags[index] = true;
+			DirtyMaterials.push_back(index);
+		}
+
+		return index;
+	}
+
+	void GpuScene::Upload()
+	{
+		PROFILE_SCOPE("GpuScene::Upload");
+
+		// Material setters only bump the revision, so changed materials are found here.
+		for (uint32 i = 0; i < Materials.size(); ++i)
+		{
+			MaterialEntry& entry = Materials[i];
+			if (!entry.Material || entry.Material->GetRevision() == entry.Revision)
+				continue;
+
+			entry.Revision = entry.Material->GetRevision();
+			entry.Material->GetShaderParameters(MaterialData[i].Material);
+
+			if (!DirtyMaterialFlags[i])
+			{
+				DirtyMaterialFlags[i] = true;
+				DirtyMaterials.push_back(i);
+			}
+		}
+
+		const uint32 materialCount = static_cast<uint32>(MaterialData.size());
+		if (!MaterialBuffer || MaterialBuffer->GetSize() < materialCount * sizeof(GpuMaterialStruct))
+		{
+			uint32 capacity = MaterialBuffer ? MaterialBuffer->GetSize() / sizeof(GpuMaterialStruct) : MinMaterialCapacity;
+			while (capacity < materialCount)
+				capacity *= 2;
+
+			MaterialBuffer = StorageBuffer::Create(capacity * sizeof(GpuMaterialStruct), BufferUsage::Dynamic);
+
+			for (const uint32 index : DirtyMaterials)
+				DirtyMaterialFlags[index] = false;
+
+			DirtyMaterials.clear();
+
+			if (materialCount)
+			{
+				MaterialBuffer->SetData(MaterialData.data(), materialCount * sizeof(GpuMaterialStruct));
+				UploadedBytes += materialCount * sizeof(GpuMaterialStruct);
+			}
+		}
+		else
+		{
+			UploadDirtyRanges(MaterialBuffer, MaterialData.data(), sizeof(GpuMaterialStruct), DirtyMaterials, DirtyMaterialFlags);
+		}
+
+		const uint32 objectCount = static_cast<uint32>(Objects.size());
+		const uint32 transientCount = static_cast<uint32>(TransientObjects.size());
+
+		if (!ObjectBuffer || ObjectBuffer->GetSize() < (objectCount + transientCount) * sizeof(GpuObjectStruct))
+		{
+			uint32 capacity = ObjectBuffer ? ObjectBuffer->GetSize() / sizeof(GpuObjectStruct) : MinObjectCapacity;
+			while (capacity < objectCount + transientCount)
+				capacity *= 2;
+
+			ObjectBuffer = StorageBuffer::Create(capacity * sizeof(GpuObjectStruct), BufferUsage::Dynamic);
+
+			for (const uint32 index : DirtyObjects)
+				DirtyObjectFlags[index] = false;
+
+			DirtyObjects.clear();
+
+			if (objectCount)
+			{
+				ObjectBuffer->SetData(Objects.data(), objectCount * sizeof(GpuObjectStruct));
+				UploadedBytes += objectCount * sizeof(GpuObjectStruct);
+			}
+		}
+		else
+		{
+			UploadDirtyRanges(ObjectBuffer, Objects.data(), sizeof(GpuObjectStruct), DirtyObjects, DirtyObjectFlags);
+		}
+
+		if (transientCount)
+		{
+			ObjectBuffer->SetData(TransientObjects.data(), transientCount * sizeof(GpuObjectStruct), objectCount * sizeof(GpuObjectStruct));
+			UploadedBytes += transientCount * sizeof(GpuObjectStruct);
+		}
+	}
+
+	bool GpuScene::IsResident(const PrimitiveHandle handle) const
+	{
+		return handle < Objects.size() && Objects[handle].MaterialIndex >= 0;
+	}
+
+	void GpuScene::SetObject(const PrimitiveHandle handle, const glm::fmat4& modelMatrix, const MaterialRef& material)
+	{
+		if (handle >= Objects.size())
+		{
+			// Transient objects are placed behind the persistent ones, so this only happens before
+			// the first transient allocation of a frame.
+			assert(TransientObjects.empty());
+
+			uint32 capacity = Objects.empty() ? MinObjectCapacity : static_cast<uint32>(Objects.size());
+			while (capacity <= handle)
+				capacity *= 2;
+
+			GpuObjectStruct freeObject;
+			freeObject.ModelMatrix = glm::fmat4(1.0f);
+			freeObject.MaterialIndex = -1;
+
+			Objects.resize(capacity, freeObject);
+			DirtyObjectFlags.resize(capacity, false);
+		}
+
+		GpuObjectStruct& object = Objects[handle];
+
+		// Acquire first, the object may keep its material.
+		const int32 materialIndex = AcquireMaterial(material);
+		if (object.MaterialIndex >= 0)
+			ReleaseMaterial(object.MaterialIndex);
+
+		object.ModelMatrix = modelMatrix;
+		object.MaterialIndex = materialIndex;
+
+		if (!DirtyObjectFlags[handle])
+		{
+			DirtyObjectFlags[handle] = true;
+			DirtyObjects.push_back(handle);
+		}
+	}
+
+	void GpuScene::RemoveObject(const PrimitiveHandle handle)
+	{
+		if (!IsResident(handle))
+			return;
+
+		GpuObjectStruct& object = Objects[handle];
+		ReleaseMaterial(object.MaterialIndex);
+		object.MaterialIndex = -1;
+
+		if (!DirtyObjectFlags[handle])
+		{
+			DirtyObjectFlags[handle] = true;
+			DirtyObjects.push_back(handle);
+		}
+	}
+
+	int32 GpuScene::AcquireMaterial(const MaterialRef& material)
+	{
+		const int32 index = UseMaterial(material);
+		++Materials[index].ObjectCount;
+
+		return index;
+	}
+
+	void GpuScene::ReleaseMaterial(const int32 materialIndex)
+	{
+		MaterialEntry& entry = Materials[materialIndex];
+
+		assert(entry.ObjectCount);
+		--entry.ObjectCount;
+
+		// Freed by BeginFrame, draws of the current frame may still use it.
+		entry.LastUsedFrame = FrameNumber;
+	}
+
+	void GpuScene::UploadDirtyRanges(const StorageBufferRef& buffer, const void* data, const uint32 stride, std::vector<uint32>& dirty, std::vector<bool>& dirtyFlags)
+	{
+		if (dirty.empty())
+			return;
+
+		std::sort(dirty.begin(), dirty.end());
+
+		const byte* bytes = static_cast<const byte*>(data);
+
+		// Neighbouring entries are merged into one upload.
+		uint32 first = dirty[0];
+		uint32 last = dirty[0];
+
+		for (uint32 i = 1; i <= dirty.size(); ++i)
+		{
+			if (i < dirty.size() && dirty[i] == last + 1)
+			{
+				last = dirty[i];
+				continue;
+			}
+
+			const uint32 size = (last - first + 1) * stride;
+			buffer->SetData(bytes + first * stride, size, first * stride);
+			UploadedBytes += size;
+
+			if (i < dirty.size())
+			{
+				first = dirty[i];
+				last = dirty[i];
+			}
+		}
+
+		for (const uint32 index : dirty)
+			dirtyFlags[index] = false;
+
+		dirty.clear();
+	}
+
+}
@@ -41,7 +41,7 @@ namespace EngineCore
 	{
 		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
 
-		Shader->Bind();
+		commandList.SetPipelineState(GetPipelineState());
 		FrameBuffer->Bind();
 
 		UniformBuffer->BindBlock(0);
@@ -50,7 +50,6 @@ namespace EngineCore
 		Uniforms.ProjectionMatrix = CaptureProjection;
 		Uniforms.CubeMap = cubeMap->GetShaderHandle();
 
-		commandList.SetCullMode(CullMode::None);
 
 		for (uint32 i = 0; i < 6; ++i)
 		{
@@ -63,10 +62,7 @@ namespace EngineCore
 			RendererInstance->DrawCube();
 		}
 
-		commandList.SetCullMode(CullMode::Back);
-
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -75,7 +71,8 @@ namespace EngineCore
 
 
 	IrradianceStage::IrradianceStage(Renderer* renderer)
-		: IrradiancePass(new ::EngineCore::IrradiancePass(renderer))
+		: RenderStage(renderer)
+		, IrradiancePass(new ::EngineCore::IrradiancePass(renderer))
 	{
 
 	}
@@ -102,10 +99,12 @@ namespace EngineCore
 		createInfo.UseMipMaps = false;
 
 		IrradianceMap = TextureCube::Create(256, 256, createInfo);
+		IrradianceMap->SetResident(true);
 
 
 		IrradiancePass->Init();
 		IrradiancePass->SetShader(IrradianceShader);
+		IrradiancePass->SetCullMode(CullMode::None);
 		IrradiancePass->SetFrameBuffer(IrradianceFrameBuffer);
 		IrradiancePass->SetCubeRenderTarget(IrradianceMap);
 	}
@@ -15,6 +15,8 @@ namespace EngineCore
 
 	QuadPass::QuadPass(Renderer* renderer)
 		: RenderPass(renderer)
+		, OutputWidth(1280)
+		, OutputHeight(720)
 	{
 
 	}
@@ -31,7 +33,8 @@ namespace EngineCore
 
 	void QuadPass::Execute(const Texture2DRef& texture)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
+		RendererInstance->GetCommandList().SetViewport(0, 0, OutputWidth, OutputHeight);
 
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("QuadData", 0);
@@ -43,7 +46,6 @@ namespace EngineCore
 		RendererInstance->DrawQuad();
 
 
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +53,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	QuadStage::QuadStage(Renderer* renderer)
-		: QuadPass(new ::EngineCore::QuadPass(renderer))
+		: RenderStage(renderer)
+		, QuadPass(new ::EngineCore::QuadPass(renderer))
 	{
 
 	}
@@ -75,4 +78,9 @@ namespace EngineCore
 		QuadPass->Execute(texture);
 	}
 
+	void QuadStage::Resize(const uint32 width, const uint32 height)
+	{
+		QuadPass->SetOutputSize(width, height);
+	}
+
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "PBR/RenderCore/RenderQueue.h"
+#include "PBR/Core/Profiler.h"
 
 
 namespace EngineCore
@@ -31,6 +32,8 @@ namespace EngineCore
 
 	void RenderPrimitiveGroup::OrderByDistance(const glm::vec3& origin)
 	{
+		PROFILE_SCOPE("RenderPrimitiveGroup::OrderByDistance");
+
 		struct DistanceFunctor
 		{
 
@@ -85,6 +88,8 @@ namespace EngineCore
 
 	void RenderQueue::OrderByPrimitiveCount()
 	{
+		PROFILE_SCOPE("RenderQueue::OrderByPrimitiveCount");
+
 		struct PrimitiveCountOrderFunctor
 		{
 
@@ -0,0 +1,159 @@
+#include "pch.h"
+
+#include "PBR/Renderer/RenderThread.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RenderThread ////////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	RenderThread::RenderThread(const uint32 maxQueuedTasks)
+		: Thread()
+		, ThreadId()
+		, Mutex()
+		, TaskAvailable()
+		, TaskCompleted()
+		, Tasks()
+		, MaxQueuedTasks(maxQueuedTasks ? maxQueuedTasks : 1)
+		, SubmittedFence(0)
+		, CompletedFence(0)
+		, bIsRunning(false)
+		, bStopRequested(false)
+	{
+
+	}
+
+	RenderThread::~RenderThread()
+	{
+		Stop();
+	}
+
+	void RenderThread::Start(const Task& onStart, const Task& onStop)
+	{
+		assert(!bIsRunning);
+
+		bStopRequested = false;
+		bIsRunning = true;
+
+		Thread = std::thread(&RenderThread::Run, this, onStart, onStop);
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!bIsRunning)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			bStopRequested = true;
+		}
+
+		TaskAvailable.notify_all();
+		Thread.join();
+
+		ThreadId = std::thread::id();
+
+		bIsRunning = false;
+	}
+
+	uint64 RenderThread::Enqueue(Task task)
+	{
+		// Tasks issued from the render thread itself (or without a thread) run inline,
+		// waiting for queue space there would dead lock.
+		if (!bIsRunning || IsRenderThread())
+		{
+			task();
+
+			std::lock_guard<std::mutex> lock(Mutex);
+			CompletedFence = ++SubmittedFence;
+
+			return CompletedFence;
+		}
+
+		std::unique_lock<std::mutex> lock(Mutex);
+		TaskCompleted.wait(lock, [this]() { return Tasks.size() < MaxQueuedTasks; });
+
+		const uint64 fence = ++SubmittedFence;
+		Tasks.emplace(fence, std::move(task));
+
+		lock.unlock();
+		TaskAvailable.notify_one();
+
+		return fence;
+	}
+
+	void RenderThread::Wait(const uint64 fence)
+	{
+		if (IsRenderThread())
+			return;
+
+		std::unique_lock<std::mutex> lock(Mutex);
+		TaskCompleted.wait(lock, [this, fence]() { return CompletedFence >= fence; });
+	}
+
+	void RenderThread::Flush()
+	{
+		uint64 fence = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(Mutex);
+			fence = SubmittedFence;
+		}
+
+		Wait(fence);
+	}
+
+	bool RenderThread::IsRenderThread() const
+	{
+		return std::this_thread::get_id() == ThreadId.load();
+	}
+
+	uint64 RenderThread::GetCompletedFence() const
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+		return CompletedFence;
+	}
+
+	void RenderThread::Run(const Task onStart, const Task onStop)
+	{
+		ThreadId = std::this_thread::get_id();
+		Profiler::SetThreadName("RenderThread");
+
+		if (onStart)
+			onStart();
+
+		while (true)
+		{
+			std::pair<uint64, Task> task;
+
+			{
+				std::unique_lock<std::mutex> lock(Mutex);
+				TaskAvailable.wait(lock, [this]() { return bStopRequested || !Tasks.empty(); });
+
+				// Pending frames are always drained before the thread exits.
+				if (Tasks.empty())
+					break;
+
+				task = std::move(Tasks.front());
+				Tasks.pop();
+			}
+
+			task.second();
+
+			{
+				std::lock_guard<std::mutex> lock(Mutex);
+				CompletedFence = task.first;
+			}
+
+			TaskCompleted.notify_all();
+		}
+
+		if (onStop)
+			onStop();
+	}
+
+}
@@ -12,9 +12,32 @@ namespace EngineCore
 
 	Renderer::Renderer()
 		: CommandList(RHICommandListExecutor::GetImmediateCommandList())
-		, Queue()
+		, WorkerPool(new ThreadPool())
+		, DecodePool(new ThreadPool(DecodeThreadCount, ThreadPriority::Low))
+		, UniformRing(nullptr)
+		, Staging(nullptr)
+		, ReleaseQueue(nullptr)
+		, GpuScene(new ::EngineCore::GpuScene())
+		, GpuProfiler(new ::EngineCore::GpuProfiler())
+		, Geometry(new GeometryPool())
+		, RenderTargets(new RenderTargetPool())
+		, Graph(new RenderGraph(*RenderTargets))
+		, GraphExtensions()
+		, Resolution()
+		, LastGpuReport()
+		, Residency()
+		, Streaming(new TextureStreaming(*DecodePool, Residency))
+		, Loader(new TextureLoader(*DecodePool))
+		, OutputWidth(1280)
+		, OutputHeight(720)
+		, AppliedOutputWidth(1280)
+		, AppliedOutputHeight(720)
+		, RenderWidth(1280)
+		, RenderHeight(720)
+		, Frames()
+		, GameFrame(0)
+		, RenderingThread(nullptr)
 		, Lights()
-		, InstancedPrimitives()
 		, Sun()
 		, ShadowStage(new ::EngineCore::ShadowStage(this))
 		, SceneStage(new ::EngineCore::SceneStage(this))
@@ -35,12 +58,16 @@ namespace EngineCore
 		, bIsBloomEnabled(true)
 		, bIsToneMappingEnabled(true)
 		, bIsFxaaEnabled(true)
+		, bIsIndirectDrawingEnabled(false)
+		, bIsDynamicResolutionEnabled(false)
 	{
 
 	}
 
 	Renderer::~Renderer()
 	{
+		StopRenderThread();
+
 		delete ShadowStage;
 		delete SceneStage;
 		delete SkyboxStage;
@@ -54,13 +81,30 @@ namespace EngineCore
 		delete BrdfStage;
 
 		delete SphereMapStage;
+
+		delete Graph;
+		delete RenderTargets;
+		delete GpuProfiler;
+		delete GpuScene;
+		delete Geometry;
+		delete Loader;
+		delete Streaming;
+		delete Staging;
+		delete ReleaseQueue;
+		delete UniformRing;
+		delete DecodePool;
+		delete WorkerPool;
 	}
 
 	void Renderer::Init()
 	{
+		UniformRing = new UniformRingBuffer();
+		Staging = new TextureStagingBuffer();
+		ReleaseQueue = new DeferredReleaseQueue();
+
 		ShadowStage->Init();
 		SceneStage->Init();
-		SkyboxStage->Init(SceneStage);
+		SkyboxStage->Init();
 		BloomStage->Init();
 		ToneMapper->Init();
 		FxaaStage->Init();
@@ -88,7 +132,7 @@ namespace EngineCore
 	void Renderer::DrawMesh(const MeshRef& mesh)
 	{
 		mesh->Renderer_Bind();
-		CommandList.DrawIndexed(mesh->GetVertexArray());
+		CommandList.DrawIndexedRange(mesh->GetVertexArray(), mesh->GetIndexCount(), mesh->GetFirstIndex(), mesh->GetBaseVertex());
 	}
 
 	void Renderer::DrawInstancedMesh(const InstancedMeshRef& mesh)
@@ -97,14 +141,50 @@ namespace EngineCore
 		CommandList.DrawIndexedInstanced(mesh->GetVertexArray(), mesh->GetInstanceBuffer().GetInstanceCount());
 	}
 
+	void Renderer::DrawMesh(RHICommandList& commandList, const MeshRef& mesh) const
+	{
+		commandList.DrawIndexedRange(mesh->GetVertexArray(), mesh->GetIndexCount(), mesh->GetFirstIndex(), mesh->GetBaseVertex());
+	}
+
+	void Renderer::DrawInstancedMesh(RHICommandList& commandList, const InstancedMeshRef& mesh) const
+	{
+		commandList.DrawIndexedInstanced(mesh->GetVertexArray(), mesh->GetInstanceBuffer().GetInstanceCount());
+	}
+
 	void Renderer::Submit(const RenderPrimitive& primitive)
 	{
-		Queue.Submit(primitive);
+		Frames[GameFrame].Queue.Submit(primitive);
 	}
 
 	void Renderer::Submit(const InstancedPrimitive& primitive)
 	{
-		InstancedPrimitives.push_back(primitive);
+		Frames[GameFrame].InstancedPrimitives.push_back(primitive);
+	}
+
+	void Renderer::RegisterPrimitive(RenderPrimitive& primitive)
+	{
+		if (primitive.IsRegistered())
+			return;
+
+		primitive.Handle = GpuScene->AllocateHandle();
+		UpdatePrimitive(primitive);
+	}
+
+	void Renderer::UpdatePrimitive(const RenderPrimitive& primitive)
+	{
+		assert(primitive.IsRegistered());
+		Frames[GameFrame].SceneUpdates.push_back({ primitive.GetHandle(), primitive.GetTransform().GetMatrix(), primitive.GetMaterial() });
+	}
+
+	void Renderer::UnregisterPrimitive(RenderPrimitive& primitive)
+	{
+		if (!primitive.IsRegistered())
+			return;
+
+		Frames[GameFrame].SceneUpdates.push_back({ primitive.GetHandle(), glm::fmat4(1.0f), nullptr });
+		GpuScene->FreeHandle(primitive.GetHandle());
+
+		primitive.Handle = InvalidPrimitiveHandle;
 	}
 
 	void Renderer::AddLight(const LightRef& light)
@@ -117,95 +197,381 @@ namespace EngineCore
 		Sun = sun;
 	}
 
+	void Renderer::AddRenderGraphExtension(const RenderGraphExtension& extension)
+	{
+		GraphExtensions.push_back(extension);
+	}
+
 	void Renderer::DrawScene()
 	{
-		RenderView renderView = CreateRenderView(Queue);
-		Texture2DRef target = nullptr;
+		PROFILE_SCOPE("Renderer::DrawScene");
+
+		FrameData& frame = Frames[GameFrame];
+		CaptureSceneState(frame);
+
+		if (!RenderingThread)
+		{
+			RenderFrame(frame);
+			frame.Clear();
+
+			return;
+		}
+
+		frame.Fence = RenderingThread->Enqueue([this, &frame]()
+		{
+			RenderFrame(frame);
+			frame.Clear();
+		});
+
+		// Frame N is now owned by the render thread, the game continues with frame N + 1
+		// as soon as the render thread has released it.
+		GameFrame = (GameFrame + 1) % 2;
+
+		PROFILE_SCOPE("Renderer::WaitForRenderThread");
+		RenderingThread->Wait(Frames[GameFrame].Fence);
+	}
+
+	void Renderer::RenderFrame(FrameData& frame)
+	{
+		PROFILE_SCOPE("Renderer::RenderFrame");
+
+		GpuProfiler->BeginFrame();
+		UniformRing->BeginFrame();
+		Staging->BeginFrame();
+		ReleaseQueue->BeginFrame();
+
+		UpdateRenderResolution(frame);
+
+		GpuScene->BeginFrame();
+		GpuScene->ApplyUpdates(frame.SceneUpdates);
+
+		// Nothing recorded references geometry offsets yet.
+		Geometry->Defragment();
+
+		RenderView renderView = CreateRenderView(frame);
+
+		// Streaming changes texture handles, both run before the scene fetches material parameters.
+		Streaming->Update(renderView, RenderHeight, *Staging);
+		Residency.Update(renderView);
+
+		if (frame.Skybox && bIsSkyboxEnabled)
+			Residency.MarkUsed(frame.Skybox.GetReference());
+
+		Loader->Update(*Staging);
+
+		BuildRenderGraph(frame, renderView);
+		Graph->Compile();
+		Graph->Execute(GpuProfiler);
+		Graph->Reset();
+
+		RenderTargets->EndFrame();
+
+		ReleaseQueue->EndFrame();
+		Staging->EndFrame();
+		UniformRing->EndFrame();
+		GpuProfiler->EndFrame();
+	}
+
+	void Renderer::UpdateRenderResolution(const FrameData& frame)
+	{
+		const uint32 outputWidth = frame.OutputWidth;
+		const uint32 outputHeight = frame.OutputHeight;
+
+		if (outputWidth != AppliedOutputWidth || outputHeight != AppliedOutputHeight)
+		{
+			QuadStage->Resize(outputWidth, outputHeight);
+			Resolution.SetOutputSize(outputWidth, outputHeight);
+
+			AppliedOutputWidth = outputWidth;
+			AppliedOutputHeight = outputHeight;
+		}
+
+		uint32 width = outputWidth;
+		uint32 height = outputHeight;
+
+		if (bIsDynamicResolutionEnabled)
+		{
+			if (GpuProfiler->GetLastFrameReport(LastGpuReport))
+				Resolution.Update(LastGpuReport, GpuProfiler->GetFrameNumber());
+
+			width = Resolution.GetRenderWidth();
+			height = Resolution.GetRenderHeight();
+		}
+
+		if (width == RenderWidth && height == RenderHeight)
+			return;
+
+		RenderWidth = width;
+		RenderHeight = height;
+
+		// The shadow map keeps its resolution, it does not depend on the screen.
+		SceneStage->Resize(width, height);
+		BloomStage->Resize(width, height);
+		ToneMapper->Resize(width, height);
+		FxaaStage->Resize(width, height);
+	}
+
+	void Renderer::BuildRenderGraph(const FrameData& frame, const RenderView& renderView)
+	{
+		PROFILE_SCOPE("Renderer::BuildRenderGraph");
+
+		struct ShadowData { RenderGraphResource ShadowMap; };
+		struct SceneData { RenderGraphResource ShadowMap; RenderGraphResource FrameBuffer; RenderGraphResource Target; };
+		struct SkyboxData { RenderGraphResource FrameBuffer; RenderGraphResource Target; };
+		struct PostProcessData { RenderGraphResource Source; RenderGraphResource Target; };
+
+		const RenderTargetDesc& sceneDesc = SceneStage->GetTargetDesc();
 
 		if (bIsShadowsEnabled)
 		{
-			ShadowStage->Execute(renderView);
+			Graph->ImportTexture("ShadowMap", ShadowStage->GetDepthTexture());
+
+			Graph->AddPass<ShadowData>("Shadow",
+				[](RenderGraphBuilder& builder, ShadowData& data)
+				{
+					data.ShadowMap = builder.Write("ShadowMap");
+				},
+				[this, &renderView](const RenderGraphContext&, const ShadowData&)
+				{
+					ShadowStage->Execute(renderView);
+				});
 		}
 
-		SceneStage->Execute(renderView, IrradianceStage->GetIrradianceMap(), PreFilterStage->GetPreFilteredMap(), BrdfStage->GetBrdfTexture(), bIsShadowsEnabled ? ShadowStage->GetDepthTexture() : nullptr);
-		target = SceneStage->GetSceneTexture();
+		Graph->AddPass<SceneData>("Scene",
+			[&sceneDesc](RenderGraphBuilder& builder, SceneData& data)
+			{
+				data.ShadowMap = builder.HasResource("ShadowMap") ? builder.Read("ShadowMap") : RenderGraph::InvalidIndex;
+				data.FrameBuffer = builder.CreateFrameBuffer("SceneFrameBuffer", sceneDesc.Width, sceneDesc.Height);
+				data.Target = builder.CreateTexture("SceneColor", sceneDesc);
+			},
+			[this, &renderView](const RenderGraphContext& context, const SceneData& data)
+			{
+				const Texture2DRef shadowMap = data.ShadowMap != RenderGraph::InvalidIndex ? context.GetTexture(data.ShadowMap) : nullptr;
+				SceneStage->Execute(renderView, IrradianceStage->GetIrradianceMap(), PreFilterStage->GetPreFilteredMap(), BrdfStage->GetBrdfTexture(), shadowMap, context.GetFrameBuffer(data.FrameBuffer), context.GetTexture(data.Target));
+			});
 
-		if (Skybox && bIsSkyboxEnabled)
+		if (frame.Skybox && bIsSkyboxEnabled)
 		{
-			SkyboxStage->Execute(Camera, Skybox);
-			target = SkyboxStage->GetTargetTexture();
+			Graph->AddPass<SkyboxData>("Skybox",
+				[](RenderGraphBuilder& builder, SkyboxData& data)
+				{
+					data.FrameBuffer = builder.Write("SceneFrameBuffer");
+					data.Target = builder.Write("SceneColor");
+				},
+				[this, &frame](const RenderGraphContext& context, const SkyboxData& data)
+				{
+					SkyboxStage->Execute(frame.Camera, frame.Skybox, context.GetFrameBuffer(data.FrameBuffer), context.GetTexture(data.Target));
+				});
 		}
 
 		if (bIsBloomEnabled)
 		{
-			BloomStage->Execute(target);
-			target = BloomStage->GetTargetTexture();
+			Graph->AddPass<PostProcessData>("Bloom",
+				[this](RenderGraphBuilder& builder, PostProcessData& data)
+				{
+					data.Source = builder.Read("SceneColor");
+					data.Target = builder.CreateTexture("SceneColor", BloomStage->GetTargetDesc());
+				},
+				[this](const RenderGraphContext& context, const PostProcessData& data)
+				{
+					BloomStage->Execute(context.GetTexture(data.Source), context.GetTexture(data.Target));
+				});
 		}
 
 		if (bIsToneMappingEnabled)
 		{
-			ToneMapper->Execute(target);
-			target = ToneMapper->GetToneMappedTexture();
+			Graph->AddPass<PostProcessData>("ToneMapping",
+				[this](RenderGraphBuilder& builder, PostProcessData& data)
+				{
+					data.Source = builder.Read("SceneColor");
+					data.Target = builder.CreateTexture("SceneColor", ToneMapper->GetTargetDesc());
+				},
+				[this](const RenderGraphContext& context, const PostProcessData& data)
+				{
+					ToneMapper->Execute(context.GetTexture(data.Source), context.GetTexture(data.Target));
+				});
 		}
 
 		if (bIsFxaaEnabled)
 		{
-			FxaaStage->Execute(target);
-			target = FxaaStage->GetTargetTexture();
+			Graph->AddPass<PostProcessData>("Fxaa",
+				[this](RenderGraphBuilder& builder, PostProcessData& data)
+				{
+					data.Source = builder.Read("SceneColor");
+					data.Target = builder.CreateTexture("SceneColor", FxaaStage->GetTargetDesc());
+				},
+				[this](const RenderGraphContext& context, const PostProcessData& data)
+				{
+					FxaaStage->Execute(context.GetTexture(data.Source), context.GetTexture(data.Target));
+				});
+		}
+
+		for (const RenderGraphExtension& extension : GraphExtensions)
+			extension(*Graph, renderView);
+
+		Graph->AddPass<PostProcessData>("Quad",
+			[](RenderGraphBuilder& builder, PostProcessData& data)
+			{
+				data.Source = builder.Read("SceneColor");
+				builder.SetSideEffect();
+			},
+			[this](const RenderGraphContext& context, const PostProcessData& data)
+			{
+				QuadStage->Execute(context.GetTexture(data.Source));
+			});
+	}
+
+	void Renderer::CaptureSceneState(FrameData& frame) const
+	{
+		frame.Skybox = Skybox;
+		frame.OutputWidth = OutputWidth;
+		frame.OutputHeight = OutputHeight;
+
+		if (!RenderingThread)
+		{
+			frame.Camera = Camera;
+			frame.Sun = Sun;
+			frame.Lights = Lights;
+
+			return;
 		}
 
-		QuadStage->Execute(target);
+		// The game thread keeps modifying its camera and lights while the frame is rendered,
+		// so the render thread works on copies.
+		frame.Camera = Camera ? new EngineCore::Camera(*Camera) : nullptr;
+		frame.Sun = Sun ? new EngineCore::Sun(*Sun) : nullptr;
+
+		frame.Lights.reserve(Lights.size());
+		for (const LightRef& light : Lights)
+			frame.Lights.push_back(new Light(*light));
+	}
+
+	void Renderer::StartRenderThread(const RenderThread::Task& onStart, const RenderThread::Task& onStop)
+	{
+		if (RenderingThread)
+			return;
 
-		Queue.Clear();
-		InstancedPrimitives.clear();
+		RenderingThread = new RenderThread();
+		RenderingThread->Start(onStart, onStop);
+	}
+
+	void Renderer::StopRenderThread()
+	{
+		if (!RenderingThread)
+			return;
+
+		RenderingThread->Stop();
+
+		delete RenderingThread;
+		RenderingThread = nullptr;
+	}
+
+	void Renderer::EnqueueRenderCommand(const RenderThread::Task& task)
+	{
+		if (RenderingThread)
+			RenderingThread->Enqueue(task);
+		else
+			task();
+	}
+
+	void Renderer::FlushRenderThread()
+	{
+		if (RenderingThread)
+			RenderingThread->Flush();
 	}
 
 	void Renderer::DrawTexture(const Texture2DRef& texture)
 	{
-		ToneMapper->Execute(texture);
+		EnqueueRenderCommand([this, texture]()
+		{
+			Residency.MarkUsed(texture.GetReference());
+
+			const Texture2DRef target = RenderTargets->AcquireTarget(ToneMapper->GetTargetDesc());
+			ToneMapper->Execute(texture, target);
+			QuadStage->Execute(target);
+			RenderTargets->ReleaseTarget(target);
+		});
 	}
 
 	void Renderer::PreComputeIndirectLighting(const TextureCubeRef& environmentMap)
 	{
-		IrradianceStage->Execute(environmentMap);
-		PreFilterStage->Execute(environmentMap);
+		EnqueueRenderCommand([this, environmentMap]()
+		{
+			// Reported as a frame of its own.
+			GpuProfiler->BeginFrame();
+
+			{
+				GpuProfileScope scope(*GpuProfiler, "IndirectLighting");
 
-		// TODO: This has to be done only once, not for every environment map
-		BrdfStage->Execute();
+				Residency.MarkUsed(environmentMap.GetReference());
+
+				{
+					GpuProfileScope irradianceScope(*GpuProfiler, "Irradiance");
+					PROFILE_SCOPE("IrradianceStage::Execute");
+					IrradianceStage->Execute(environmentMap);
+				}
+
+				{
+					GpuProfileScope preFilterScope(*GpuProfiler, "EnvPreFilter");
+					PROFILE_SCOPE("EnvPreFilterStage::Execute");
+					PreFilterStage->Execute(environmentMap);
+				}
+
+				// TODO: This has to be done only once, not for every environment map
+				GpuProfileScope brdfScope(*GpuProfiler, "Brdf");
+				PROFILE_SCOPE("BrdfStage::Execute");
+				BrdfStage->Execute();
+			}
+
+			GpuProfiler->EndFrame();
+		});
+
+		FlushRenderThread();
 	}
 
 	const TextureCubeRef& Renderer::DrawSphereMapToCubeMap(const Texture2DRef& sphereMap)
 	{
-		SphereMapStage->Execute(sphereMap);
+		EnqueueRenderCommand([this, sphereMap]()
+		{
+			Residency.MarkUsed(sphereMap.GetReference());
+			SphereMapStage->Execute(sphereMap);
+		});
+
+		FlushRenderThread();
 		return SphereMapStage->GetCubeMap();
 	}
 
 	void Renderer::Clear()
 	{
-		CommandList.SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
-		CommandList.Clear(ClearFlags::ColorBuffer | ClearFlags::DepthBuffer);
+		EnqueueRenderCommand([this]()
+		{
+			CommandList.SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+			CommandList.Clear(ClearFlags::ColorBuffer | ClearFlags::DepthBuffer);
+		});
 	}
 
-	RenderView Renderer::CreateRenderView(const RenderQueue& queue)
+	RenderView Renderer::CreateRenderView(FrameData& frame)
 	{
+		PROFILE_SCOPE("Renderer::CreateRenderView");
+
 		RenderView renderView = RenderView();
-		renderView.SetCamera(Camera);
-		renderView.SetSun(Sun);
+		renderView.SetCamera(frame.Camera);
+		renderView.SetSun(frame.Sun);
 
-		for (const LightRef& light : Lights)
+		for (const LightRef& light : frame.Lights)
 			renderView.AddLight(light);
 
-		Queue.OrderByPrimitiveCount();
+		frame.Queue.OrderByPrimitiveCount();
 
-		for (RenderPrimitiveGroup& group : Queue.GetPrimitiveGroups())
+		for (RenderPrimitiveGroup& group : frame.Queue.GetPrimitiveGroups())
 		{
-			group.OrderByDistance(Camera->GetPosition());
+			group.OrderByDistance(frame.Camera->GetPosition());
 
 			for (const RenderPrimitive& primitive : group)
 				renderView.AddPrimitive(primitive);
 		}
 
-		for (const InstancedPrimitive& primitive : InstancedPrimitives)
+		for (const InstancedPrimitive& primitive : frame.InstancedPrimitives)
 			renderView.AddInstancedPrimitive(primitive);
 
 		return renderView;
@@ -220,7 +586,7 @@ namespace EngineCore
 			-1.0f,  1.0f, 0.0f, 1.0f  // top left
 		};
 
-		const uint32 indices[] = {
+		const uint16 indices[] = {
 			0, 1, 2, // bottom right triangle
 			2, 3, 0  // top left triangle
 		};
@@ -285,7 +651,7 @@ namespace EngineCore
 
 		};
 
-		const uint32 indices[] = {
+		const uint16 indices[] = {
 
 			// front
 			 0,  3,  6,
@@ -15,6 +15,7 @@ namespace EngineCore
 
 	ScenePass::ScenePass(Renderer* renderer)
 		: RenderPass(renderer)
+		, CommandLists()
 		, SceneBuffer()
 		, LightBuffer()
 		, MaterialBuffer()
@@ -25,24 +26,29 @@ namespace EngineCore
 
 	ScenePass::~ScenePass()
 	{
-
+		for (RHICommandList* commandList : CommandLists)
+			delete commandList;
 	}
 
 	void ScenePass::Init()
 	{
+		const uint32 chunkCount = RendererInstance->GetThreadPool().GetMaxChunkCount();
+		for (uint32 i = 0; i < chunkCount; ++i)
+			CommandLists.push_back(new RHICommandList());
+
 		SceneBuffer = UniformBuffer::Create(sizeof(SceneUniformStruct), BufferUsage::Dynamic);
-		LightBuffer = UniformBuffer::Create(sizeof(LightUniformStruct) * 4, BufferUsage::Dynamic);
+		LightBuffer = UniformBuffer::Create(sizeof(LightUniformStruct) * MaxLightCount, BufferUsage::Dynamic);
 		MaterialBuffer = UniformBuffer::Create(sizeof(MaterialUniformStruct), BufferUsage::Dynamic);
 		ImageBuffer = UniformBuffer::Create(sizeof(ImageUniformStruct), BufferUsage::Dynamic);
 		ShadowBuffer = UniformBuffer::Create(sizeof(ShadowUniformStruct), BufferUsage::Dynamic);
+
+		ReserveIndirectBuffers(MinIndirectDrawCapacity, MaxLightCount);
 	}
 
 	void ScenePass::Execute(const RenderView& view, const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture, const Texture2DRef& shadowMap)
 	{
 		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
-		commandList.SetCullMode(CullMode::Back);
-
-		Shader->Bind();
+		commandList.SetPipelineState(GetPipelineState());
 
 		SceneBuffer->BindBlock(0);
 		Shader->BindBlock("SceneData", 0);
@@ -66,51 +72,285 @@ namespace EngineCore
 
 		SetImageUniforms(irradianceMap, preFilteredMap, brdfTexture);
 		SetShadowUniforms(shadowMap, view.GetSun());
+		SetCameraUniforms(view);
+		SetViewLights(view);
+
+		if (RendererInstance->IsIndirectDrawingEnabled())
+		{
+			RecordIndirectPrimitives(*CommandLists[0], view);
+			commandList.Submit(*CommandLists[0]);
+		}
+		else
+		{
+			const uint32 primitiveCount = static_cast<uint32>(view.GetRenderPrimitives().size());
+
+			const uint32 chunkCount = RendererInstance->GetThreadPool().ParallelFor(primitiveCount, MinPrimitivesPerChunk, [this, &view](const uint32 begin, const uint32 end, const uint32 chunk)
+			{
+				PROFILE_SCOPE("ScenePass::RecordPrimitives");
+				RecordPrimitives(*CommandLists[chunk], view, begin, end);
+			});
+
+			for (uint32 chunk = 0; chunk < chunkCount; ++chunk)
+				commandList.Submit(*CommandLists[chunk]);
+		}
+
+		RecordInstancedPrimitives(*CommandLists[0], view);
+		commandList.Submit(*CommandLists[0]);
+
+		FrameBuffer->Unbind();
+	}
+
+	void ScenePass::RecordPrimitives(RHICommandList& commandList, const RenderView& view, const uint32 begin, const uint32 end) const
+	{
+		const std::vector<RenderPrimitive>& primitives = view.GetRenderPrimitives();
+		SceneUniformStruct sceneUniforms = SceneUniforms;
 
-		for (const RenderPrimitive& primitive : view.GetRenderPrimitives())
+		for (uint32 i = begin; i < end; ++i)
 		{
-			const MeshRef mesh = primitive.GetMesh();
-			const MaterialRef material = primitive.GetMaterial();
+			const RenderPrimitive& primitive = primitives[i];
 			const Transform& transform = primitive.GetTransform();
 
-			SetSceneUniforms(view, transform, false);
-			SetLightUniforms(view, transform.GetPosition());
-			SetMaterialUniforms(material);
+			SetSceneUniforms(commandList, sceneUniforms, transform, false);
+			SetLightUniforms(commandList, view, transform.GetPosition());
+			SetMaterialUniforms(commandList, primitive.GetMaterial());
 
-			RendererInstance->DrawMesh(mesh);
+			RendererInstance->DrawMesh(commandList, primitive.GetMesh());
 		}
+	}
 
-		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
+	void ScenePass::RecordIndirectPrimitives(RHICommandList& commandList, const RenderView& view)
+	{
+		BuildIndirectBatches(view);
+
+		if (IndirectBatches.empty())
+			return;
+
+		const uint32 drawCount = static_cast<uint32>(DrawCommands.size());
+		const uint32 lightCount = static_cast<uint32>(ViewLights.size());
+		ReserveIndirectBuffers(drawCount, lightCount);
+
+		// Registered objects and materials are only uploaded when they changed, the per draw data
+		// just references them.
+		GpuScene& scene = RendererInstance->GetGpuScene();
+		scene.Upload();
+
+		DrawDataBuffer->SetData(DrawData.data(), drawCount * sizeof(DrawDataStruct));
+		DrawCommandBuffer->SetData(DrawCommands.data(), drawCount);
+
+		if (lightCount)
+			ViewLightBuffer->SetData(ViewLights.data(), lightCount * sizeof(LightUniformStruct));
+
+		DrawDataBuffer->BindBlock(0);
+		ViewLightBuffer->BindBlock(1);
+		scene.GetObjectBuffer()->BindBlock(2);
+		scene.GetMaterialBuffer()->BindBlock(3);
+
+		SceneUniformStruct sceneUniforms = SceneUniforms;
+		sceneUniforms.UseInstancing = 0.0f;
+		sceneUniforms.UseIndirect = 1.0f;
+		SetUniformBlock(commandList, SceneBuffer, 0, &sceneUniforms, sizeof(SceneUniformStruct));
+
+		for (const IndirectBatch& batch : IndirectBatches)
+			commandList.MultiDrawIndexedIndirect(batch.VertexArray, DrawCommandBuffer, batch.FirstDraw, batch.DrawCount);
+	}
+
+	void ScenePass::BuildIndirectBatches(const RenderView& view)
+	{
+		const std::vector<RenderPrimitive>& primitives = view.GetRenderPrimitives();
+		const uint32 primitiveCount = static_cast<uint32>(primitives.size());
+
+		DrawOrder.resize(primitiveCount);
+		for (uint32 i = 0; i < primitiveCount; ++i)
+			DrawOrder[i] = i;
+
+		// Draws sharing a vertex array end up next to each other, sorted by material inside so
+		// material lookups below hit the same entry. Submission order is kept otherwise.
+		std::sort(DrawOrder.begin(), DrawOrder.end(), [&primitives](const uint32 lhs, const uint32 rhs)
 		{
-			const InstancedMeshRef mesh = primitive.GetMesh();
-			const MaterialRef material = primitive.GetMaterial();
+			const VertexArray* lhsVertexArray = primitives[lhs].GetMesh()->GetVertexArray().GetReference();
+			const VertexArray* rhsVertexArray = primitives[rhs].GetMesh()->GetVertexArray().GetReference();
+
+			if (lhsVertexArray != rhsVertexArray)
+				return lhsVertexArray < rhsVertexArray;
+
+			const Material* lhsMaterial = primitives[lhs].GetMaterial().GetReference();
+			const Material* rhsMaterial = primitives[rhs].GetMaterial().GetReference();
+
+			if (lhsMaterial != rhsMaterial)
+				return lhsMaterial < rhsMaterial;
+
+			return lhs < rhs;
+		});
 
-			SetSceneUniforms(view, Transform(), true);
-			SetLightUniforms(view, glm::vec3()); // TODO: Instanced object position?
-			SetMaterialUniforms(material);
+		DrawData.resize(primitiveCount);
+		DrawMaterials.resize(primitiveCount);
+		DrawCommands.resize(primitiveCount);
 
-			RendererInstance->DrawInstancedMesh(mesh);
+		IndirectBatches.clear();
+
+		// Registered primitives use their persistent object, all others get a transient one.
+		GpuScene& scene = RendererInstance->GetGpuScene();
+
+		uint32 transientCount = 0;
+		for (const RenderPrimitive& primitive : primitives)
+		{
+			if (!scene.IsResident(primitive.GetHandle()))
+				++transientCount;
 		}
 
-		FrameBuffer->Unbind();
-		Shader->Unbind();
+		uint32 transientObject = scene.AllocateTransientObjects(transientCount);
+
+		const Material* lastMaterial = nullptr;
+		int32 lastMaterialIndex = -1;
+
+		for (uint32 draw = 0; draw < primitiveCount; ++draw)
+		{
+			const RenderPrimitive& primitive = primitives[DrawOrder[draw]];
+
+			if (scene.IsResident(primitive.GetHandle()))
+			{
+				DrawData[draw].ObjectIndex = static_cast<int32>(primitive.GetHandle());
+				DrawMaterials[draw] = -1;
+			}
+			else
+			{
+				if (primitive.GetMaterial().GetReference() != lastMaterial)
+				{
+					lastMaterial = primitive.GetMaterial().GetReference();
+					lastMaterialIndex = scene.UseMaterial(primitive.GetMaterial());
+				}
+
+				DrawData[draw].ObjectIndex = static_cast<int32>(transientObject++);
+				DrawMaterials[draw] = lastMaterialIndex;
+			}
+
+			const VertexArrayRef& vertexArray = primitive.GetMesh()->GetVertexArray();
+
+			if (!IndirectBatches.empty() && IndirectBatches.back().VertexArray == vertexArray)
+			{
+				++IndirectBatches.back().DrawCount;
+				continue;
+			}
+
+			IndirectBatches.push_back({ vertexArray, draw, 1 });
+		}
+
+		RendererInstance->GetThreadPool().ParallelFor(primitiveCount, MinPrimitivesPerChunk, [this, &view, &primitives, &scene](const uint32 begin, const uint32 end, const uint32 chunk)
+		{
+			PROFILE_SCOPE("ScenePass::RecordIndirectDraws");
+
+			for (uint32 draw = begin; draw < end; ++draw)
+			{
+				const RenderPrimitive& primitive = primitives[DrawOrder[draw]];
+				const Transform& transform = primitive.GetTransform();
+
+				DrawDataStruct& data = DrawData[draw];
+				if (DrawMaterials[draw] >= 0)
+					scene.SetTransientObject(data.ObjectIndex, transform.GetMatrix(), DrawMaterials[draw]);
+
+				GetLightIndices(view, transform.GetPosition(), data.LightIndices);
+
+				DrawIndexedIndirectCommand& command = DrawCommands[draw];
+				const MeshRef& mesh = primitive.GetMesh();
+
+				command.Count = mesh->GetIndexCount();
+				command.InstanceCount = 1;
+				command.FirstIndex = mesh->GetFirstIndex();
+				command.BaseVertex = mesh->GetBaseVertex();
+				command.BaseInstance = draw;
+			}
+		});
+	}
+
+	void ScenePass::ReserveIndirectBuffers(const uint32 drawCount, const uint32 lightCount)
+	{
+		if (!DrawCommandBuffer || DrawCommandBuffer->GetCapacity() < drawCount)
+		{
+			uint32 capacity = DrawCommandBuffer ? DrawCommandBuffer->GetCapacity() : MinIndirectDrawCapacity;
+			while (capacity < drawCount)
+				capacity *= 2;
+
+			DrawDataBuffer = StorageBuffer::Create(capacity * sizeof(DrawDataStruct), BufferUsage::Stream);
+			DrawCommandBuffer = IndirectBuffer::Create(capacity, BufferUsage::Stream);
+		}
+
+		if (!ViewLightBuffer || ViewLightBuffer->GetSize() < lightCount * sizeof(LightUniformStruct))
+		{
+			uint32 capacity = ViewLightBuffer ? ViewLightBuffer->GetSize() / sizeof(LightUniformStruct) : MaxLightCount;
+			while (capacity < lightCount)
+				capacity *= 2;
+
+			ViewLightBuffer = StorageBuffer::Create(capacity * sizeof(LightUniformStruct), BufferUsage::Stream);
+		}
 	}
 
-	void ScenePass::SetSceneUniforms(const RenderView& view, const Transform& model, const bool instanced)
+	void ScenePass::RecordInstancedPrimitives(RHICommandList& commandList, const RenderView& view) const
+	{
+		SceneUniformStruct sceneUniforms = SceneUniforms;
+
+		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
+		{
+			SetSceneUniforms(commandList, sceneUniforms, Transform(), true);
+			SetLightUniforms(commandList, view, glm::vec3()); // TODO: Instanced object position?
+			SetMaterialUniforms(commandList, primitive.GetMaterial());
+
+			RendererInstance->DrawInstancedMesh(commandList, primitive.GetMesh());
+		}
+	}
+
+	void ScenePass::SetCameraUniforms(const RenderView& view)
 	{
 		SceneUniforms.CameraPosition = view.GetCamera()->GetPosition();
 		SceneUniforms.ViewMatrix = view.GetCamera()->GetViewMatrix();
 		SceneUniforms.ProjectionMatrix = view.GetCamera()->GetProjectionMatrix();
+	}
 
+	void ScenePass::SetSceneUniforms(RHICommandList& commandList, SceneUniformStruct& uniforms, const Transform& model, const bool instanced) const
+	{
 		if(!instanced)
-			SceneUniforms.ModelMatrix = model.GetMatrix();
+			uniforms.ModelMatrix = model.GetMatrix();
+
+		uniforms.UseInstancing = instanced ? 1.0f : 0.0f;
+
+		SetUniformBlock(commandList, SceneBuffer, 0, &uniforms, sizeof(SceneUniformStruct));
+	}
+
+	void ScenePass::SetLightUniforms(RHICommandList& commandList, const RenderView& view, const glm::vec3& point) const
+	{
+		int32 lightIndices[MaxLightCount];
+		GetLightIndices(view, point, lightIndices);
 
-		SceneUniforms.UseInstancing = instanced ? 1.0f : 0.0f;
+		// Unused slots stay LightType::None, so the whole block is written with a single upload.
+		LightUniformStruct lightUniforms[MaxLightCount] = { };
 
-		SceneBuffer->SetData(&SceneUniforms, sizeof(SceneUniformStruct));
+		for (uint32 i = 0; i < MaxLightCount; ++i)
+		{
+			if (lightIndices[i] >= 0)
+				lightUniforms[i] = ViewLights[lightIndices[i]];
+		}
+
+		SetUniformBlock(commandList, LightBuffer, 1, lightUniforms, sizeof(lightUniforms));
+	}
+
+	void ScenePass::SetViewLights(const RenderView& view)
+	{
+		ViewLights.clear();
+
+		SunRef sun = view.GetSun();
+		if (sun)
+		{
+			ViewLights.emplace_back();
+			sun->GetShaderParameters(ViewLights.back());
+		}
+
+		for (const LightRef& light : view.GetLights())
+		{
+			ViewLights.emplace_back();
+			light->GetShaderParameters(ViewLights.back());
+		}
 	}
 
-	void ScenePass::SetLightUniforms(const RenderView& view, const glm::vec3& point)
+	uint32 ScenePass::GetLightIndices(const RenderView& view, const glm::vec3& point, int32 (&indices)[MaxLightCount]) const
 	{
 		struct LightPositionSortFunctor
 		{
@@ -139,51 +379,45 @@ namespace EngineCore
 
 		};
 
-		std::vector<LightRef> affectingLights;
+		const std::vector<LightRef>& lights = view.GetLights();
+		std::vector<uint32> affectingLights;
 
-		for (const LightRef& light : view.GetLights())
+		for (uint32 i = 0; i < lights.size(); ++i)
 		{
-			bool affects = light->Affects(point);
+			bool affects = lights[i]->Affects(point);
 			if (affects)
-				affectingLights.push_back(light);
+				affectingLights.push_back(i);
 		}
 
-		std::sort(affectingLights.begin(), affectingLights.end(), LightPositionSortFunctor(point));
-
+		const LightPositionSortFunctor sortFunctor(point);
+		std::sort(affectingLights.begin(), affectingLights.end(), [&lights, &sortFunctor](const uint32 lhs, const uint32 rhs)
+		{
+			return sortFunctor(lights[lhs], lights[rhs]);
+		});
 
-		uint32 offset = 0;
-		LightUniformStruct lightUniforms;
 
-		uint32 maxLights = 4;
+		// Indices point into ViewLights, which holds the sun (if any) in front of the view lights.
+		const uint32 lightOffset = view.GetSun() ? 1 : 0;
+		uint32 lightCount = 0;
 
-		SunRef sun = view.GetSun();
-		if (sun)
-		{
-			sun->GetShaderParameters(lightUniforms);
-			LightBuffer->SetData(&lightUniforms, sizeof(LightUniformStruct), offset);
+		if (view.GetSun())
+			indices[lightCount++] = 0;
 
-			offset += sizeof(LightUniformStruct);
-			maxLights = 3;
-		}
+		for (uint32 i = 0; i < affectingLights.size() && lightCount < MaxLightCount; ++i)
+			indices[lightCount++] = static_cast<int32>(lightOffset + affectingLights[i]);
 
-		for (uint32 i = 0; i < affectingLights.size(); ++i)
-		{
-			if (i > maxLights)
-				break;
+		for (uint32 i = lightCount; i < MaxLightCount; ++i)
+			indices[i] = -1;
 
-			affectingLights[i]->GetShaderParameters(lightUniforms);
-			LightBuffer->SetData(&lightUniforms, sizeof(LightUniformStruct), offset);
-
-			offset += sizeof(LightUniformStruct);
-		}
+		return lightCount;
 	}
 
-	void ScenePass::SetMaterialUniforms(const MaterialRef& material)
+	void ScenePass::SetMaterialUniforms(RHICommandList& commandList, const MaterialRef& material) const
 	{
 		MaterialUniformStruct materialUniforms;
 		material->GetShaderParameters(materialUniforms);
 
-		MaterialBuffer->SetData(&materialUniforms, sizeof(MaterialUniformStruct));
+		SetUniformBlock(commandList, MaterialBuffer, 2, &materialUniforms, sizeof(MaterialUniformStruct));
 	}
 
 	void ScenePass::SetImageUniforms(const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture)
@@ -214,7 +448,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	SceneStage::SceneStage(Renderer* renderer)
-		: ScenePass(new ::EngineCore::ScenePass(renderer))
+		: RenderStage(renderer)
+		, ScenePass(new ::EngineCore::ScenePass(renderer))
 	{
 
 	}
@@ -229,27 +464,30 @@ namespace EngineCore
 		ShaderLibrary* shaders = ShaderLibrary::GetInstance();
 		CommonShader = shaders->Get("CommonPass");
 
-		CommonFrameBuffer = FrameBuffer::Create(1280, 720);
-
-		TextureCreateInfo createInfo;
-		createInfo.DataType = TextureDataType::Float;
-		createInfo.Format = TextureFormat::Rgba;
-		createInfo.InternalFormat = TextureFormat::Rgba16f;
-		createInfo.Filter = TextureFilter::Linear;
-		createInfo.Wrap = TextureWrap::Clamp;
-		createInfo.UseMipMaps = false;
-
-		TargetTexture = Texture2D::Create(1280, 720, createInfo);
+		TargetDesc.Width = 1280;
+		TargetDesc.Height = 720;
+		TargetDesc.CreateInfo.DataType = TextureDataType::Float;
+		TargetDesc.CreateInfo.Format = TextureFormat::Rgba;
+		TargetDesc.CreateInfo.InternalFormat = TextureFormat::Rgba16f;
+		TargetDesc.CreateInfo.Filter = TextureFilter::Linear;
+		TargetDesc.CreateInfo.Wrap = TextureWrap::Clamp;
+		TargetDesc.CreateInfo.UseMipMaps = false;
 
 		ScenePass->Init();
 		ScenePass->SetShader(CommonShader);
-		ScenePass->SetFrameBuffer(CommonFrameBuffer);
-		ScenePass->SetRenderTarget(TargetTexture);
 	}
 
-	void SceneStage::SceneStage::Execute(const RenderView& view, const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture, const Texture2DRef& shadowMap)
+	void SceneStage::SceneStage::Execute(const RenderView& view, const TextureCubeRef& irradianceMap, const TextureCubeRef& preFilteredMap, const Texture2DRef& brdfTexture, const Texture2DRef& shadowMap, const FrameBufferRef& frameBuffer, const Texture2DRef& target)
 	{
+		ScenePass->SetFrameBuffer(frameBuffer);
+		ScenePass->SetRenderTarget(target);
 		ScenePass->Execute(view, irradianceMap, preFilteredMap, brdfTexture, shadowMap);
 	}
 
+	void SceneStage::Resize(const uint32 width, const uint32 height)
+	{
+		TargetDesc.Width = width;
+		TargetDesc.Height = height;
+	}
+
 }
\ No newline at end of file
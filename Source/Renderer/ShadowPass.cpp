@@ -14,24 +14,32 @@ namespace EngineCore
 
 	ShadowPass::ShadowPass(Renderer* renderer)
 		: RenderPass(renderer)
+		, CommandLists()
 	{
 
 	}
 
 	ShadowPass::~ShadowPass()
 	{
-
+		for (RHICommandList* commandList : CommandLists)
+			delete commandList;
 	}
 
 
 	void ShadowPass::Init()
 	{
+		const uint32 chunkCount = RendererInstance->GetThreadPool().GetMaxChunkCount();
+		for (uint32 i = 0; i < chunkCount; ++i)
+			CommandLists.push_back(new RHICommandList());
+
 		UniformBuffer = UniformBuffer::Create(sizeof(ShadowPassUniformStruct), BufferUsage::Dynamic);
 	}
 
 	void ShadowPass::Execute(const RenderView& view)
 	{
-		Shader->Bind();
+		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
+		commandList.SetPipelineState(GetPipelineState());
+
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("ShadowData", 0);
 
@@ -39,40 +47,53 @@ namespace EngineCore
 		FrameBuffer->Attach(DepthTarget, TextureAttachment::Depth);
 		FrameBuffer->Clear();
 
-		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
-		commandList.SetCullMode(CullMode::Front);
+		Uniforms.LightViewMatrix = view.GetSun()->GetView();
+		Uniforms.LightProjectionMatrix = view.GetSun()->GetProjection();
+
+		const uint32 primitiveCount = static_cast<uint32>(view.GetRenderPrimitives().size());
 
-		Uniforms.UseInstancing = 0.0f;
-		for (const RenderPrimitive& primitive : view.GetRenderPrimitives())
+		const uint32 chunkCount = RendererInstance->GetThreadPool().ParallelFor(primitiveCount, MinPrimitivesPerChunk, [this, &view](const uint32 begin, const uint32 end, const uint32 chunk)
 		{
-			const MeshRef mesh = primitive.GetMesh();
-			const Transform& transform = primitive.GetTransform();
+			PROFILE_SCOPE("ShadowPass::RecordPrimitives");
+			RecordPrimitives(*CommandLists[chunk], view, begin, end);
+		});
 
-			Uniforms.ModelMatrix = transform.GetMatrix();
-			Uniforms.LightViewMatrix = view.GetSun()->GetView();
-			Uniforms.LightProjectionMatrix = view.GetSun()->GetProjection();
+		for (uint32 chunk = 0; chunk < chunkCount; ++chunk)
+			commandList.Submit(*CommandLists[chunk]);
 
-			UniformBuffer->SetData(&Uniforms, sizeof(ShadowPassUniformStruct));
-			RendererInstance->DrawMesh(mesh);
-		}
+		RecordInstancedPrimitives(*CommandLists[0], view);
+		commandList.Submit(*CommandLists[0]);
 
-		Uniforms.UseInstancing = 1.0f;
-		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
-		{
-			const InstancedMeshRef mesh = primitive.GetMesh();
-			const MaterialRef material = primitive.GetMaterial();
+		FrameBuffer->Unbind();
+	}
 
-			Uniforms.LightViewMatrix = view.GetSun()->GetView();
-			Uniforms.LightProjectionMatrix = view.GetSun()->GetProjection();
+	void ShadowPass::RecordPrimitives(RHICommandList& commandList, const RenderView& view, const uint32 begin, const uint32 end) const
+	{
+		const std::vector<RenderPrimitive>& primitives = view.GetRenderPrimitives();
+
+		ShadowPassUniformStruct uniforms = Uniforms;
+		uniforms.UseInstancing = 0.0f;
 
-			UniformBuffer->SetData(&Uniforms, sizeof(ShadowPassUniformStruct));
-			RendererInstance->DrawInstancedMesh(mesh);
+		for (uint32 i = begin; i < end; ++i)
+		{
+			const RenderPrimitive& primitive = primitives[i];
+			uniforms.ModelMatrix = primitive.GetTransform().GetMatrix();
+
+			SetUniformBlock(commandList, UniformBuffer, 0, &uniforms, sizeof(ShadowPassUniformStruct));
+			RendererInstance->DrawMesh(commandList, primitive.GetMesh());
 		}
+	}
 
-		commandList.SetCullMode(CullMode::Back);
+	void ShadowPass::RecordInstancedPrimitives(RHICommandList& commandList, const RenderView& view) const
+	{
+		ShadowPassUniformStruct uniforms = Uniforms;
+		uniforms.UseInstancing = 1.0f;
 
-		FrameBuffer->Unbind();
-		Shader->Unbind();
+		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
+		{
+			SetUniformBlock(commandList, UniformBuffer, 0, &uniforms, sizeof(ShadowPassUniformStruct));
+			RendererInstance->DrawInstancedMesh(commandList, primitive.GetMesh());
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -80,7 +101,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	ShadowStage::ShadowStage(Renderer* renderer)
-		: ShadowPass(new ::EngineCore::ShadowPass(renderer))
+		: RenderStage(renderer)
+		, ShadowPass(new ::EngineCore::ShadowPass(renderer))
 	{
 
 	}
@@ -106,10 +128,12 @@ namespace EngineCore
 		createInfo.IsShadowTexture = true;
 
 		DepthTexture = Texture2D::Create(2048, 2048, createInfo);
+		DepthTexture->SetResident(true);
 		
 
 		ShadowPass->Init();
 		ShadowPass->SetShader(ShadowShader);
+		ShadowPass->SetCullMode(CullMode::Front);
 		ShadowPass->SetFrameBuffer(ShadowFrameBuffer);
 		ShadowPass->SetDepthTarget(DepthTexture);
 	}
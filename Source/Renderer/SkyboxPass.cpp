@@ -33,7 +33,7 @@ namespace EngineCore
 	{
 		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
 
-		Shader->Bind();
+		commandList.SetPipelineState(GetPipelineState());
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("SkyboxInfo", 0);
 
@@ -53,21 +53,10 @@ namespace EngineCore
 		Uniforms.ProjectionMatrix = camera->GetProjectionMatrix();
 		Uniforms.Skybox = skybox->GetShaderHandle();
 
-
-		commandList.DepthMask(false);
-		commandList.SetCullMode(CullMode::None);
-		commandList.SetDepthFunc(DepthFunc::LessEqual);
-
 		UniformBuffer->SetData(&Uniforms, sizeof(SkyboxPassUniformStruct));
 		RendererInstance->DrawCube();
 
-		commandList.SetDepthFunc(DepthFunc::Less);
-		commandList.SetCullMode(CullMode::Back);
-		commandList.DepthMask(true);
-
-
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -75,7 +64,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	SkyboxStage::SkyboxStage(Renderer* renderer)
-		: SkyboxPass(new ::EngineCore::SkyboxPass(renderer))
+		: RenderStage(renderer)
+		, SkyboxPass(new ::EngineCore::SkyboxPass(renderer))
 	{
 
 	}
@@ -85,23 +75,23 @@ namespace EngineCore
 		delete SkyboxPass;
 	}
 
-	void SkyboxStage::Init(const SceneStage* sceneStage)
+	void SkyboxStage::Init()
 	{
 		ShaderLibrary* shaders = ShaderLibrary::GetInstance();
 		SkyboxShader = shaders->Get("SkyboxPass");
 
-		// Use framebuffer and target texture from scene stage
-		SkyboxFrameBuffer = sceneStage->CommonFrameBuffer;
-		TargetTexture = sceneStage->TargetTexture;
-
 		SkyboxPass->Init();
 		SkyboxPass->SetShader(SkyboxShader);
-		SkyboxPass->SetFrameBuffer(SkyboxFrameBuffer);
-		SkyboxPass->SetRenderTarget(TargetTexture);
+		SkyboxPass->SetCullMode(CullMode::None);
+		SkyboxPass->SetDepthFunc(DepthFunc::LessEqual);
+		SkyboxPass->SetDepthWrite(false);
 	}
 
-	void SkyboxStage::Execute(const CameraRef& camera, const TextureCubeRef& skybox)
+	void SkyboxStage::Execute(const CameraRef& camera, const TextureCubeRef& skybox, const FrameBufferRef& frameBuffer, const Texture2DRef& target)
 	{
+		SkyboxPass->SetFrameBuffer(frameBuffer);
+		SkyboxPass->SetRenderTarget(target);
+
 		SkyboxPass->Execute(camera, skybox);
 	}
 
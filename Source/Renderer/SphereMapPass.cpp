@@ -41,7 +41,7 @@ namespace EngineCore
 
 	void SphereMapPass::Execute(const Texture2DRef& sphereMap)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("SphereMapData", 0);
 
@@ -50,9 +50,6 @@ namespace EngineCore
 		Uniforms.ProjectionMatrix = CaptureProjection;
 		Uniforms.SphereMap = sphereMap->GetShaderHandle();
 
-		RHICommandListImmediate& commandList = RendererInstance->GetCommandList();
-		commandList.SetCullMode(CullMode::None);
-
 		for (uint32 i = 0; i < 6; ++i)
 		{
 			Uniforms.ViewMatrix = CaptureViewMatrices[i];
@@ -64,11 +61,7 @@ namespace EngineCore
 			RendererInstance->DrawCube();
 		}
 
-		commandList.SetCullMode(CullMode::Back);
-
-
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,7 +69,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	SphereMapStage::SphereMapStage(Renderer* renderer)
-		: SpherePass(new SphereMapPass(renderer))
+		: RenderStage(renderer)
+		, SpherePass(new SphereMapPass(renderer))
 	{
 
 	}
@@ -105,10 +99,12 @@ namespace EngineCore
 		createInfo.UseMipMaps = false;
 		
 		CubeMap = TextureCube::Create(width, height, createInfo);
+		CubeMap->SetResident(true);
 
 
 		SpherePass->Init();
 		SpherePass->SetShader(SphereShader);
+		SpherePass->SetCullMode(CullMode::None);
 		SpherePass->SetFrameBuffer(SphereFrameBuffer);
 		SpherePass->SetCubeRenderTarget(CubeMap);
 	}
@@ -0,0 +1,204 @@
+#include "pch.h"
+
+#include <thread>
+
+#include <stb_image.h>
+
+#include "PBR/Renderer/TextureLoader.h"
+#include "PBR/RHI/TextureEncoder.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureLoader ///////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	TextureLoader* TextureLoader::Instance = nullptr;
+
+	TextureLoader::TextureLoader(ThreadPool& pool)
+		: Pool(pool)
+		, NextId(0)
+		, Pending()
+		, Deferred()
+		, ResultMutex()
+		, Results()
+		, RunningDecodes(0)
+	{
+		assert(!Instance); // "TextureLoader already exists!"
+		Instance = this;
+	}
+
+	TextureLoader::~TextureLoader()
+	{
+		// Decodes still running write into their results.
+		while (RunningDecodes > 0)
+		{
+			{
+				std::lock_guard<std::mutex> lock(ResultMutex);
+
+				for (DecodeResult* result : Results)
+					delete result;
+
+				RunningDecodes -= static_cast<uint32>(Results.size());
+				Results.clear();
+			}
+
+			std::this_thread::yield();
+		}
+
+		for (DecodeResult* result : Deferred)
+			delete result;
+
+		Instance = nullptr;
+	}
+
+	Texture2DRef TextureLoader::Load(const std::string& file, const TextureCreateInfo& createInfo, const glm::vec4& placeholder, const bool hdr)
+	{
+		assert(createInfo.FirstResidentMip == 0); // "Loaded textures have all levels resident."
+
+		// Bc6h is encoded from HDR images, all other formats from 8 bit ones.
+		const bool compressed = IsCompressedTextureFormat(createInfo.InternalFormat);
+		if (compressed && (!TextureEncoder::CanEncode(createInfo.InternalFormat) || (TextureEncoder::GetSourceDataType(createInfo.InternalFormat) == TextureDataType::Float) != hdr))
+		{
+			std::cout << "Warning: Texture " << file << " uses a format without encoder for " << (hdr ? "HDR" : "8 bit") << " images." << std::endl;
+			return nullptr;
+		}
+
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		if (!stbi_info(file.c_str(), &width, &height, &channels))
+		{
+			std::cout << "Warning: Failed to load texture " << file << "." << std::endl;
+			return nullptr;
+		}
+
+		Texture2DRef texture = Texture2D::Create(width, height, createInfo);
+		texture->Fill(placeholder);
+
+		const uint32 id = NextId++;
+		Pending[id] = PendingTexture{ texture, createInfo.UseMipMaps && !compressed };
+
+		DecodeResult* result = new DecodeResult();
+		result->Id = id;
+		result->Width = width;
+		result->Height = height;
+		result->InternalFormat = createInfo.InternalFormat;
+		result->LevelCount = compressed ? texture->GetMipCount() : 1;
+		result->bSucceeded = false;
+
+		{
+			std::lock_guard<std::mutex> lock(ResultMutex);
+			++RunningDecodes;
+		}
+
+		Pool.Enqueue([this, file, hdr, result]()
+		{
+			Decode(file, hdr, Pool, *result);
+
+			std::lock_guard<std::mutex> lock(ResultMutex);
+			Results.push_back(result);
+		});
+
+		return texture;
+	}
+
+	void TextureLoader::Update(TextureStagingBuffer& staging)
+	{
+		PROFILE_SCOPE("TextureLoader::Update");
+
+		{
+			std::lock_guard<std::mutex> lock(ResultMutex);
+
+			RunningDecodes -= static_cast<uint32>(Results.size());
+			Deferred.insert(Deferred.end(), Results.begin(), Results.end());
+			Results.clear();
+		}
+
+		uint32 uploaded = 0;
+		for (DecodeResult* result : Deferred)
+		{
+			uint32 size = 0;
+			for (const std::vector<byte>& level : result->Levels)
+				size += static_cast<uint32>(level.size());
+
+			// Keeps the upload per frame within the staging region, one level always goes through.
+			if (result->bSucceeded && size > staging.GetFreeSize() && staging.GetUsedSize() > 0)
+			{
+				Deferred[uploaded++] = result;
+				continue;
+			}
+
+			auto it = Pending.find(result->Id);
+
+			if (result->bSucceeded)
+			{
+				for (uint32 mip = 0; mip < result->LevelCount; ++mip)
+					staging.Upload(it->second.Texture, mip, result->Levels[mip].data(), static_cast<uint32>(result->Levels[mip].size()));
+
+				if (it->second.bGenerateMipMaps)
+					it->second.Texture->GenerateMipMaps();
+			}
+
+			Pending.erase(it);
+			delete result;
+		}
+
+		Deferred.resize(uploaded);
+	}
+
+	void TextureLoader::Decode(const std::string& file, const bool hdr, ThreadPool& pool, DecodeResult& result)
+	{
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		const bool compressed = IsCompressedTextureFormat(result.InternalFormat);
+		const uint32 channelCount = compressed ? TextureEncoder::GetSourceChannelCount(result.InternalFormat) : STBI_rgb;
+
+		// The flag of the thread, the global one races with decodes on the pool.
+		stbi_set_flip_vertically_on_load_thread(true);
+
+		void* pixels = hdr
+			? static_cast<void*>(stbi_loadf(file.c_str(), &width, &height, &channels, channelCount))
+			: static_cast<void*>(stbi_load(file.c_str(), &width, &height, &channels, channelCount));
+
+		if (!pixels)
+		{
+			std::cout << "Warning: Failed to load texture " << file << "." << std::endl;
+			return;
+		}
+
+		if (static_cast<uint32>(width) != result.Width || static_cast<uint32>(height) != result.Height)
+		{
+			std::cout << "Warning: Size of texture " << file << " changed while loading." << std::endl;
+			stbi_image_free(pixels);
+			return;
+		}
+
+		if (compressed)
+		{
+			// Runs on the pool itself, idle threads of it help with the rows of large levels.
+			if (hdr)
+				TextureEncoder::EncodeMipChain(static_cast<const float*>(pixels), width, height, channelCount, result.InternalFormat, 0, result.LevelCount, result.Levels, &pool);
+			else
+				TextureEncoder::EncodeMipChain(static_cast<const byte*>(pixels), width, height, channelCount, result.InternalFormat, 0, result.LevelCount, result.Levels, &pool);
+		}
+		else
+		{
+			const uint32 size = width * height * channelCount * (hdr ? sizeof(float) : 1);
+
+			result.Levels.resize(1);
+			result.Levels[0].assign(static_cast<const byte*>(pixels), static_cast<const byte*>(pixels) + size);
+		}
+
+		stbi_image_free(pixels);
+
+		result.bSucceeded = true;
+	}
+
+}
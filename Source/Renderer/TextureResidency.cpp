@@ -0,0 +1,159 @@
+#include "pch.h"
+
+#include <algorithm>
+
+#include "PBR/Renderer/TextureResidency.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureResidency ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	TextureResidency::TextureResidency()
+		: Budget(DefaultBudget)
+		, FrameNumber(0)
+		, Entries()
+		, VisitedMaterials()
+		, Candidates()
+		, Stats()
+	{
+
+	}
+
+	TextureResidency::~TextureResidency()
+	{
+
+	}
+
+	void TextureResidency::Update(const RenderView& view)
+	{
+		PROFILE_SCOPE("TextureResidency::Update");
+
+		++FrameNumber;
+
+		Stats.UsedTextures = 0;
+		Stats.Evictions = 0;
+		Stats.Restores = 0;
+
+		VisitedMaterials.clear();
+
+		for (const RenderPrimitive& primitive : view.GetRenderPrimitives())
+			MarkMaterialUsed(primitive.GetMaterial());
+
+		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
+			MarkMaterialUsed(primitive.GetMaterial());
+
+		UpdateEntries();
+
+		if (Stats.ResidentBytes > Budget)
+			EvictUnused();
+
+		Stats.TrackedTextures = static_cast<uint32>(Entries.size());
+	}
+
+	void TextureResidency::MarkUsed(Texture* texture)
+	{
+		auto it = Entries.find(texture);
+		if (it == Entries.end())
+		{
+			it = Entries.emplace(texture, Entry{ texture, 0, texture->GetMemorySize() }).first;
+
+			if (texture->IsResident())
+			{
+				Stats.ResidentBytes += it->second.Size;
+				++Stats.ResidentTextures;
+			}
+		}
+
+		Entry& entry = it->second;
+		if (entry.LastUsedFrame == FrameNumber)
+			return;
+
+		entry.LastUsedFrame = FrameNumber;
+		++Stats.UsedTextures;
+
+		if (!texture->IsResident())
+		{
+			texture->SetResident(true);
+
+			Stats.ResidentBytes += entry.Size;
+			++Stats.ResidentTextures;
+			++Stats.Restores;
+		}
+	}
+
+	void TextureResidency::MarkMaterialUsed(const MaterialRef& material)
+	{
+		if (material.GetReference() == nullptr)
+			return;
+
+		if (!VisitedMaterials.insert(material.GetReference()).second)
+			return;
+
+		// Shaders only sample the maps that are enabled, but the handles of all of them are uploaded.
+		for (const Texture2DRef* map : { &material->GetAlbedoMap(), &material->GetMetalnessMap(), &material->GetRoughnessMap(),
+			&material->GetAmbientOcclusionMap(), &material->GetNormalMap(), &material->GetDisplacementMap() })
+		{
+			if (map->GetReference() != nullptr)
+				MarkUsed(map->GetReference());
+		}
+	}
+
+	void TextureResidency::UpdateEntries()
+	{
+		for (auto it = Entries.begin(); it != Entries.end();)
+		{
+			Entry& entry = it->second;
+			if (entry.Texture.GetRefCount() > 1)
+			{
+				const uint64 size = entry.Texture->GetMemorySize();
+				if (entry.Texture->IsResident())
+					Stats.ResidentBytes = Stats.ResidentBytes - entry.Size + size;
+
+				entry.Size = size;
+
+				++it;
+				continue;
+			}
+
+			if (entry.Texture->IsResident())
+			{
+				Stats.ResidentBytes -= entry.Size;
+				--Stats.ResidentTextures;
+			}
+
+			it = Entries.erase(it);
+		}
+	}
+
+	void TextureResidency::EvictUnused()
+	{
+		Candidates.clear();
+
+		for (auto& it : Entries)
+		{
+			Entry& entry = it.second;
+			if (entry.Texture->IsResident() && entry.LastUsedFrame + MinIdleFrames <= FrameNumber)
+				Candidates.push_back(&entry);
+		}
+
+		std::sort(Candidates.begin(), Candidates.end(), [](const Entry* a, const Entry* b) { return a->LastUsedFrame < b->LastUsedFrame; });
+
+		for (Entry* entry : Candidates)
+		{
+			if (Stats.ResidentBytes <= Budget)
+				break;
+
+			entry->Texture->SetResident(false);
+
+			Stats.ResidentBytes -= entry->Size;
+			--Stats.ResidentTextures;
+			++Stats.Evictions;
+		}
+	}
+
+}
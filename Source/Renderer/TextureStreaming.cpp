@@ -0,0 +1,569 @@
+#include "pch.h"
+
+#include <cfloat>
+#include <thread>
+#include <algorithm>
+
+#include <stb_image.h>
+
+#include "PBR/Renderer/TextureStreaming.h"
+#include "PBR/Renderer/TextureResidency.h"
+#include "PBR/RHI/TextureEncoder.h"
+#include "PBR/Core/Profiler.h"
+
+
+namespace EngineCore
+{
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStreamingUtils ///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Streamed textures are decoded like TextureLibrary::Load2D(), compressed ones are encoded on the CPU.
+	static uint32 GetStreamedChannelCount(const TextureFormat internalFormat)
+	{
+		return IsCompressedTextureFormat(internalFormat) ? TextureEncoder::GetSourceChannelCount(internalFormat) : STBI_rgb;
+	}
+
+	static bool CanStream(const TextureFormat internalFormat)
+	{
+		return TextureEncoder::CanEncode(internalFormat) && TextureEncoder::GetSourceDataType(internalFormat) == TextureDataType::UnsignedByte;
+	}
+
+	static uint32 GetTailMip(const uint32 width, const uint32 height)
+	{
+		uint32 mip = 0;
+		while (std::max(GetMipLevelSize(width, mip), GetMipLevelSize(height, mip)) > TextureStreaming::MipTailSize)
+			++mip;
+
+		return mip;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// TextureStreaming ////////////////////////////////////////////////////////////////////////////////
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	TextureStreaming* TextureStreaming::Instance = nullptr;
+
+	TextureStreaming::TextureStreaming(ThreadPool& pool, const TextureResidency& residency)
+		: Pool(pool)
+		, Residency(residency)
+		, Budget(DefaultBudget)
+		, FrameNumber(0)
+		, MipBias(0)
+		, Mutex()
+		, Textures()
+		, FreeTextures()
+		, TextureIndices()
+		, MaterialDemand()
+		, Materials()
+		, ResultMutex()
+		, Results()
+		, PendingLoads(0)
+		, Stats()
+	{
+		assert(!Instance); // "TextureStreaming already exists!"
+		Instance = this;
+	}
+
+	TextureStreaming::~TextureStreaming()
+	{
+		// Decodes still running write into their results.
+		while (PendingLoads > 0)
+		{
+			{
+				std::lock_guard<std::mutex> lock(ResultMutex);
+
+				for (LoadResult* result : Results)
+					delete result;
+
+				PendingLoads -= static_cast<uint32>(Results.size());
+				Results.clear();
+			}
+
+			std::this_thread::yield();
+		}
+
+		Instance = nullptr;
+	}
+
+	Texture2DRef TextureStreaming::Load(const std::string& file, const TextureCreateInfo& createInfo)
+	{
+		assert(createInfo.UseMipMaps); // "Streamed textures need mip maps."
+		assert(createInfo.DataType == TextureDataType::UnsignedByte); // "Streamed textures have to use 8 bit data."
+
+		if (IsCompressedTextureFormat(createInfo.InternalFormat) && !CanStream(createInfo.InternalFormat))
+		{
+			std::cout << "Warning: Streamed texture " << file << " uses a format without encoder for 8 bit images." << std::endl;
+			return nullptr;
+		}
+
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		const uint32 channelCount = GetStreamedChannelCount(createInfo.InternalFormat);
+
+		// The flag of the thread, the global one races with decodes on the pool.
+		stbi_set_flip_vertically_on_load_thread(true);
+		stbi_uc* pixels = stbi_load(file.c_str(), &width, &height, &channels, channelCount);
+
+		if (!pixels)
+		{
+			std::cout << "Warning: Failed to load texture " << file << "." << std::endl;
+			return nullptr;
+		}
+
+		const uint32 mipCount = GetMipLevelCount(width, height);
+		const uint32 tailMip = GetTailMip(width, height);
+
+		TextureCreateInfo streamedInfo = createInfo;
+		streamedInfo.FirstResidentMip = tailMip;
+
+		Texture2DRef texture = Texture2D::Create(width, height, streamedInfo);
+
+		// The whole chain is filtered from level 0, only the tail is uploaded.
+		std::vector<std::vector<byte>> levels;
+		TextureEncoder::EncodeMipChain(pixels, width, height, channelCount, createInfo.InternalFormat, tailMip, mipCount, levels, &Pool);
+
+		stbi_image_free(pixels);
+
+		for (uint32 mip = tailMip; mip < mipCount; ++mip)
+			texture->SetMipData(mip, levels[mip - tailMip].data());
+
+		Register(file, texture, createInfo.InternalFormat, tailMip);
+		return texture;
+	}
+
+	Texture2DRef TextureStreaming::LoadAsync(const std::string& file, const TextureCreateInfo& createInfo, const glm::vec4& placeholder)
+	{
+		assert(createInfo.UseMipMaps); // "Streamed textures need mip maps."
+		assert(createInfo.DataType == TextureDataType::UnsignedByte); // "Streamed textures have to use 8 bit data."
+
+		if (IsCompressedTextureFormat(createInfo.InternalFormat) && !CanStream(createInfo.InternalFormat))
+		{
+			std::cout << "Warning: Streamed texture " << file << " uses a format without encoder for 8 bit images." << std::endl;
+			return nullptr;
+		}
+
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		if (!stbi_info(file.c_str(), &width, &height, &channels))
+		{
+			std::cout << "Warning: Failed to load texture " << file << "." << std::endl;
+			return nullptr;
+		}
+
+		const uint32 lastMip = GetMipLevelCount(width, height) - 1;
+		const uint32 tailMip = GetTailMip(width, height);
+
+		// Nothing to stream in.
+		if (tailMip == lastMip)
+			return Load(file, createInfo);
+
+		// Only the last level is resident, the tail is finer than that and gets requested right away.
+		TextureCreateInfo streamedInfo = createInfo;
+		streamedInfo.FirstResidentMip = lastMip;
+
+		Texture2DRef texture = Texture2D::Create(width, height, streamedInfo);
+		texture->Fill(placeholder);
+
+		Register(file, texture, createInfo.InternalFormat, tailMip);
+		return texture;
+	}
+
+	void TextureStreaming::Register(const std::string& file, const Texture2DRef& texture, const TextureFormat internalFormat, const uint32 tailMip)
+	{
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		uint32 index = static_cast<uint32>(Textures.size());
+		if (!FreeTextures.empty())
+		{
+			index = FreeTextures.back();
+			FreeTextures.pop_back();
+		}
+		else
+		{
+			Textures.emplace_back();
+		}
+
+		StreamedTexture& entry = Textures[index];
+		entry.File = file;
+		entry.Texture = texture;
+		entry.InternalFormat = internalFormat;
+		entry.TailMip = tailMip;
+		entry.WantedMip = tailMip;
+		entry.LastUsedFrame = FrameNumber;
+		entry.Generation = 0;
+		entry.bIsLoading = false;
+
+		TextureIndices[texture.GetReference()] = index;
+	}
+
+	void TextureStreaming::Update(const RenderView& view, const uint32 viewHeight, TextureStagingBuffer& staging)
+	{
+		PROFILE_SCOPE("TextureStreaming::Update");
+
+		std::lock_guard<std::mutex> lock(Mutex);
+
+		++FrameNumber;
+
+		Stats.LoadedMips = 0;
+		Stats.DroppedMips = 0;
+
+		ReleaseUnreferenced();
+		ComputeDemand(view, viewHeight);
+
+		ApplyLoads(staging);
+		DropMips();
+		RequestLoads();
+
+		// After all handle changes of this frame, before the scene uploads its materials.
+		InvalidateMaterials();
+
+		Stats.StreamedTextures = static_cast<uint32>(TextureIndices.size());
+		Stats.PendingLoads = PendingLoads;
+		Stats.MipBias = MipBias;
+	}
+
+	void TextureStreaming::ComputeDemand(const RenderView& view, const uint32 viewHeight)
+	{
+		MaterialDemand.clear();
+
+		for (StreamedTexture& entry : Textures)
+			entry.WantedMip = entry.TailMip;
+
+		const CameraRef& camera = view.GetCamera();
+		if (camera.GetReference() == nullptr)
+			return;
+
+		// Projected diameter in pixels of a sphere with radius 1 at distance 1.
+		const float pixelsPerUnit = camera->GetProjectionMatrix()[1][1] * static_cast<float>(viewHeight);
+		const glm::vec3& cameraPosition = camera->GetPosition();
+
+		Material* lastMaterial = nullptr;
+		float* lastDemand = nullptr;
+
+		for (const RenderPrimitive& primitive : view.GetRenderPrimitives())
+		{
+			Material* material = primitive.GetMaterial().GetReference();
+			if (!material)
+				continue;
+
+			if (material != lastMaterial)
+			{
+				lastMaterial = material;
+				lastDemand = &MaterialDemand.emplace(material, 0.0f).first->second;
+			}
+
+			const Transform& transform = primitive.GetTransform();
+			const glm::vec3& scale = transform.GetScale();
+
+			const float radius = primitive.GetMesh()->GetBoundingRadius() * std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+			const float distance = glm::length(transform.GetPosition() - cameraPosition);
+
+			// Meshes without bounds and meshes around the camera need full detail.
+			const float pixels = radius > 0.0f && distance > radius ? radius * pixelsPerUnit / distance : FLT_MAX;
+			*lastDemand = std::max(*lastDemand, pixels);
+		}
+
+		// Instances are spread out, their textures are streamed in at full detail.
+		for (const InstancedPrimitive& primitive : view.GetInstancedPrimitves())
+		{
+			if (primitive.GetMaterial().GetReference() != nullptr)
+				MaterialDemand[primitive.GetMaterial().GetReference()] = FLT_MAX;
+		}
+
+		for (const auto& demand : MaterialDemand)
+		{
+			const Material* material = demand.first;
+
+			for (const Texture2DRef* map : { &material->GetAlbedoMap(), &material->GetMetalnessMap(), &material->GetRoughnessMap(),
+				&material->GetAmbientOcclusionMap(), &material->GetNormalMap(), &material->GetDisplacementMap() })
+			{
+				SetWantedMip(*map, demand.second);
+			}
+		}
+	}
+
+	void TextureStreaming::SetWantedMip(const Texture2DRef& map, const float pixels)
+	{
+		if (map.GetReference() == nullptr)
+			return;
+
+		auto it = TextureIndices.find(map.GetReference());
+		if (it == TextureIndices.end())
+			return;
+
+		StreamedTexture& entry = Textures[it->second];
+		entry.LastUsedFrame = FrameNumber;
+
+		const float size = static_cast<float>(std::max(map->GetWidth(), map->GetHeight()));
+
+		uint32 mip = pixels < size ? static_cast<uint32>(std::log2(size / pixels)) : 0;
+		mip = std::min(mip + MipBias, entry.TailMip);
+
+		entry.WantedMip = std::min(entry.WantedMip, mip);
+	}
+
+	void TextureStreaming::ApplyLoads(TextureStagingBuffer& staging)
+	{
+		std::vector<LoadResult*> results;
+		{
+			std::lock_guard<std::mutex> lock(ResultMutex);
+			results.swap(Results);
+		}
+
+		std::vector<LoadResult*> deferred;
+
+		for (LoadResult* result : results)
+		{
+			StreamedTexture& entry = Textures[result->Texture];
+
+			const uint32 residentMip = entry.Texture->GetFirstResidentMip();
+			const uint32 firstMip = std::max(result->FirstMip, entry.WantedMip);
+
+			// Levels dropped while decoding would leave a gap, the next request loads them again.
+			const bool apply = result->bSucceeded && firstMip < residentMip && residentMip <= result->EndMip;
+
+			if (apply)
+			{
+				uint32 size = 0;
+				for (uint32 mip = firstMip; mip < residentMip; ++mip)
+					size += static_cast<uint32>(result->Levels[mip - result->FirstMip].size());
+
+				// All new levels are uploaded in the same frame, within the staging region unless
+				// nothing else was staged yet.
+				if (size > staging.GetFreeSize() && staging.GetUsedSize() > 0)
+				{
+					deferred.push_back(result);
+					continue;
+				}
+
+				entry.Texture->SetFirstResidentMip(firstMip);
+
+				for (uint32 mip = firstMip; mip < residentMip; ++mip)
+				{
+					const std::vector<byte>& level = result->Levels[mip - result->FirstMip];
+					staging.Upload(entry.Texture, mip, level.data(), static_cast<uint32>(level.size()));
+				}
+
+				++entry.Generation;
+				Stats.LoadedMips += residentMip - firstMip;
+			}
+
+			--PendingLoads;
+			entry.bIsLoading = false;
+
+			delete result;
+		}
+
+		if (!deferred.empty())
+		{
+			std::lock_guard<std::mutex> lock(ResultMutex);
+			Results.insert(Results.begin(), deferred.begin(), deferred.end());
+		}
+	}
+
+	void TextureStreaming::RequestLoads()
+	{
+		// Largest missing detail first.
+		std::vector<uint32> requests;
+		for (uint32 i = 0; i < Textures.size(); ++i)
+		{
+			const StreamedTexture& entry = Textures[i];
+			if (entry.Texture.GetReference() != nullptr && !entry.bIsLoading && entry.WantedMip < entry.Texture->GetFirstResidentMip())
+				requests.push_back(i);
+		}
+
+		std::sort(requests.begin(), requests.end(), [this](const uint32 a, const uint32 b)
+		{
+			return Textures[a].Texture->GetFirstResidentMip() - Textures[a].WantedMip > Textures[b].Texture->GetFirstResidentMip() - Textures[b].WantedMip;
+		});
+
+		for (const uint32 index : requests)
+		{
+			if (PendingLoads == MaxPendingLoads)
+				break;
+
+			StreamedTexture& entry = Textures[index];
+			entry.bIsLoading = true;
+
+			LoadResult* result = new LoadResult();
+			result->Texture = index;
+			result->Width = entry.Texture->GetWidth();
+			result->Height = entry.Texture->GetHeight();
+			result->InternalFormat = entry.InternalFormat;
+			result->FirstMip = entry.WantedMip;
+			result->EndMip = entry.Texture->GetFirstResidentMip();
+			result->bSucceeded = false;
+
+			++PendingLoads;
+
+			const std::string file = entry.File;
+			Pool.Enqueue([this, file, result]()
+			{
+				DecodeMips(file, Pool, *result);
+
+				std::lock_guard<std::mutex> lock(ResultMutex);
+				Results.push_back(result);
+			});
+		}
+	}
+
+	void TextureStreaming::DropMips()
+	{
+		uint64 streamedBytes = 0;
+		for (const StreamedTexture& entry : Textures)
+		{
+			if (entry.Texture.GetReference() != nullptr)
+				streamedBytes += entry.Texture->GetMemorySize();
+		}
+
+		if (streamedBytes > Budget)
+		{
+			// Textures showing more detail than needed, least recently used first.
+			std::vector<StreamedTexture*> candidates;
+			for (StreamedTexture& entry : Textures)
+			{
+				if (entry.Texture.GetReference() != nullptr && entry.Texture->GetFirstResidentMip() < entry.WantedMip)
+					candidates.push_back(&entry);
+			}
+
+			std::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* a, const StreamedTexture* b) { return a->LastUsedFrame < b->LastUsedFrame; });
+
+			for (StreamedTexture* entry : candidates)
+			{
+				if (streamedBytes <= Budget)
+					break;
+
+				const uint32 residentMip = entry->Texture->GetFirstResidentMip();
+				streamedBytes -= entry->Texture->GetMemorySize();
+
+				entry->Texture->SetFirstResidentMip(entry->WantedMip);
+				streamedBytes += entry->Texture->GetMemorySize();
+
+				++entry->Generation;
+				Stats.DroppedMips += entry->WantedMip - residentMip;
+			}
+
+			// The visible textures alone do not fit, lower the detail of all of them.
+			if (streamedBytes > Budget && MipBias < MaxMipBias)
+				++MipBias;
+		}
+		else if (MipBias > 0 && streamedBytes * 4 < Budget)
+		{
+			// One level less bias can quadruple the memory of the visible textures.
+			--MipBias;
+		}
+
+		Stats.StreamedBytes = streamedBytes;
+	}
+
+	void TextureStreaming::InvalidateMaterials()
+	{
+		for (const auto& demand : MaterialDemand)
+		{
+			Material* material = demand.first;
+
+			uint32 generation = 0;
+			for (const Texture2DRef* map : { &material->GetAlbedoMap(), &material->GetMetalnessMap(), &material->GetRoughnessMap(),
+				&material->GetAmbientOcclusionMap(), &material->GetNormalMap(), &material->GetDisplacementMap() })
+			{
+				if (map->GetReference() == nullptr)
+					continue;
+
+				auto it = TextureIndices.find(map->GetReference());
+				if (it != TextureIndices.end())
+					generation += Textures[it->second].Generation;
+			}
+
+			auto it = Materials.find(material);
+			if (it == Materials.end())
+			{
+				// Not seen before, its cached parameters may predate handle changes.
+				if (generation != 0)
+					material->Invalidate();
+
+				Materials.emplace(material, MaterialState{ generation, FrameNumber });
+				continue;
+			}
+
+			if (it->second.Generation != generation)
+				material->Invalidate();
+
+			it->second.Generation = generation;
+			it->second.LastSeenFrame = FrameNumber;
+		}
+
+		// Materials out of view for a while are treated like new ones when they come back.
+		if (FrameNumber % 256 == 0)
+		{
+			for (auto it = Materials.begin(); it != Materials.end();)
+			{
+				if (it->second.LastSeenFrame != FrameNumber)
+					it = Materials.erase(it);
+				else
+					++it;
+			}
+		}
+	}
+
+	void TextureStreaming::ReleaseUnreferenced()
+	{
+		for (uint32 i = 0; i < Textures.size(); ++i)
+		{
+			StreamedTexture& entry = Textures[i];
+			if (entry.Texture.GetReference() == nullptr || entry.bIsLoading)
+				continue;
+
+			// The residency manager releases its reference after the streaming.
+			const uint32 ownerCount = Residency.IsTracked(entry.Texture.GetReference()) ? 2 : 1;
+			if (entry.Texture.GetRefCount() > ownerCount)
+				continue;
+
+			TextureIndices.erase(entry.Texture.GetReference());
+
+			entry.File.clear();
+			entry.Texture = nullptr;
+
+			FreeTextures.push_back(i);
+		}
+	}
+
+	void TextureStreaming::DecodeMips(const std::string& file, ThreadPool& pool, LoadResult& result)
+	{
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		const uint32 channelCount = GetStreamedChannelCount(result.InternalFormat);
+
+		// The flag of the thread, the global one races with decodes on the pool.
+		stbi_set_flip_vertically_on_load_thread(true);
+		stbi_uc* pixels = stbi_load(file.c_str(), &width, &height, &channels, channelCount);
+
+		if (!pixels)
+		{
+			std::cout << "Warning: Failed to stream texture " << file << "." << std::endl;
+			return;
+		}
+
+		if (static_cast<uint32>(width) != result.Width || static_cast<uint32>(height) != result.Height)
+		{
+			std::cout << "Warning: Size of streamed texture " << file << " changed." << std::endl;
+			stbi_image_free(pixels);
+			return;
+		}
+
+		// Runs on the pool itself, idle threads of it help with the rows of large levels.
+		TextureEncoder::EncodeMipChain(pixels, width, height, channelCount, result.InternalFormat, result.FirstMip, result.EndMip, result.Levels, &pool);
+
+		stbi_image_free(pixels);
+
+		result.bSucceeded = true;
+	}
+
+}
@@ -33,7 +33,7 @@ namespace EngineCore
 
 	void ToneMapperPass::Execute(const Texture2DRef sourceTexture)
 	{
-		Shader->Bind();
+		RendererInstance->GetCommandList().SetPipelineState(GetPipelineState());
 		UniformBuffer->BindBlock(0);
 		Shader->BindBlock("ToneMapperData", 0);
 
@@ -47,7 +47,6 @@ namespace EngineCore
 		RendererInstance->DrawQuad();
 
 		FrameBuffer->Unbind();
-		Shader->Unbind();
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -55,7 +54,8 @@ namespace EngineCore
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	ToneMapperStage::ToneMapperStage(Renderer* renderer)
-		: ToneMapperPass(new ::EngineCore::ToneMapperPass(renderer))
+		: RenderStage(renderer)
+		, ToneMapperPass(new ::EngineCore::ToneMapperPass(renderer))
 	{
 
 	}
@@ -70,28 +70,35 @@ namespace EngineCore
 		ShaderLibrary* shaders = ShaderLibrary::GetInstance();
 		ToneMapperShader = shaders->Get("ToneMapper");
 
-		ToneMapperFrameBuffer = FrameBuffer::Create(1280, 720);
-
-		TextureCreateInfo createInfo;
-		createInfo.DataType = TextureDataType::Float;
-		createInfo.Format = TextureFormat::Rgba;
-		createInfo.InternalFormat = TextureFormat::Rgba16f;
-		createInfo.Filter = TextureFilter::Linear;
-		createInfo.Wrap = TextureWrap::Clamp;
-		createInfo.UseMipMaps = false;
-
-		Texture = Texture2D::Create(1280, 720, createInfo);
+		TargetDesc.Width = 1280;
+		TargetDesc.Height = 720;
+		TargetDesc.CreateInfo.DataType = TextureDataType::Float;
+		TargetDesc.CreateInfo.Format = TextureFormat::Rgba;
+		TargetDesc.CreateInfo.InternalFormat = TextureFormat::Rgba16f;
+		TargetDesc.CreateInfo.Filter = TextureFilter::Linear;
+		TargetDesc.CreateInfo.Wrap = TextureWrap::Clamp;
+		TargetDesc.CreateInfo.UseMipMaps = false;
 
 		ToneMapperPass->Init();
 		ToneMapperPass->SetShader(ToneMapperShader);
-		ToneMapperPass->SetFrameBuffer(ToneMapperFrameBuffer);
-		ToneMapperPass->SetRenderTarget(Texture);
 	}
 
-	void ToneMapperStage::Execute(const Texture2DRef& sourceTexture)
+	void ToneMapperStage::Execute(const Texture2DRef& sourceTexture, const Texture2DRef& target)
 	{
+		RenderTargetPool& pool = RendererInstance->GetRenderTargetPool();
+		const FrameBufferRef frameBuffer = pool.AcquireFrameBuffer(TargetDesc.Width, TargetDesc.Height);
+
+		ToneMapperPass->SetFrameBuffer(frameBuffer);
+		ToneMapperPass->SetRenderTarget(target);
 		ToneMapperPass->Execute(sourceTexture);
+
+		pool.ReleaseFrameBuffer(frameBuffer);
 	}
 
+	void ToneMapperStage::Resize(const uint32 width, const uint32 height)
+	{
+		TargetDesc.Width = width;
+		TargetDesc.Height = height;
+	}
 
 }
\ No newline at end of file
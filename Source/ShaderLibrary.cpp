@@ -10,6 +10,8 @@ namespace EngineCore
 	ShaderLibrary* ShaderLibrary::Instance = nullptr;
 
 	ShaderLibrary::ShaderLibrary()
+		: ShaderMap()
+		, Cache(nullptr)
 	{
 		if (Instance)
 		{
@@ -21,7 +23,7 @@ namespace EngineCore
 
 	ShaderLibrary::~ShaderLibrary()
 	{
-
+		delete Cache;
 	}
 
 	void ShaderLibrary::Add(const ShaderRef& shader)
@@ -52,7 +54,7 @@ namespace EngineCore
 
 	void ShaderLibrary::Load(const std::string& name, const ShaderSource& source)
 	{
-		ShaderRef shader = Shader::Create(name, source);
+		ShaderRef shader = Shader::Create(name, source, Cache);
 		Add(shader);
 	}
 
@@ -84,10 +86,17 @@ namespace EngineCore
 		ShaderSource resultSource;
 		resultSource.VertexSource = shaderSources[ShaderType::Vertex];
 		resultSource.FragmentSource = shaderSources[ShaderType::Fragment];
+		resultSource.ComputeSource = shaderSources[ShaderType::Compute];
 
 		Load(GetFileName(file), resultSource);
 	}
 
+	void ShaderLibrary::SetCacheDirectory(const std::string& directory)
+	{
+		delete Cache;
+		Cache = directory.empty() ? nullptr : new ShaderCache(directory);
+	}
+
 	std::string ShaderLibrary::ReadFile(const std::string& file) const
 	{
 		std::string result;
@@ -131,6 +140,8 @@ namespace EngineCore
 			return ShaderType::Geometry;
 		else if (value == "fragment" || value == "pixel")
 			return ShaderType::Fragment;
+		else if (value == "compute")
+			return ShaderType::Compute;
 
 		return ShaderType::None;
 	}
@@ -2,6 +2,10 @@
 
 #include <stb_image.h>
 #include "PBR/TextureLibrary.h"
+#include "PBR/Renderer/TextureStreaming.h"
+#include "PBR/Renderer/TextureLoader.h"
+#include "PBR/RHI/TextureEncoder.h"
+#include "PBR/RHI/TextureContainer.h"
 
 
 namespace EngineCore
@@ -10,6 +14,8 @@ namespace EngineCore
 	TextureLibrary* TextureLibrary::Instance = nullptr;
 
 	TextureLibrary::TextureLibrary()
+		: TextureMap()
+		, Pool(nullptr)
 	{
 
 	}
@@ -58,6 +64,24 @@ namespace EngineCore
 
 	Texture2DRef TextureLibrary::Load2D(const std::string& file, const TextureCreateInfo createInfo)
 	{
+		if (TextureContainer::IsContainerFile(file))
+			return Load2DContainer(file, createInfo);
+
+		// Streamed like async loads, decoding and filtering the whole chain here would only be used
+		// for the tail. Finer levels follow when the texture becomes visible.
+		TextureStreaming* streaming = TextureStreaming::GetInstance();
+		if (streaming && createInfo.UseMipMaps && createInfo.DataType == TextureDataType::UnsignedByte)
+		{
+			Texture2DRef texture = streaming->LoadAsync(file, createInfo, glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
+			if (texture)
+				Add(GetFileName(file), RefCast<Texture>(texture));
+
+			return texture;
+		}
+
+		if (IsCompressedTextureFormat(createInfo.InternalFormat))
+			return Load2DCompressed(file, createInfo, false);
+
 		int32 width;
 		int32 height;
 		int32 channels;
@@ -77,6 +101,12 @@ namespace EngineCore
 
 	Texture2DRef TextureLibrary::Load2DHdr(const std::string& file, const TextureCreateInfo createInfo)
 	{
+		if (TextureContainer::IsContainerFile(file))
+			return Load2DContainer(file, createInfo);
+
+		if (IsCompressedTextureFormat(createInfo.InternalFormat))
+			return Load2DCompressed(file, createInfo, true);
+
 		int32 width;
 		int32 height;
 		int32 channels;
@@ -91,6 +121,136 @@ namespace EngineCore
 		return texture;
 	}
 
+	Texture2DRef TextureLibrary::Load2DAsync(const std::string& file, const TextureCreateInfo createInfo, const glm::vec4& placeholder)
+	{
+		if (TextureContainer::IsContainerFile(file))
+			return Load2DContainer(file, createInfo);
+
+		Texture2DRef texture;
+
+		TextureStreaming* streaming = TextureStreaming::GetInstance();
+		if (streaming && createInfo.UseMipMaps && createInfo.DataType == TextureDataType::UnsignedByte)
+			texture = streaming->LoadAsync(file, createInfo, placeholder);
+		else if (TextureLoader::GetInstance())
+			texture = TextureLoader::GetInstance()->Load(file, createInfo, placeholder, false);
+		else
+			return Load2D(file, createInfo);
+
+		if (texture)
+			Add(GetFileName(file), RefCast<Texture>(texture));
+
+		return texture;
+	}
+
+	Texture2DRef TextureLibrary::Load2DHdrAsync(const std::string& file, const TextureCreateInfo createInfo, const glm::vec4& placeholder)
+	{
+		if (TextureContainer::IsContainerFile(file))
+			return Load2DContainer(file, createInfo);
+
+		if (!TextureLoader::GetInstance())
+			return Load2DHdr(file, createInfo);
+
+		Texture2DRef texture = TextureLoader::GetInstance()->Load(file, createInfo, placeholder, true);
+		if (texture)
+			Add(GetFileName(file), RefCast<Texture>(texture));
+
+		return texture;
+	}
+
+	Texture2DRef TextureLibrary::Load2DCompressed(const std::string& file, const TextureCreateInfo& createInfo, const bool hdr)
+	{
+		// Bc6h is encoded from HDR images, all other formats from 8 bit ones.
+		if (!TextureEncoder::CanEncode(createInfo.InternalFormat) || (TextureEncoder::GetSourceDataType(createInfo.InternalFormat) == TextureDataType::Float) != hdr)
+		{
+			std::cout << "Warning: Texture " << file << " uses a format without encoder for " << (hdr ? "HDR" : "8 bit") << " images." << std::endl;
+			return nullptr;
+		}
+
+		int32 width;
+		int32 height;
+		int32 channels;
+
+		const uint32 channelCount = TextureEncoder::GetSourceChannelCount(createInfo.InternalFormat);
+
+		stbi_set_flip_vertically_on_load(true);
+
+		void* pixels = hdr
+			? static_cast<void*>(stbi_loadf(file.c_str(), &width, &height, &channels, channelCount))
+			: static_cast<void*>(stbi_load(file.c_str(), &width, &height, &channels, channelCount));
+
+		if (!pixels)
+		{
+			std::cout << "Warning: Failed to load texture " << file << "." << std::endl;
+			return nullptr;
+		}
+
+		Texture2DRef texture = Texture2D::Create(width, height, createInfo);
+
+		ThreadPool* pool = Pool;
+		if (!pool && TextureLoader::GetInstance())
+			pool = &TextureLoader::GetInstance()->GetThreadPool();
+
+		std::vector<std::vector<byte>> levels;
+		if (hdr)
+			TextureEncoder::EncodeMipChain(static_cast<const float*>(pixels), width, height, channelCount, createInfo.InternalFormat, 0, texture->GetMipCount(), levels, pool);
+		else
+			TextureEncoder::EncodeMipChain(static_cast<const byte*>(pixels), width, height, channelCount, createInfo.InternalFormat, 0, texture->GetMipCount(), levels, pool);
+
+		stbi_image_free(pixels);
+
+		for (uint32 mip = 0; mip < texture->GetMipCount(); ++mip)
+			texture->SetMipData(mip, levels[mip].data());
+
+		Add(GetFileName(file), RefCast<Texture>(texture));
+		return texture;
+	}
+
+	Texture2DRef TextureLibrary::Load2DContainer(const std::string& file, const TextureCreateInfo& createInfo)
+	{
+		TextureContainer container;
+		if (!container.Open(file))
+			return nullptr;
+
+		const uint32 width = container.GetWidth();
+		const uint32 height = container.GetHeight();
+
+		// Filtering and wrapping are up to the caller, the layout of the data comes from the file.
+		TextureCreateInfo info = createInfo;
+		info.Format = container.GetFormat();
+		info.InternalFormat = container.GetInternalFormat();
+		info.DataType = container.GetDataType();
+		info.FirstResidentMip = 0;
+
+		// Missing levels of uncompressed textures are generated like for decoded images, compressed
+		// ones cannot be completed.
+		bool generateMipMaps = false;
+		if (info.UseMipMaps && container.GetLevelCount() < GetMipLevelCount(width, height))
+		{
+			if (IsCompressedTextureFormat(info.InternalFormat))
+			{
+				std::cout << "Warning: Texture " << file << " has an incomplete mip chain, it is loaded without mip maps." << std::endl;
+				info.UseMipMaps = false;
+			}
+			else
+			{
+				generateMipMaps = true;
+			}
+		}
+
+		Texture2DRef texture = Texture2D::Create(width, height, info);
+
+		// Uploaded straight from the mapping, the driver reads the pages in as it copies them.
+		const uint32 levelCount = generateMipMaps ? 1 : std::min(container.GetLevelCount(), texture->GetMipCount());
+		for (uint32 mip = 0; mip < levelCount; ++mip)
+			texture->SetMipData(mip, container.GetLevel(mip).Data);
+
+		if (generateMipMaps)
+			texture->GenerateMipMaps();
+
+		Add(GetFileName(file), RefCast<Texture>(texture));
+		return texture;
+	}
+
 	std::string TextureLibrary::GetFileName(const std::string& file) const
 	{
 		auto lastSlash = file.find_last_of("/\\");